@@ -0,0 +1,112 @@
+#include <cmath>
+#include <chrono>
+#include <thread>
+#include <string>
+#include <vector>
+#include <functional>
+
+#include "optimizor.h"
+
+#ifndef _MATH_OPTIMIZATION_FUNCTIONS_
+#define _MATH_OPTIMIZATION_FUNCTIONS_
+//	the single objective test functions of the local optimizers, shared by their tests and benchmarks
+namespace Functions
+{
+//	a test function of the decisions, the delay in microseconds stands for an expensive model
+	class Function : public math::Optimizor::Objective
+	{
+	private:
+		std::function<double(const double*)> function_;
+		std::chrono::microseconds delay_;
+
+	public:
+		virtual void operator() (const double* decisions, double* objectives, double* voilations)
+		{
+			delay_.count() ? std::this_thread::sleep_for(delay_) : void();
+			objectives[0] = function_(decisions);
+		}
+
+	public:
+		Function(std::function<double(const double*)> function, size_t delay = 0) : function_(std::move(function)), delay_(delay)
+		{
+		}
+	};
+
+	inline std::function<double(const double*)> sphere(size_t scale, double center = 0)
+	{
+		return [scale, center](const double* x)
+			{
+				double sum = 0;
+				for (size_t i = 0; i < scale; ++i) { sum += (x[i] - center) * (x[i] - center); }
+				return sum;
+			};
+	}
+
+	inline std::function<double(const double*)> ellipsoid(size_t scale)
+	{
+		return [scale](const double* x)
+			{
+				double sum = 0;
+				for (size_t i = 0; i < scale; ++i) { sum += std::pow(1e3, i / double(scale - 1)) * x[i] * x[i]; }
+				return sum;
+			};
+	}
+
+	inline std::function<double(const double*)> rosenbrock(size_t scale)
+	{
+		return [scale](const double* x)
+			{
+				double sum = 0;
+				for (size_t i = 0; i + 1 < scale; ++i) { sum += 100 * std::pow(x[i + 1] - x[i] * x[i], 2) + std::pow(1 - x[i], 2); }
+				return sum;
+			};
+	}
+
+	inline double beale(const double* x)
+	{
+		return std::pow(1.5 - x[0] + x[0] * x[1], 2) + std::pow(2.25 - x[0] + x[0] * x[1] * x[1], 2) + std::pow(2.625 - x[0] + x[0] * std::pow(x[1], 3), 2);
+	}
+
+//	the singular function of powell, of four decisions
+	inline double singular(const double* x)
+	{
+		return std::pow(x[0] + 10 * x[1], 2) + 5 * std::pow(x[2] - x[3], 2) + std::pow(x[1] - 2 * x[2], 4) + 10 * std::pow(x[0] - x[3], 4);
+	}
+
+//	four minima of value zero within [-5, 5], at (3, 2), (-2.805118, 3.131312), (-3.779310, -3.283186) and (3.584428, -1.848126)
+	inline double himmelblau(const double* x)
+	{
+		return std::pow(x[0] * x[0] + x[1] - 11, 2) + std::pow(x[0] + x[1] * x[1] - 7, 2);
+	}
+
+	inline std::function<double(const double*)> rastrigin(size_t scale)
+	{
+		return [scale](const double* x)
+			{
+				double sum = 10.0 * scale;
+				for (size_t i = 0; i < scale; ++i) { sum += x[i] * x[i] - 10 * std::cos(2 * 3.141592653589793 * x[i]); }
+				return sum;
+			};
+	}
+
+	struct Problem
+	{
+		std::string name;
+		size_t scale;
+		std::vector<double> initial;
+		std::function<double(const double*)> function;
+	};
+
+//	the problems of the benchmarks, all minimized at zero, the larger rosenbrock function of the scale given
+	inline std::vector<Problem> problems(size_t scale)
+	{
+		return {
+			{ "sphere", 10, std::vector<double>(10, 1.0), sphere(10) },
+			{ "ellipsoid", 10, std::vector<double>(10, 1.0), ellipsoid(10) },
+			{ "rosenbrock", 2, { -1.2, 1.0 }, rosenbrock(2) },
+			{ "rosenbrock", scale, std::vector<double>(scale, -1.0), rosenbrock(scale) },
+			{ "beale", 2, { 1.0, 1.0 }, beale },
+			{ "singular", 4, { 3.0, -1.0, 0.0, 1.0 }, singular } };
+	}
+}
+#endif //!_MATH_OPTIMIZATION_FUNCTIONS_
@@ -0,0 +1,57 @@
+#include <iostream>
+#include "cc.h"
+
+//	blocks of five variables of the rosenbrock function followed by separable squares
+class Objective : public math::Optimizor::Objective
+{
+private:
+	size_t decisions_ = 200, blocks_ = 10;
+
+public:
+	virtual void operator() (const double * decisions, double * objectives, double * voilation)
+	{
+		objectives[0] = 0;
+
+		for (size_t b = 0; b < blocks_; ++b)
+		{
+			for (size_t i = b * 5; i < b * 5 + 4; ++i)
+			{
+				objectives[0] += 100 * pow(decisions[i + 1] - decisions[i] * decisions[i], 2) + pow(1 - decisions[i], 2);
+			}
+		}
+
+		for (size_t i = blocks_ * 5; i < decisions_; ++i)
+		{
+			objectives[0] += pow(decisions[i] - 0.5, 2);
+		}
+	}
+};
+
+int main()
+{
+	std::unique_ptr<math::Optimizor::Configuration> config = std::make_unique<math::Optimizor::Configuration>();
+	config->objective = std::make_unique<Objective>();
+
+	(*config)["scale"] = size_t(200);
+	(*config)["dimension"] = size_t(1);
+	(*config)["constraint"] = size_t(0);
+
+	(*config)["upper"] = std::vector<double>(200, 2.0);
+	(*config)["lower"] = std::vector<double>(200, -2.0);
+	(*config)["integer"] = std::vector<double>(200, 0.0);
+
+	(*config)["population"] = size_t(20);
+	(*config)["iteration"] = size_t(10);
+	(*config)["maximum"] = size_t(100);
+	(*config)["seed"] = size_t(1);
+
+	auto cc = std::make_unique<CC>();
+	auto& results = static_cast<math::Optimizor&>(*cc).optimize(*config);
+	auto best = *results.results().begin();
+
+	std::cout << cc->groups() << " groups, " << cc->evaluations() << " evaluations, fitness " << best[200] << std::endl;
+
+//	the ten blocks and the two groups of separable variables, and a fitness from the thousands of a random point to the few units
+//	a block stuck in the local minimum of the rosenbrock function leaves, whatever the seed
+	return cc->groups() == 12 && best[200] < 40 ? 0 : 1;
+};
@@ -0,0 +1,166 @@
+#include "cc.h"
+
+#ifdef STATIC_OPTIMIZOR
+REGISTER_OPTIMIZOR(cc, []() -> void* { return static_cast<math::Optimizor*>(new CC()); })
+#else
+extern "C" EXPORT void* create()
+{
+    return static_cast<math::Optimizor*>(new CC());
+}
+#endif
+
+//  the species are made again for the groups, each one seeded from the context
+void CC::divide()
+{
+    auto&& groups = random_ ? grouping_->shuffle(group_, generator_) : grouping_->group(group_);
+
+    std::vector<double> context(context_.get(), context_.get() + scale_);
+
+    subcomponents_.clear();
+    subcomponents_.reserve(groups.size());
+
+    for (auto& group : groups)
+    {
+        subcomponents_.emplace_back(std::move(group), size_, context, upper_, lower_, integer_, generator_());
+    }
+}
+
+//  the groups do not interact, so the improvements of all the species add up once merged together,
+//  if the merged context is still worse, as the groups were drawn at random or the detection missed an interaction,
+//  only the best species is merged
+void CC::merge()
+{
+    std::vector<double> merged(context_.get(), context_.get() + scale_ + dimension_ + constraint_);
+    const Subcomponent* best = nullptr;
+
+    for (const auto& subcomponent : subcomponents_)
+    {
+        bool improved = subcomponent.penalty() < penalty_ || (subcomponent.penalty() == penalty_ && subcomponent.fitness() < fitness_);
+
+        if (!improved) { continue; }
+
+        const auto& variables = subcomponent.variables();
+        for (size_t j = 0; j < variables.size(); ++j) { merged[variables[j]] = subcomponent.best()[j]; }
+
+        bool better = !best || subcomponent.penalty() < best->penalty() || (subcomponent.penalty() == best->penalty() && subcomponent.fitness() < best->fitness());
+        best = better ? &subcomponent : best;
+    }
+
+    if (!best) { return; }
+
+    evaluator_->evaluate(merged.data(), merged.data() + scale_, merged.data() + scale_ + dimension_);
+    double fitness = evaluator_->fitness(merged.data() + scale_), penalty = evaluator_->penalty(merged.data() + scale_ + dimension_);
+
+    if (penalty < best->penalty() || (penalty == best->penalty() && fitness <= best->fitness()))
+    {
+        std::copy(merged.begin(), merged.end(), context_.get());
+        fitness_ = fitness;
+        penalty_ = penalty;
+        return;
+    }
+
+    const auto& variables = best->variables();
+    for (size_t j = 0; j < variables.size(); ++j) { context_[variables[j]] = best->best()[j]; }
+
+    evaluator_->evaluate(context_.get(), context_.get() + scale_, context_.get() + scale_ + dimension_);
+    fitness_ = evaluator_->fitness(context_.get() + scale_);
+    penalty_ = evaluator_->penalty(context_.get() + scale_ + dimension_);
+}
+
+void CC::coevole(size_t generation)
+{
+    for (size_t i = 0; i < generation; ++i)
+    {
+        random_ && i ? divide() : void();
+
+    //  the species read the same copy of the context, so they run without locks and the cycle does not depend on the threads
+        std::vector<double> context(context_.get(), context_.get() + scale_);
+
+        math::parallel(subcomponents_.size(), threads_, [&](size_t k)
+            {
+                subcomponents_[k].evolve(*evaluator_, context, upper_, lower_, integer_, iteration_);
+            });
+
+        merge();
+    }
+}
+
+void CC::write(const char * filepath, char mode)
+{
+    auto decisions = context_.get(), objectives = decisions + scale_, voilations = objectives + dimension_;
+    bool status = ::Evolutionary::Writer(scale_, dimension_, constraint_).write(filepath, mode, { { decisions, objectives, voilations } });
+    if (!status) { throw std::runtime_error(std::string("the results could not be written to ") + filepath); }
+}
+
+std::list<std::shared_ptr<const double[]>> CC::results()
+{
+    return { context_ };
+}
+
+size_t CC::evaluations() const
+{
+    return evaluator_->evaluations() + (grouping_ ? grouping_->evaluations() : 0);
+}
+
+size_t CC::groups() const
+{
+    return subcomponents_.size();
+}
+
+void CC::configure(std::shared_ptr<const Evolutionary::Settings> settings)
+{
+    settings_ = std::move(settings);
+
+    scale_ = settings_->scale;
+    dimension_ = settings_->dimension;
+    constraint_ = settings_->constraint;
+
+    upper_ = settings_->upper();
+    lower_ = settings_->lower();
+    integer_ = settings_->integer();
+
+//  the size of a species, the generations it evolves per cycle, the size of the random groups and of the groups of separable variables
+    size_ = settings_->population;
+    iteration_ = settings_->iteration;
+    group_ = settings_->group;
+    threads_ = settings_->threads;
+
+//  the detection of the interactions takes O(n log n) evaluations, the random groups none
+    random_ = settings_->grouping == "random";
+
+    evaluator_ = std::make_unique<Evaluator>(*settings_);
+    grouping_ = std::make_unique<::Evolutionary::Grouping>(settings_->objective,
+        [this](const double* objectives, const double* voilations) { return evaluator_->fitness(objectives) + evaluator_->penalty(voilations); },
+        scale_, dimension_, constraint_, upper_, lower_);
+
+    generator_.seed(settings_->seed);
+}
+
+math::Optimizor::Result& CC::optimize(math::Optimizor::Configuration& configuration)
+{
+    return optimize(Evolutionary::Settings::compile(configuration, { "maximum" }));
+}
+
+math::Optimizor::Result& CC::optimize(std::shared_ptr<const Evolutionary::Settings> settings)
+{
+    configure(std::move(settings));
+
+//  the context starts at a random point of the bounds
+    context_ = std::shared_ptr<double[]>(new double[scale_ + dimension_ + std::max<size_t>(constraint_, 1)]);
+
+    std::uniform_real_distribution<double> uniform(0, 1);
+    for (size_t i = 0; i < scale_; ++i)
+    {
+        double value = lower_[i] + uniform(generator_) * (upper_[i] - lower_[i]);
+        context_[i] = integer_[i] ? std::round(value) : value;
+    }
+
+    evaluator_->evaluate(context_.get(), context_.get() + scale_, context_.get() + scale_ + dimension_);
+    fitness_ = evaluator_->fitness(context_.get() + scale_);
+    penalty_ = evaluator_->penalty(context_.get() + scale_ + dimension_);
+
+    divide();
+    coevole(settings_->maximum);
+
+    return *this;
+}
@@ -0,0 +1,138 @@
+#include <list>
+#include <map>
+#include <string>
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <atomic>
+#include <variant>
+#include <numeric>
+#include <utility>
+
+#include "../../../math.h"
+#include "../../parallel.h"
+#include "../../registry.h"
+#include "../evolutionary.h"
+#include "../grouping.h"
+
+#ifndef _MATH_OPTIMIZATION_CC_
+#define _MATH_OPTIMIZATION_CC_
+//	evaluates the members of a subcomponent as the context vector with the variables of the group replaced,
+//	the objectives are scalarized by the weights, the sum of the voilations is compared before
+class Evaluator
+{
+private:
+//	the number of decisions held by a batch of full vectors
+	static constexpr size_t chunk_ = size_t(1) << 22;
+
+	size_t scale_, dimension_, constraint_;
+	std::vector<double> weights_;
+	math::Optimizor::Objective *objective_;
+	std::atomic<size_t> evaluations_;
+
+public:
+	double fitness(const double* objectives) const;
+	double penalty(const double* voilations) const;
+
+//	the fitnesses and penalties of the count members, each one the values of the variables
+	void evaluate(const std::vector<double>& context, const std::vector<size_t>& variables, const double* members, size_t count,
+		double* fitnesses, double* penalties);
+
+//	the objectives and voilations of a whole decision vector
+	void evaluate(const double* decisions, double* objectives, double* voilations);
+
+	size_t evaluations() const;
+
+public:
+	Evaluator(const Evolutionary::Settings& settings);
+};
+
+//	the species of a group of variables, evolved by differential evolution against the context vector
+class Subcomponent
+{
+private:
+	std::vector<size_t> variables_;
+	size_t size_, length_;
+
+	std::vector<double> members_, fitnesses_, penalties_;
+	size_t best_;
+
+	std::mt19937_64 generator_;
+	std::uniform_real_distribution<double> uniform_;
+
+private:
+	bool better(double fitness, double penalty, size_t member) const;
+
+public:
+//	evolve the members for the generations, the context is a copy taken at the start of the cycle
+	void evolve(Evaluator& evaluator, const std::vector<double>& context, const double* upper,
+		const double* lower, const double* integer, size_t generation);
+
+	const std::vector<size_t>& variables() const;
+	const double* best() const;
+	double fitness() const;
+	double penalty() const;
+
+public:
+//	the first member is taken from the context, so the context is never lost, the others are drawn in the bounds
+	Subcomponent(std::vector<size_t>&& variables, size_t size, const std::vector<double>& context,
+		const double* upper, const double* lower, const double* integer, size_t seed);
+};
+
+//	cooperative coevolution, the decisions are split into groups without interaction, by recursive differential grouping
+//	or by random groups redrawn every cycle, each group is evolved as its own species on its own thread against the shared context vector,
+//	the best members of all the species are merged into the context at the end of a cycle
+class CC : public Evolutionary::Coevolutionary
+{
+private:
+//	the compiled configuration, whose bounds the species share
+	std::shared_ptr<const Evolutionary::Settings> settings_;
+	size_t scale_, dimension_, constraint_;
+	const double *upper_, *lower_, *integer_;
+
+	std::unique_ptr<Evaluator> evaluator_;
+	std::unique_ptr<Evolutionary::Grouping> grouping_;
+	std::vector<Subcomponent> subcomponents_;
+
+	size_t size_, group_, iteration_, threads_;
+	bool random_;
+
+//	the decisions, objectives and voilations of the context vector, and its scalar fitness and penalty
+	std::shared_ptr<double[]> context_;
+	double fitness_, penalty_;
+
+	std::mt19937_64 generator_;
+
+private:
+	void configure(std::shared_ptr<const Evolutionary::Settings> settings);
+	void divide();
+	void merge();
+
+protected:
+	virtual void write(const char * filepath, char mode);
+	virtual std::list<std::shared_ptr<const double[]>> results();
+
+	virtual void coevole(size_t generation);
+	virtual math::Optimizor::Result& optimize(math::Optimizor::Configuration& configuration);
+
+public:
+	virtual math::Optimizor::Result& optimize(std::shared_ptr<const Evolutionary::Settings> settings);
+
+	size_t evaluations() const;
+	size_t groups() const;
+
+	virtual ~CC() {}
+};
+
+#ifdef _WINDOWS_
+	#define EXPORT __declspec(dllexport)
+#else
+	#define EXPORT __attribute__((visibility("default")))
+#endif
+
+#ifndef STATIC_OPTIMIZOR
+extern "C" EXPORT void* create();
+#else
+bool register_cc();
+#endif
+#endif //!_MATH_OPTIMIZATION_CC_
@@ -0,0 +1,76 @@
+#include "cc.h"
+
+double Evaluator::fitness(const double* objectives) const
+{
+    return std::inner_product(weights_.begin(), weights_.end(), objectives, 0.0);
+}
+
+double Evaluator::penalty(const double* voilations) const
+{
+    return std::accumulate(voilations, voilations + constraint_, 0.0, [](double sum, double value) { return sum + std::max(value, 0.0); });
+}
+
+//  the full vectors are built and evaluated by batches, so the parallel objectives get whole batches within a bounded memory
+void Evaluator::evaluate(const std::vector<double>& context, const std::vector<size_t>& variables, const double* members, size_t count,
+    double* fitnesses, double* penalties)
+{
+    size_t batch = std::max<size_t>(chunk_ / scale_, 1), length = variables.size();
+
+    std::vector<double> decisions, objectives, voilations;
+    std::vector<const double*> inputs;
+    std::vector<double*> outputs, violated;
+
+    for (size_t begin = 0; begin < count; begin += batch)
+    {
+        size_t size = std::min(batch, count - begin);
+
+        decisions.resize(size * scale_);
+        objectives.resize(size * dimension_);
+        voilations.resize(size * std::max<size_t>(constraint_, 1));
+        inputs.resize(size);
+        outputs.resize(size);
+        violated.resize(size);
+
+        for (size_t i = 0; i < size; ++i)
+        {
+            double* vector = &decisions[i * scale_];
+            const double* member = members + (begin + i) * length;
+
+            std::copy(context.begin(), context.begin() + scale_, vector);
+            for (size_t j = 0; j < length; ++j) { vector[variables[j]] = member[j]; }
+
+            inputs[i] = vector;
+            outputs[i] = &objectives[i * dimension_];
+            violated[i] = &voilations[i * std::max<size_t>(constraint_, 1)];
+        }
+
+        (*objective_)(size, inputs.data(), outputs.data(), violated.data());
+
+        for (size_t i = 0; i < size; ++i)
+        {
+            fitnesses[begin + i] = fitness(outputs[i]);
+            penalties[begin + i] = penalty(violated[i]);
+        }
+    }
+
+    evaluations_ += count;
+}
+
+void Evaluator::evaluate(const double* decisions, double* objectives, double* voilations)
+{
+    (*objective_)(decisions, objectives, voilations);
+    evaluations_++;
+}
+
+size_t Evaluator::evaluations() const
+{
+    return evaluations_;
+}
+
+//  without weights, the objectives are summed
+Evaluator::Evaluator(const Evolutionary::Settings& settings) :
+    scale_(settings.scale), dimension_(settings.dimension), constraint_(settings.constraint),
+    weights_(settings.weights.empty() ? std::vector<double>(dimension_, 1.0) : settings.weights),
+    objective_(settings.objective), evaluations_(0)
+{
+}
@@ -0,0 +1,100 @@
+#include "cc.h"
+
+//  the feasibility first, then the fitness
+bool Subcomponent::better(double fitness, double penalty, size_t member) const
+{
+    return penalty < penalties_[member] || (penalty == penalties_[member] && fitness < fitnesses_[member]);
+}
+
+//  differential evolution, rand/1/bin, the members are evaluated again at first as the context changed since the last cycle
+void Subcomponent::evolve(Evaluator& evaluator, const std::vector<double>& context, const double* upper,
+    const double* lower, const double* integer, size_t generation)
+{
+    const double scaling = 0.5, crossover = 0.9;
+
+    evaluator.evaluate(context, variables_, members_.data(), size_, fitnesses_.data(), penalties_.data());
+
+    std::vector<double> trials(size_ * length_), fitnesses(size_), penalties(size_);
+    std::uniform_int_distribution<size_t> pick(0, size_ - 1), position(0, length_ - 1);
+
+    for (size_t g = 0; g < generation; ++g)
+    {
+        for (size_t i = 0; i < size_; ++i)
+        {
+            size_t a, b, c;
+            do { a = pick(generator_); } while (a == i);
+            do { b = pick(generator_); } while (b == i || b == a);
+            do { c = pick(generator_); } while (c == i || c == a || c == b);
+
+            const double *x = &members_[i * length_], *r1 = &members_[a * length_], *r2 = &members_[b * length_], *r3 = &members_[c * length_];
+            double* trial = &trials[i * length_];
+            size_t forced = position(generator_);
+
+            for (size_t j = 0; j < length_; ++j)
+            {
+                size_t k = variables_[j];
+                double value = (j == forced || uniform_(generator_) < crossover) ? r1[j] + scaling * (r2[j] - r3[j]) : x[j];
+                value = std::max(std::min(value, upper[k]), lower[k]);
+                trial[j] = integer[k] ? std::round(value) : value;
+            }
+        }
+
+        evaluator.evaluate(context, variables_, trials.data(), size_, fitnesses.data(), penalties.data());
+
+        for (size_t i = 0; i < size_; ++i)
+        {
+        //  the trials as good as their parents replace them too, so the species drifts along the plateaus
+            bool worse = penalties_[i] < penalties[i] || (penalties_[i] == penalties[i] && fitnesses_[i] < fitnesses[i]);
+            if (worse) { continue; }
+
+            std::copy(&trials[i * length_], &trials[(i + 1) * length_], &members_[i * length_]);
+            fitnesses_[i] = fitnesses[i];
+            penalties_[i] = penalties[i];
+        }
+    }
+
+    best_ = 0;
+    for (size_t i = 1; i < size_; ++i)
+    {
+        best_ = better(fitnesses_[i], penalties_[i], best_) ? i : best_;
+    }
+}
+
+const std::vector<size_t>& Subcomponent::variables() const
+{
+    return variables_;
+}
+
+const double* Subcomponent::best() const
+{
+    return &members_[best_ * length_];
+}
+
+double Subcomponent::fitness() const
+{
+    return fitnesses_[best_];
+}
+
+double Subcomponent::penalty() const
+{
+    return penalties_[best_];
+}
+
+Subcomponent::Subcomponent(std::vector<size_t>&& variables, size_t size, const std::vector<double>& context,
+    const double* upper, const double* lower, const double* integer, size_t seed) :
+    variables_(std::move(variables)), size_(std::max<size_t>(size, 4)), length_(variables_.size()),
+    members_(size_ * length_), fitnesses_(size_, +INFINITY), penalties_(size_, +INFINITY), best_(0),
+    generator_(seed), uniform_(0, 1)
+{
+    for (size_t j = 0; j < length_; ++j) { members_[j] = context[variables_[j]]; }
+
+    for (size_t i = 1; i < size_; ++i)
+    {
+        for (size_t j = 0; j < length_; ++j)
+        {
+            size_t k = variables_[j];
+            double value = lower[k] + uniform_(generator_) * (upper[k] - lower[k]);
+            members_[i * length_ + j] = integer[k] ? std::round(value) : value;
+        }
+    }
+}
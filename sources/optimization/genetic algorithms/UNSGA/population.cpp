@@ -1,17 +1,33 @@
 #include "unsga.h"
 
-void generate(size_t scale, double *decisions, double *upper, double *lower, double *integer)
+//  without a timeout, a hung model blocks its worker, the crashes are recovered anyway
+std::unique_ptr<Evolutionary::Pool> pool(const Evolutionary::Settings& settings)
 {
-    auto temporary = math::allocate<double>(scale);
+    return settings.workers ? std::make_unique<Evolutionary::Pool>(settings.objective, settings.scale, settings.dimension, settings.constraint,
+        settings.workers, settings.timeout, settings.scratch, settings.prototype) : nullptr;
+}
 
-    math::sub(scale, upper, 1, lower, 1, temporary.get(), 1);
-    math::mul(scale, temporary.get(), 1, decisions, 1, decisions, 1);
-    math::add(scale, decisions, 1, lower, 1, decisions, 1);
+//  without a quantum, only the decisions with identical bits share the objectives
+std::unique_ptr<Evolutionary::Cache> cache(const Evolutionary::Settings& settings, math::Optimizor::Objective* objective)
+{
+    return settings.cache ? std::make_unique<Evolutionary::Cache>(objective, settings.scale, settings.dimension, settings.constraint,
+        settings.cache, settings.quantum) : nullptr;
+}
 
-    for (size_t i = 0; i < scale; ++i)
-    {
-        decisions[i] = integer[i] ? std::round(decisions[i]) : decisions[i];
-    }
+std::unique_ptr<Evolutionary::Surrogate> surrogate(const Evolutionary::Settings& settings)
+{
+    return settings.surrogate ? std::make_unique<Evolutionary::Surrogate>(settings.scale, settings.dimension, settings.constraint,
+        settings.surrogate, settings.upper(), settings.lower()) : nullptr;
+}
+
+//  by default, a search per objective and twenty evaluations per decision at most a thousand
+std::unique_ptr<Evolutionary::Memetic<Individual>> memetic(const Evolutionary::Settings& settings, math::Optimizor::Objective* objective)
+{
+    size_t count = settings.searches ? settings.searches : settings.dimension;
+    size_t budget = settings.budget ? settings.budget : std::min<size_t>(20 * settings.scale, 1000);
+
+    return settings.memetic ? std::make_unique<Evolutionary::Memetic<Individual>>(objective, settings.scale, settings.dimension, settings.constraint,
+        count, budget, settings.division, settings.upper(), settings.lower(), settings.integer(), settings.seed + 3) : nullptr;
 }
 
 Evolutionary::Selector<Individual>& Population::selector()
@@ -24,51 +40,172 @@ Evolutionary::Reproducor<Individual>& Population::reproducor()
     return *reproducor_;
 }
 
-Population::Population(math::Optimizor::Configuration& configuration) :
-    scale(std::get<size_t>(configuration["scale"])),
-    dimension(std::get<size_t>(configuration["dimension"])),
-    constraint(std::get<size_t>(configuration["constraint"])),
-    selector_(std::make_unique<Reference>(configuration)), reproducor_(std::make_unique<Reproducor>(configuration))
+const Evolutionary::Cache* Population::cache() const
 {
-    size_t population = std::get<size_t>(configuration["population"]);
+    return cache_.get();
+}
 
-    std::vector<double> upper = std::get<std::vector<double>>(configuration["upper"]);
-    std::vector<double> lower = std::get<std::vector<double>>(configuration["lower"]);
-    std::vector<double> integer = std::get<std::vector<double>>(configuration["integer"]);
+Population::Population(std::shared_ptr<const Evolutionary::Settings> settings) :
+    settings_(std::move(settings)),
+    pool_(::pool(*settings_)), cache_(::cache(*settings_, pool_ ? pool_.get() : settings_->objective)),
+    surrogate_(::surrogate(*settings_)),
+    objective_(cache_ ? static_cast<math::Optimizor::Objective*>(cache_.get()) : (pool_ ? pool_.get() : settings_->objective)),
+    selector_(std::make_unique<Reference>(*settings_)), reproducor_(std::make_unique<Reproducor>(*settings_, objective_, surrogate_.get())),
+    memetic_(::memetic(*settings_, objective_)), interval_(settings_->memetic), telemetry_(nullptr),
+    scale(settings_->scale), dimension(settings_->dimension), constraint(settings_->constraint)
+{
+    std::mt19937_64 generator(settings_->seed);
 
-    std::vector<std::vector<double>> initials;
+//  the whole decision matrix is drawn at once, the initial decisions given take the first rows
+    std::vector<double> decisions(settings_->population * scale);
+    Evolutionary::sample(settings_->initialization, settings_->population, scale, decisions.data(),
+        settings_->upper(), settings_->lower(), settings_->integer(), generator);
 
-    try
+    for (size_t i = 0; i < std::min(settings_->initials.size(), settings_->population); ++i)
     {
-        initials = std::get<std::vector<std::vector<double>>>(configuration["initial"]);
+        std::copy(settings_->initials[i].begin(), settings_->initials[i].end(), &decisions[i * scale]);
     }
-    catch(...)
+
+    individuals.resize(settings_->population);
+    std::generate(individuals.begin(), individuals.end(), [this]() { return new Individual(scale, dimension, constraint); });
+
+    auto row = decisions.begin();
+    for (auto& individual : individuals)
     {
+        std::copy(row, row + scale, individual->decisions);
+        row += scale;
     }
+}
 
-    std::random_device seed;
-    std::mt19937_64 generator(seed());
-    std::uniform_real_distribution<double> uniform(0, 1);
-
-    individuals.resize(population);
-    std::generate(individuals.begin(), individuals.end(), [this]() { return new Individual(scale, dimension, constraint); });
+//  the evaluations failed by the pool are run again from new decisions up to its retries, an individual still failed
+//  then copies one evaluated, the run cannot start if none was
+void Population::evaluate()
+{
+    std::mt19937_64 generator(settings_->seed + 1);
+    std::list<Individual*> pending = individuals;
 
-    auto initial = initials.begin();
-    for(auto& individual : individuals)
+    for (size_t attempt = 0; attempt <= Evolutionary::Pool::retries && !pending.empty(); ++attempt)
     {
-        if(initial == initials.end())
+        if (attempt)
         {
-            std::generate(individual->decisions, individual->decisions + scale, [&uniform, &generator]() { return uniform(generator); });
-            generate(scale, individual->decisions, &upper[0], &lower[0], &integer[0]);
-        }
-        else
-        {
-            math::copy(scale, &(*initial)[0], 1, individual->decisions, 1);
-            initial++;
+            std::vector<double> decisions(pending.size() * scale);
+            Evolutionary::sample("uniform", pending.size(), scale, decisions.data(), settings_->upper(), settings_->lower(), settings_->integer(), generator);
+
+            size_t row = 0;
+            for (auto& individual : pending) { math::copy(scale, decisions.data() + scale * row++, 1, individual->decisions, 1); }
         }
 
-        (*configuration.objective)(individual->decisions, individual->objectives, individual->voilations);
+        evaluate(pending);
+        pending.remove_if([this](const Individual* individual) { return !Evolutionary::Pool::failed(dimension, individual->objectives); });
     }
+
+    auto evaluated = std::find_if(individuals.begin(), individuals.end(), [this](const Individual* individual)
+        { return !Evolutionary::Pool::failed(dimension, individual->objectives); });
+
+    if (!pending.empty() && evaluated == individuals.end()) { throw std::runtime_error("no evaluation of the initial population succeeded"); }
+
+    for (auto& individual : pending)
+    {
+        math::copy(scale, (*evaluated)->decisions, 1, individual->decisions, 1);
+        math::copy(dimension, (*evaluated)->objectives, 1, individual->objectives, 1);
+        math::copy(constraint, (*evaluated)->voilations, 1, individual->voilations, 1);
+    }
+
+    for (auto& individual : individuals)
+    {
+        surrogate_ ? surrogate_->insert(individual->decisions, individual->objectives, individual->voilations) : void();
+    }
+}
+
+void Population::evaluate(const std::list<Individual*>& individuals)
+{
+    std::vector<const double*> decisions;
+    std::vector<double*> objectives, voilations;
+
+    for (auto& individual : individuals)
+    {
+        decisions.push_back(individual->decisions);
+        objectives.push_back(individual->objectives);
+        voilations.push_back(individual->voilations);
+    }
+
+//  a thread safe objective without a pool or a cache in front splits the batch between the threads
+    size_t threads = objective_ == settings_->objective ? std::min(settings_->threads, individuals.size()) : 0;
+
+    if (threads > 1)
+    {
+        size_t size = (individuals.size() + threads - 1) / threads;
+
+        math::parallel(threads, threads, [&](size_t k)
+            {
+                size_t begin = std::min(k * size, individuals.size()), count = std::min(size, individuals.size() - begin);
+                (*objective_)(count, decisions.data() + begin, objectives.data() + begin, voilations.data() + begin);
+            });
+    }
+    else
+    {
+        (*objective_)(individuals.size(), decisions.data(), objectives.data(), voilations.data());
+    }
+}
+
+//  the improved members are overwritten in place, the layers of the selector pick the changes up at the next sort
+void Population::improve(size_t generation)
+{
+    if (!memetic_ || generation % interval_) { return; }
+
+    Evolutionary::Timer timer(telemetry_, Evolutionary::Phase::local);
+
+    auto&& layers = selector().sort(individuals);
+    size_t evaluations = memetic_->improve(*layers.begin());
+
+    telemetry_ ? void(telemetry_->profile().evaluations += evaluations) : void();
+}
+
+void Population::instrument(Evolutionary::Telemetry* telemetry)
+{
+    telemetry_ = telemetry;
+    selector_->instrument(telemetry);
+    reproducor_->instrument(telemetry);
+}
+
+void Population::save(Evolutionary::Snapshot& snapshot) const
+{
+    size_t length = scale + dimension + constraint;
+
+    std::vector<double> values;
+    for (const auto& individual : individuals)
+    {
+        values.insert(values.end(), individual->decisions, individual->decisions + length);
+    }
+
+    Evolutionary::store(snapshot, "population", values);
+
+    selector_->save(snapshot, individuals);
+    reproducor_->save(snapshot);
+    surrogate_ ? surrogate_->save(snapshot, "surrogate") : void();
+    memetic_ ? memetic_->save(snapshot, "memetic") : void();
+}
+
+//  return false if the snapshot does not match the configured population
+bool Population::restore(const Evolutionary::Snapshot& snapshot)
+{
+    size_t length = scale + dimension + constraint;
+    auto&& values = Evolutionary::load<double>(snapshot, "population");
+
+    if (values.empty() || values.size() != individuals.size() * length) { return false; }
+
+    auto value = values.begin();
+    for (auto& individual : individuals)
+    {
+        std::copy(value, value + length, individual->decisions);
+        value += length;
+    }
+
+    selector_->restore(snapshot, individuals);
+    reproducor_->restore(snapshot);
+    surrogate_ ? surrogate_->restore(snapshot, "surrogate") : void();
+    memetic_ ? memetic_->restore(snapshot, "memetic") : void();
+    return true;
 }
 
 Population::~Population()
@@ -2,97 +2,11 @@
 /**************************************************************************
  *  non dominated sort
  ***************************************************************/
-int dominate(size_t length, const double* lhs, const double* rhs)
-/*
- *  1 indicates lhs dominate rhs
- *  0 indicates non dominated
- * -1 indicates rhs domiantes lhs
- */
-{
-    size_t counts[3] = { 0, 0, 0 };
-
-    for (size_t i = 0; i < length; ++i)
-    {
-        counts[std::abs(lhs[i] - rhs[i]) < 1e-10 ? 1 : (lhs[i] > rhs[i] ? 0 : 2)]++;
-    }
-
-    return (counts[1] == length) ? 0 : ((!counts[0]) ? 1 : ((!counts[2]) ? -1 : 0));
-}
-
-int dominate(size_t dimension, size_t constraint, const Individual& lhs, const Individual& rhs)
-{
-//  compare the voilations of the constraints first
-//  by this way, voilations have higher priority
-    int status = dominate(constraint, lhs.voilations, rhs.voilations);
-//  compare the objectives if no constraints voilation of the two individuals
-    return status != 0 ? status : dominate(dimension, lhs.objectives, rhs.objectives);
-}
-
-std::pair<bool, std::list<Individual*>> sort(size_t dimension, size_t constraint, Individual* individual, std::list<Individual*>& current)
-{
-    auto results = std::make_pair<bool, std::list<Individual*>>(true, {});
-    auto& [status, dominated] = results;
-
-    for(auto member = current.begin(); member != current.end();)
-    {
-        auto indicator = dominate(dimension, constraint, **member, *individual);
-
-    //  theoretically, if a individual is dominated by an individual in the current layer,
-    //  the individuals dominated by this individual should not occur in this layer but the lower layers,
-    //  which means once the indicator equals to -1, the loop should be stopped.
-    //  however,  due to the equal judgement of the floating number
-    //  there are still the situations that an individual can be dominated by an individual and dominates individuals in a layer
-        status = status && (indicator != 1);
-        indicator == -1 ? dominated.push_back(*member) : void();
-        member = indicator == -1 ? current.erase(member) : std::next(member);
-    }
-
-    return results;
-}
-
-std::list<std::list<Individual*>> sort(size_t dimension, size_t constraint, const std::list<Individual*>& individuals)
-{
-    std::list<std::list<Individual*>> results = { {} };
-
-//  the non dominated sort is re-designed per bubble sort idea
-    for(const auto& individual : individuals)
-    {
-        std::list<Individual*> dominated(0);
-    //  bubble sorting loop
-        for (auto layer = results.begin(); layer != results.end(); ++layer)
-        {
-        //  status : dominating status, true if not dominated by any members in the current layer
-        //  lower : individuals dominated by the individual and moved out from the current layer
-            auto&& [status, lower] = sort(dimension, constraint, individual, *layer);
-
-        //  merge the dominated individuals to the dominated list
-            dominated.splice(dominated.end(), std::forward<std::list<Individual*>&&>(lower));
-
-            if ((!status) && std::next(layer) != results.end()) { continue; }
-
-            status ? layer->push_back(individual) : results.push_back({ individual });
-
-        //  determine the process for dominated individuals
-        //  if status is false, it means the individual has been appended to the end of results,
-        //  and the dominated individuals should be appended after the invididual
-        //  if status is true, it means the individual has been merged to the current layer,
-        //  only if there are no further layers need the individuals to be appended to the end of results,
-        //  or merge them to the next layer
-            bool append = (!status) || std::next(layer) == results.end();
-            append ? (dominated.empty() ? void() : results.push_back(dominated)) : std::next(layer)->splice(std::next(layer)->end(), dominated);
-
-        //  exit the loop
-            break;
-        }
-    }
-
-    return results;
-}
-
 std::list<std::list<Individual*>> Reference::sort(const std::list<Individual*>& population) const
 {
-//    size_t scale_, dimension_, constraint_;
-    return ::sort(dimension_, constraint_, population);
+//  only the individuals joined or overwritten since the last call are re-inserted
+    layers_.synchronize(population);
+    return layers_.fronts();
 }
 
 /**************************************************************************
@@ -340,7 +254,19 @@ void Reference::dispense(size_t needed, std::list<Individual*>& elites, std::lis
 
 std::pair<std::list<Individual*>, std::list<Individual*>> Reference::select(const std::list<Individual*>& population)
 {
-    auto layers = sort(population);
+    std::list<std::list<Individual*>> layers;
+
+    {
+        Evolutionary::Timer timer(telemetry_, Evolutionary::Phase::sort);
+        layers = sort(population);
+    }
+
+    if (telemetry_)
+    {
+        telemetry_->profile().front = layers.begin()->size();
+        telemetry_->profile().layers = layers.size();
+    }
+
     auto results = std::make_pair<>(std::move(*layers.begin()), std::list<Individual*>());
     auto& [elite, ordinary] = results;
 
@@ -357,6 +283,7 @@ std::pair<std::list<Individual*>, std::list<Individual*>> Reference::select(cons
     }
     else if(selection_ > elite.size())
     {
+        Evolutionary::Timer timer(telemetry_, Evolutionary::Phase::dispense);
         dispense(selection_ - elite.size(), elite, *layers.begin());
     }
 
@@ -368,6 +295,43 @@ std::pair<std::list<Individual*>, std::list<Individual*>> Reference::select(cons
 
     return results;
 }
+void Reference::instrument(Evolutionary::Telemetry* telemetry)
+{
+    telemetry_ = telemetry;
+}
+
+/**************************************************************************
+ *  snapshot of the layers and the order of the reference points
+ ***************************************************************/
+void Reference::save(Evolutionary::Snapshot& snapshot, const std::list<Individual*>& population) const
+{
+    layers_.save(snapshot, "reference", population);
+
+    std::vector<double> points;
+    for (const auto& [point, count, associated] : associations_)
+    {
+        points.insert(points.end(), point.get(), point.get() + dimension_);
+    }
+
+    Evolutionary::store(snapshot, "reference.points", points);
+}
+
+void Reference::restore(const Evolutionary::Snapshot& snapshot, const std::list<Individual*>& population)
+{
+    layers_.restore(snapshot, "reference", population);
+
+    auto&& points = Evolutionary::load<double>(snapshot, "reference.points");
+
+    if (points.size() != associations_.size() * dimension_) { return; }
+
+    auto point = points.begin();
+    for (auto& [pointer, count, associated] : associations_)
+    {
+        std::copy(point, point + dimension_, pointer.get());
+        point += dimension_;
+    }
+}
+
 /**************************************************************************
  *  reference plaint constructor
  ***************************************************************/
@@ -396,14 +360,15 @@ std::list<std::list<double>> permutation(size_t dimension, size_t division)
     return results;
 }
 
-Reference::Reference(const math::Optimizor::Configuration& configuration) :
-    scale_(std::get<size_t>(configuration["scale"])),
-    dimension_(std::get<size_t>(configuration["dimension"])),
-    constraint_(std::get<size_t>(configuration["constraint"])),
-    selection_(std::get<size_t>(configuration["population"]) / 2),
-    ideal_(math::allocate<double>(dimension_)), interception_(math::allocate<double>(dimension_))
+Reference::Reference(const Evolutionary::Settings& settings) :
+    scale_(settings.scale),
+    dimension_(settings.dimension),
+    constraint_(settings.constraint),
+    selection_(settings.population / 2),
+    ideal_(math::allocate<double>(dimension_)), interception_(math::allocate<double>(dimension_)),
+    layers_(dimension_, constraint_), telemetry_(nullptr)
 {
-    size_t division = std::get<size_t>(configuration["division"]);
+    size_t division = settings.division;
 
     for (const auto& point : permutation(dimension_, division))
     {
@@ -1,58 +1,197 @@
 #include "unsga.h"
 
-//  simulated binary crossover
-void Reproducor::cross(const Individual& father, const Individual& mother, Individual& son, Individual& daughter)
+//  simulated binary crossover of the consecutive pairs of parents into the consecutive pairs of children,
+//  the random numbers of all the pairs are drawn at once and raised to the power by a single call
+void Reproducor::cross(const std::vector<const Individual*>& parents, const std::vector<Individual*>& children)
 {
-    auto randoms = math::allocate<double>(scale_);
-    auto temporary = math::allocate<double>(scale_);
-//    auto father = parents[0], mother = parents[1], son = children[0], daughter = children[1];
+    size_t count = children.size() / 2;
+    randoms_.resize(count * scale_);
 
-    for(auto r = randoms.get(); r != randoms.get() + scale_; *r = uniform_(generator_), ++r)
+    for (auto& random : randoms_)
     {
-        *r = (*r < 0.5) ? 2.0 * *r : 0.5 / (1.0 - *r);
+        double value = uniform_(generator_);
+        random = value < 0.5 ? 2.0 * value : 0.5 / (1.0 - value);
     }
 
-    math::pow(scale_, randoms.get(), 1, 1 / (cross_ + 1), randoms.get(), 1);
+    math::pow(randoms_.size(), randoms_.data(), 1, 1 / (cross_ + 1), randoms_.data(), 1);
+
+    for (size_t p = 0; p < count; ++p)
+    {
+        const double *father = parents[2 * p]->decisions, *mother = parents[2 * p + 1]->decisions, *beta = &randoms_[p * scale_];
+        double *son = children[2 * p]->decisions, *daughter = children[2 * p + 1]->decisions;
+
+        for (size_t i = 0; i < scale_; ++i)
+        {
+            double sum = father[i] + mother[i], difference = beta[i] * (father[i] - mother[i]);
+            son[i] = 0.5 * (sum - difference);
+            daughter[i] = 0.5 * (sum + difference);
+        }
+    }
+
+    check(children);
+}
+
+//  polynomial mutation of every gene of the individuals, both powers are taken over all the genes at once
+void Reproducor::mutate(const std::vector<Individual*>& individuals)
+{
+    size_t length = individuals.size() * scale_;
+    randoms_.resize(length);
+    weights_.resize(length);
+
+    std::generate(randoms_.begin(), randoms_.end(), [this]() { return uniform_(generator_); });
+
+    for (size_t k = 0; k < individuals.size(); ++k)
+    {
+        const double *decisions = individuals[k]->decisions, *randoms = &randoms_[k * scale_];
+        double* weights = &weights_[k * scale_];
+
+        for (size_t i = 0; i < scale_; ++i)
+        {
+            weights[i] = ((randoms[i] < 0.5) ? (upper_[i] - decisions[i]) : (decisions[i] - lower_[i])) / (upper_[i] - lower_[i]);
+        }
+    }
+
+    math::pow(length, weights_.data(), 1, mutation_ + 1, weights_.data(), 1);
+
+    for (size_t k = 0; k < length; ++k)
+    {
+        double base = std::min(randoms_[k], 1 - randoms_[k]);
+        weights_[k] = 2 * base + (1 - 2 * base) * weights_[k];
+    }
+
+    math::pow(length, weights_.data(), 1, 1.0 / (mutation_ + 1.0), weights_.data(), 1);
+
+    for (size_t k = 0; k < individuals.size(); ++k)
+    {
+        double* decisions = individuals[k]->decisions;
+        const double *randoms = &randoms_[k * scale_], *bases = &weights_[k * scale_];
 
-    math::sub(scale_, father.decisions, 1, mother.decisions, 1, temporary.get(), 1);
-    math::mul(scale_, randoms.get(), 1, temporary.get(), 1, temporary.get(), 1);
+        for (size_t i = 0; i < scale_; ++i)
+        {
+            decisions[i] += randoms[i] < 0.5 ? bases[i] - 1 : 1 - bases[i];
+        }
+    }
 
-    math::add(scale_, father.decisions, 1, mother.decisions, 1, son.decisions, 1);
-    math::sub(scale_, son.decisions, 1, temporary.get(), 1, son.decisions, 1);
-    math::scal(scale_, 0.5, son.decisions, 1);
+    check(individuals);
+}
 
-    math::add(scale_, father.decisions, 1, mother.decisions, 1, daughter.decisions, 1);
-    math::add(scale_, daughter.decisions, 1, temporary.get(), 1, daughter.decisions, 1);
-    math::scal(scale_, 0.5, daughter.decisions, 1);
+//  clamp to the bounds and round the integers in a single pass
+void Reproducor::check(const std::vector<Individual*>& individuals)
+{
+    for (auto& individual : individuals)
+    {
+        for (size_t i = 0; i < scale_; ++i)
+        {
+            double value = std::max(std::min(individual->decisions[i], upper_[i]), lower_[i]);
+            individual->decisions[i] = integer_[i] ? std::round(value) : value;
+        }
+    }
+}
 
-    check(son);
-    check(daughter);
+void Reproducor::cross(const Individual& father, const Individual& mother, Individual& son, Individual& daughter)
+{
+    cross({ &father, &mother }, { &son, &daughter });
 }
 
 void Reproducor::mutate(Individual& individual)
 {
-    for (size_t i = 0; i < scale_; ++i)
+    mutate(std::vector<Individual*>{ &individual });
+}
+
+void Reproducor::check(Individual& individual)
+{
+    check(std::vector<Individual*>{ &individual });
+}
+
+//  the evaluations failed by the pool are run again up to its retries, the individuals still failed are returned
+std::list<Individual*> Reproducor::evaluate(const std::list<Individual*>& individuals)
+{
+    Evolutionary::Timer timer(telemetry_, Evolutionary::Phase::evaluation);
+
+    std::list<Individual*> pending = individuals;
+
+    for (size_t attempt = 0; attempt <= Evolutionary::Pool::retries && !pending.empty(); ++attempt)
     {
-        double random = uniform_(generator_);
-        double weight = ((random < 0.5) ? (upper_[i] - individual.decisions[i]) : (individual.decisions[i] - lower_[i])) / (upper_[i] - lower_[i]);
+        std::vector<const double*> decisions;
+        std::vector<double*> objectives, voilations;
+
+        for (auto& individual : pending)
+        {
+            decisions.push_back(individual->decisions);
+            objectives.push_back(individual->objectives);
+            voilations.push_back(individual->voilations);
+        }
+
+        (*function_)(pending.size(), decisions.data(), objectives.data(), voilations.data());
 
-        double base = std::min(random, 1 - random);
-        base = std::pow(2 * base + (1 - 2 * base) * std::pow(weight, mutation_ + 1), 1.0 / (mutation_ + 1.0));
+        if (telemetry_) { telemetry_->profile().evaluations += pending.size(); }
 
-        individual.decisions[i] += random <  0.5 ? base - 1 : 1 - base;
+        pending.remove_if([this](const Individual* individual) { return !Evolutionary::Pool::failed(dimension_, individual->objectives); });
     }
 
-    check(individual);
+    for (auto& individual : individuals)
+    {
+        bool failed = Evolutionary::Pool::failed(dimension_, individual->objectives);
+        surrogate_ && !failed ? surrogate_->insert(individual->decisions, individual->objectives, individual->voilations) : void();
+    }
+
+    return pending;
 }
 
-void Reproducor::check(Individual& individual)
+//  the children are ranked by the number of elites dominating their lower confidence bound, and by their uncertainty,
+//  the most promising and the most uncertain ones are taken alternately into the ordinaries, the others are dropped
+size_t Reproducor::screen(const std::vector<Individual*>& children, const std::list<Individual*>& elites, std::list<Individual*>& ordinaries)
 {
-    for(auto value = individual.decisions, upper = upper_.get(), lower = lower_.get(), integer = integer_.get();
-        value != individual.decisions + scale_; ++value, ++upper, ++lower, ++integer)
+    if (children.empty()) { return 0; }
+
+    double fraction = fractions_[std::min(generation_, fractions_.size() - 1)];
+    size_t budget = std::clamp<size_t>(size_t(std::ceil(fraction * children.size())), 1, children.size());
+
+    std::vector<double> fronts;
+    for (const auto& elite : elites)
     {
-		*value = std::max(std::min(*value, *upper), *lower);
-        *value = *integer ? std::round(*value) : *value;
+        fronts.insert(fronts.end(), elite->objectives, elite->objectives + dimension_);
+        fronts.insert(fronts.end(), elite->voilations, elite->voilations + constraint_);
+    }
+
+    size_t length = dimension_ + constraint_;
+    std::vector<double> means(length), deviations(length), uncertainties(children.size());
+    std::vector<size_t> dominators(children.size(), 0);
+
+    for (size_t i = 0; i < children.size(); ++i)
+    {
+        uncertainties[i] = surrogate_->predict(children[i]->decisions, means.data(), deviations.data());
+        math::sub(length, means.data(), 1, deviations.data(), 1, means.data(), 1);
+
+        for (size_t j = 0; j < fronts.size(); j += length)
+        {
+            dominators[i] += Evolutionary::dominate(dimension_, constraint_, &fronts[j], means.data()) == 1;
+        }
     }
+
+    std::vector<size_t> promising(children.size()), uncertain(children.size());
+    std::iota(promising.begin(), promising.end(), 0);
+    std::iota(uncertain.begin(), uncertain.end(), 0);
+
+    std::stable_sort(promising.begin(), promising.end(), [&dominators, &uncertainties](size_t lhs, size_t rhs)
+        { return dominators[lhs] < dominators[rhs] || (dominators[lhs] == dominators[rhs] && uncertainties[lhs] > uncertainties[rhs]); });
+    std::stable_sort(uncertain.begin(), uncertain.end(), [&uncertainties](size_t lhs, size_t rhs) { return uncertainties[lhs] > uncertainties[rhs]; });
+
+    std::vector<bool> chosen(children.size(), false);
+    auto ordinary = ordinaries.begin();
+
+    for (size_t k = 0, p = 0, u = 0; k < budget; ++k, ++ordinary)
+    {
+        auto& orders = k % 2 ? uncertain : promising;
+        auto& index = k % 2 ? u : p;
+
+        while (chosen[orders[index]]) { index++; }
+        chosen[orders[index]] = true;
+
+        math::copy(scale_, children[orders[index]]->decisions, 1, (*ordinary)->decisions, 1);
+    }
+
+    return budget;
 }
 
 std::list<Individual*> Reproducor::reproduce(std::pair<std::list<Individual*>, std::list<Individual*>>&& population)
@@ -69,35 +208,72 @@ std::list<Individual*> Reproducor::reproduce(std::pair<std::list<Individual*>, s
     }
 
     ordinaries.reverse();
-    for(auto iter = elites.begin(); iter != elites.end() && !ordinaries.empty(); iter = std::next(iter, 2))
+
+    std::optional<Evolutionary::Timer> timer(std::in_place, telemetry_, Evolutionary::Phase::variation);
+
+//  the children are bred in place of the ordinaries, or into the candidates to be screened by the surrogate
+    size_t count = std::min(elites.size(), ordinaries.size()) / 2 * 2;
+    std::vector<Individual*> children(ordinaries.begin(), std::next(ordinaries.begin(), count));
+
+    if (surrogate_)
     {
-        cross(**iter, **std::next(iter), **ordinaries.begin(), **std::next(ordinaries.begin()));
+        while (candidates_.size() < count) { candidates_.push_back(std::make_unique<Individual>(scale_, dimension_, constraint_)); }
+        std::transform(candidates_.begin(), candidates_.begin() + count, children.begin(), [](const auto& candidate) { return candidate.get(); });
+    }
 
-        for (size_t i = 0; i < 2;  ++i)
-        {
-            auto& child = **std::next(ordinaries.begin(), i);
-            uniform_(generator_) > threshold_ ? mutate(child) : void();
-            (*function_)(child.decisions, child.objectives, child.voilations);
-        }
+//  the whole offspring is crossed and then mutated at once
+    std::vector<const Individual*> parents(elites.begin(), std::next(elites.begin(), count));
+    cross(parents, children);
+
+    std::vector<Individual*> mutants;
+    for (auto& child : children)
+    {
+        uniform_(generator_) > threshold_ ? mutants.push_back(child) : void();
+    }
 
-        offsprings.splice(offsprings.end(), ordinaries, ordinaries.begin(), std::next(ordinaries.begin(), 2));
+    mutate(mutants);
+
+    count = surrogate_ ? screen(children, elites, ordinaries) : count;
+    offsprings.splice(offsprings.end(), ordinaries, ordinaries.begin(), std::next(ordinaries.begin(), count));
+
+    timer.reset();
+
+//  a child whose evaluation keeps failing is replaced by a copy of an elite, so no failed objectives reach the selection
+    for (auto& failed : evaluate(offsprings))
+    {
+        const Individual* elite = *std::next(elites.begin(), std::uniform_int_distribution<size_t>(0, elites.size() - 1)(generator_));
+
+        math::copy(scale_, elite->decisions, 1, failed->decisions, 1);
+        math::copy(dimension_, elite->objectives, 1, failed->objectives, 1);
+        math::copy(constraint_, elite->voilations, 1, failed->voilations, 1);
     }
 
+    generation_++;
+
     elites.splice(elites.end(), offsprings);
     elites.splice(elites.end(), ordinaries);
     return elites;
 }
 
-Reproducor::Reproducor(math::Optimizor::Configuration& configuration) :
-    scale_(std::get<size_t>(configuration["scale"])), dimension_(std::get<size_t>(configuration["dimension"])),
-    cross_(std::get<double>(configuration["cross"])), mutation_(std::get<double>(configuration["mutation"])), threshold_(0.8),
-    upper_(math::allocate<double>(scale_)), lower_(math::allocate<double>(scale_)), integer_(math::allocate<double>(scale_)),
-    function_(configuration.objective.get()), generator_(std::random_device()()), uniform_(0, 1)
+void Reproducor::instrument(Evolutionary::Telemetry* telemetry)
 {
-    for(auto& [name, pointer] :
-        std::map<std::string, double*>{ { "upper", upper_.get() }, { "lower", lower_.get() }, { "integer", integer_.get() } })
-    {
-        const auto& value = std::get<std::vector<double>>(configuration[name]);
-        std::copy(value.begin(), value.end(), pointer);
-    }
-}
\ No newline at end of file
+    telemetry_ = telemetry;
+}
+
+void Reproducor::save(Evolutionary::Snapshot& snapshot) const
+{
+    Evolutionary::serialize(snapshot, "reproducor", generator_, uniform_, generation_);
+}
+
+void Reproducor::restore(const Evolutionary::Snapshot& snapshot)
+{
+    Evolutionary::deserialize(snapshot, "reproducor", generator_, uniform_, generation_);
+}
+
+Reproducor::Reproducor(const Evolutionary::Settings& settings, math::Optimizor::Objective* objective, Evolutionary::Surrogate* surrogate) :
+    scale_(settings.scale), dimension_(settings.dimension), constraint_(settings.constraint), generation_(0),
+    cross_(settings.cross), mutation_(settings.mutation), threshold_(0.8),
+    upper_(settings.upper()), lower_(settings.lower()), integer_(settings.integer()),
+    function_(objective), fractions_(settings.fractions), surrogate_(surrogate), telemetry_(nullptr), generator_(settings.seed + 2), uniform_(0, 1)
+{
+}
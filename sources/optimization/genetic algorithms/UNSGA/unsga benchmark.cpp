@@ -0,0 +1,268 @@
+#include <iostream>
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <cstdio>
+#include <cstdlib>
+#include "unsga.h"
+#include "../problems.h"
+
+#ifndef _WINDOWS_
+#include <sys/resource.h>
+#endif
+
+//	sums the profiles of the generations
+class Recorder : public Evolutionary::Observer
+{
+public:
+	size_t generations = 0;
+	double wall = 0;
+
+public:
+	virtual void observe(const Evolutionary::Profile& profile)
+	{
+		generations++;
+		wall = std::accumulate(profile.walls.begin(), profile.walls.end(), wall);
+	}
+};
+
+//	counts the evaluations asked of the problem, one by one or in batches, from any thread
+class Counter : public math::Optimizor::Objective
+{
+private:
+	std::unique_ptr<math::Optimizor::Objective> objective_;
+	std::atomic<size_t>& count_;
+
+public:
+	virtual void operator() (const double* decisions, double* objectives, double* voilations)
+	{
+		count_++;
+		(*objective_)(decisions, objectives, voilations);
+	}
+
+	virtual void operator() (size_t count, const double* const* decisions, double* const* objectives, double* const* voilations)
+	{
+		count_ += count;
+		(*objective_)(count, decisions, objectives, voilations);
+	}
+
+public:
+	Counter(std::unique_ptr<math::Optimizor::Objective> objective, std::atomic<size_t>& count) : objective_(std::move(objective)), count_(count) {}
+};
+
+//	peak resident set size in megabytes
+double peak()
+{
+#ifdef _WINDOWS_
+	return 0;
+#else
+	rusage usage;
+	getrusage(RUSAGE_SELF, &usage);
+	return usage.ru_maxrss / 1024.0;
+#endif
+}
+
+//	hypervolume of the normalized front, exact up to 4 objectives and estimated by sampling above
+double hypervolume(size_t dimension, const std::vector<double>& points)
+{
+	std::vector<double> reference(dimension, 1.1), inside;
+
+	for (size_t i = 0; i < points.size(); i += dimension)
+	{
+		if (std::equal(points.begin() + i, points.begin() + i + dimension, reference.begin(), std::less<double>()))
+		{
+			inside.insert(inside.end(), points.begin() + i, points.begin() + i + dimension);
+		}
+	}
+
+	if (dimension <= 4) { return Evolutionary::hypervolume(dimension, inside, reference.data()); }
+
+	std::mt19937_64 generator(0);
+	std::uniform_real_distribution<double> uniform(0, 1.1);
+	std::vector<double> sample(dimension);
+
+	size_t samples = 100000, hits = 0;
+	for (size_t s = 0; s < samples; ++s)
+	{
+		std::generate(sample.begin(), sample.end(), [&]() { return uniform(generator); });
+
+		for (size_t i = 0; i < inside.size(); i += dimension)
+		{
+			if (std::equal(sample.begin(), sample.end(), inside.begin() + i, std::greater_equal<double>())) { hits++; break; }
+		}
+	}
+
+	return std::pow(1.1, double(dimension)) * hits / samples;
+}
+
+//	inverted generational distance from the reference front
+double generational(size_t dimension, const std::vector<double>& points, const std::vector<double>& references)
+{
+	double sum = 0;
+	for (size_t r = 0; r < references.size(); r += dimension)
+	{
+		double nearest = +INFINITY;
+		for (size_t p = 0; p < points.size(); p += dimension)
+		{
+			double distance = 0;
+			for (size_t i = 0; i < dimension; ++i) { distance += std::pow(points[p + i] - references[r + i], 2); }
+			nearest = std::min(nearest, distance);
+		}
+		sum += std::sqrt(nearest);
+	}
+
+	return references.empty() ? 0.0 : sum / (references.size() / dimension);
+}
+
+//	the optimizers other than unsga come from the registry, their generations are not observed, so their times are averaged over
+//	the generations asked, the evaluations are counted at the problem for all of them, false if the problem or the algorithm is
+//	unknown, or the hypervolume falls below the minimum or the distance exceeds the maximum
+bool run(const std::string& algorithm, const std::string& name, size_t dimension, size_t scale, size_t population, size_t generation,
+	double minimum, double maximum)
+{
+	auto problem = Benchmark::create(name, dimension, scale);
+
+	if (!problem)
+	{
+		std::cerr << "unknown problem " << name << std::endl;
+		return false;
+	}
+
+	dimension = problem->dimension();
+	scale = problem->scale();
+	auto&& references = problem->front(10000);
+
+	auto configuration = std::make_unique<math::Optimizor::Configuration>();
+	(*configuration)["scale"] = scale;
+	(*configuration)["dimension"] = dimension;
+	(*configuration)["constraint"] = size_t(0);
+	(*configuration)["upper"] = problem->upper();
+	(*configuration)["lower"] = problem->lower();
+	(*configuration)["integer"] = problem->integer();
+	(*configuration)["cross"] = 0.8;
+	(*configuration)["mutation"] = 0.8;
+	(*configuration)["maximum"] = generation;
+	(*configuration)["division"] = size_t(dimension <= 3 ? 12 : (dimension <= 8 ? 4 : 2));
+	(*configuration)["population"] = population;
+
+	std::atomic<size_t> evaluations = 0;
+	configuration->objective = std::make_unique<Counter>(std::move(problem), evaluations);
+
+	auto recorder = std::make_shared<Recorder>();
+	std::unique_ptr<math::Optimizor> optimizer;
+
+	if (algorithm == "unsga")
+	{
+		auto unsga = std::make_unique<UNSGA>();
+		unsga->attach(recorder);
+		optimizer = std::move(unsga);
+	}
+	else
+	{
+		optimizer = math::Registry::instance().create(algorithm);
+	}
+
+	if (!optimizer)
+	{
+		std::cerr << "unknown algorithm " << algorithm << std::endl;
+		return false;
+	}
+
+	auto begin = std::chrono::steady_clock::now();
+	auto& results = optimizer->optimize(*configuration);
+	double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+	if (algorithm != "unsga")
+	{
+		recorder->generations = generation;
+		recorder->wall = elapsed;
+	}
+
+//	the objectives are normalized by the ideal and nadir of the reference front
+	std::vector<double> lower(dimension, +INFINITY), upper(dimension, -INFINITY);
+	for (size_t i = 0; i < references.size(); ++i)
+	{
+		lower[i % dimension] = std::min(lower[i % dimension], references[i]);
+		upper[i % dimension] = std::max(upper[i % dimension], references[i]);
+	}
+
+	auto normalize = [&](std::vector<double> points)
+		{
+			for (size_t i = 0; i < points.size(); ++i)
+			{
+				double range = upper[i % dimension] - lower[i % dimension];
+				points[i] = range > 0 ? (points[i] - lower[i % dimension]) / range : points[i] - lower[i % dimension];
+			}
+			return points;
+		};
+
+	std::vector<double> points;
+	for (const auto& result : results.results())
+	{
+		points.insert(points.end(), result.get() + scale, result.get() + scale + dimension);
+	}
+
+	auto&& normalized = normalize(points);
+	double hv = hypervolume(dimension, normalized), igd = generational(dimension, normalized, normalize(references));
+	size_t generations = std::max<size_t>(recorder->generations, 1);
+
+	std::printf("%-8s %3zu %7zu %6zu %6zu %12.6f %12.1f %10.6f %10.6f %10.1f\n", name.c_str(), dimension, scale, population, recorder->generations,
+		recorder->wall / generations, evaluations / elapsed, hv, igd, peak());
+	std::fflush(stdout);
+
+	if (hv < minimum || igd > maximum)
+	{
+		std::cerr << name << " ends with a hypervolume of " << hv << " and a distance of " << igd << ", the limits are " << minimum << " and " << maximum << std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+//	unsga benchmark [problem|all] [objectives] [variables] [population] [generations] [--algorithm name] [--plugins directory]
+//	[--hv minimum] [--igd maximum], another algorithm is created by its name from the registry, after discovering the plugins of
+//	the directory if given, the exit status is not zero if a run fails or misses the limits given
+int main(int argc, char** argv)
+{
+	std::string algorithm = "unsga";
+	std::vector<std::string> arguments;
+	double minimum = -INFINITY, maximum = +INFINITY;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		std::string argument = argv[i];
+
+		if (argument == "--algorithm" && i + 1 < argc) { algorithm = argv[++i]; }
+		else if (argument == "--plugins" && i + 1 < argc)
+		{
+			if (!math::Registry::instance().discover(argv[++i])) { std::cerr << "no plugins in " << argv[i] << std::endl; return 1; }
+		}
+		else if (argument == "--hv" && i + 1 < argc) { minimum = std::stod(argv[++i]); }
+		else if (argument == "--igd" && i + 1 < argc) { maximum = std::stod(argv[++i]); }
+		else { arguments.push_back(argument); }
+	}
+
+	std::string name = arguments.size() > 0 ? arguments[0] : "all";
+	size_t dimension = arguments.size() > 1 ? std::stoul(arguments[1]) : 0;
+	size_t scale = arguments.size() > 2 ? std::stoul(arguments[2]) : 0;
+	size_t population = arguments.size() > 3 ? std::stoul(arguments[3]) : 100;
+	size_t generation = arguments.size() > 4 ? std::stoul(arguments[4]) : 100;
+
+	std::printf("%-8s %3s %7s %6s %6s %12s %12s %10s %10s %10s\n",
+		"problem", "M", "n", "pop", "gens", "s/gen", "evals/s", "HV", "IGD", "RSS(MB)");
+
+	if (name != "all")
+	{
+		return run(algorithm, name, dimension ? dimension : 2, scale ? scale : 30, population, generation, minimum, maximum) ? 0 : 1;
+	}
+
+//	the suite with the usual sizes, the objectives and the variables can be overridden for all of them
+	bool status = true;
+	for (size_t i = 1; i <= 6; ++i) { status = run(algorithm, "zdt" + std::to_string(i), 2, scale ? scale : (i == 4 || i == 6 ? 10 : 30), population, generation, minimum, maximum) && status; }
+	for (size_t i = 1; i <= 7; ++i) { status = run(algorithm, "dtlz" + std::to_string(i), dimension ? dimension : 3, scale ? scale : (i == 1 ? 7 : (i == 7 ? 22 : 12)), population, generation, minimum, maximum) && status; }
+	for (size_t i = 1; i <= 9; ++i) { status = run(algorithm, "wfg" + std::to_string(i), dimension ? dimension : 3, scale ? scale : 24, population, generation, minimum, maximum) && status; }
+	for (size_t i = 1; i <= 9; ++i) { status = run(algorithm, "lsmop" + std::to_string(i), dimension ? dimension : 3, scale ? scale : 300, population, generation, minimum, maximum) && status; }
+	for (size_t i = 1; i <= 8; ++i) { status = run(algorithm, "smop" + std::to_string(i), dimension ? dimension : 2, scale ? scale : 1000, population, generation, minimum, maximum) && status; }
+
+	return status ? 0 : 1;
+}
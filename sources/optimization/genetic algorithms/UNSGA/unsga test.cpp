@@ -1,6 +1,9 @@
 #include <iostream>
 #include <fstream>
+#include <thread>
+#include <filesystem>
 #include "unsga.h"
+#include "../problems.h"
 
 class Objective : public math::Optimizor::Objective
 {
@@ -31,8 +34,543 @@ public:
 	}
 };
 
-int main()
+//	crashes below a third of the range, hangs above it, and evaluates in between
+class Faulty : public Objective
 {
+public:
+	virtual void operator() (const double * decisions, double * objectives, double * voilation)
+	{
+		decisions[0] < -1.0 / 3 ? std::abort() : void();
+		decisions[0] > 1.0 / 3 ? std::this_thread::sleep_for(std::chrono::seconds(5)) : void();
+
+		Objective::operator()(decisions, objectives, voilation);
+	}
+};
+
+//	the failed evaluations come back as nan, are counted, and the scratch directories go with the pool
+bool pool()
+{
+	Faulty objective;
+	auto scratch = std::filesystem::temp_directory_path() / ("unsga.pool." + std::to_string(::getpid()));
+
+	std::vector<double> decisions{ -0.9, 0.0, 0.0, 0.0, 0.9, 0.0 }, objectives(6);
+	std::vector<const double*> rows{ decisions.data(), decisions.data() + 2, decisions.data() + 4 };
+	std::vector<double*> results{ objectives.data(), objectives.data() + 2, objectives.data() + 4 };
+	std::vector<double*> voilations(3, nullptr);
+
+	{
+		Evolutionary::Pool pool(&objective, 2, 2, 0, 2, 0.5, scratch.string());
+		pool(3, rows.data(), results.data(), voilations.data());
+
+		if (!Evolutionary::Pool::failed(2, results[0]) || Evolutionary::Pool::failed(2, results[1]) || !Evolutionary::Pool::failed(2, results[2])) { return false; }
+		if (pool.failures() < 2 || !std::filesystem::exists(scratch)) { return false; }
+	}
+
+	return !std::filesystem::exists(scratch);
+}
+
+//	an individual without constraints, of the objectives only unless a scale is given, the library is not linked into the plugin test
+struct Point
+{
+	std::vector<double> values;
+	double *decisions, *objectives, *voilations;
+
+	Point(size_t dimension, size_t scale = 0) : values(scale + dimension), decisions(values.data()), objectives(values.data() + scale),
+		voilations(values.data() + scale + dimension)
+	{
+	}
+};
+
+//	the ranks of a full non dominated sort, peeling the members dominated by none of the rest
+std::map<Point*, size_t> sort(const std::list<Point*>& population, size_t dimension)
+{
+	std::map<Point*, size_t> ranks;
+	std::list<Point*> rest = population;
+
+	for (size_t rank = 0; !rest.empty(); ++rank)
+	{
+		std::list<Point*> front;
+
+		for (auto& individual : rest)
+		{
+			bool dominated = std::any_of(rest.begin(), rest.end(), [individual, dimension](const Point* other)
+				{ return Evolutionary::dominate(dimension, 0, other->objectives, individual->objectives) == 1; });
+			dominated ? void() : front.push_back(individual);
+		}
+
+		for (auto& individual : front) { ranks[individual] = rank; rest.remove(individual); }
+	}
+
+	return ranks;
+}
+
+//	the persistent layers against a full sort after the inserts, the erases and the changes in place picked up by the synchronization
+bool layers()
+{
+	const size_t dimension = 3, size = 200;
+	std::mt19937_64 generator(7);
+	std::uniform_int_distribution<int> grid(0, 9);
+
+	std::vector<std::unique_ptr<Point>> storage;
+	auto draw = [&]()
+		{
+			auto& individual = storage.emplace_back(std::make_unique<Point>(dimension));
+			for (size_t i = 0; i < dimension; ++i) { individual->objectives[i] = grid(generator); }
+			return individual.get();
+		};
+
+	std::list<Point*> population;
+	Evolutionary::Layers<Point> layers(dimension, 0);
+
+	auto agree = [&]()
+		{
+			auto&& ranks = sort(population, dimension);
+			return std::all_of(population.begin(), population.end(), [&](Point* individual) { return layers.rank(individual) == ranks[individual]; });
+		};
+
+	for (size_t i = 0; i < size; ++i)
+	{
+		population.push_back(draw());
+		layers.insert(population.back());
+	}
+
+	if (!agree()) { return false; }
+
+	for (size_t round = 0; round < 20; ++round)
+	{
+	//	a few members leave and as many come in
+		for (size_t i = 0; i < 5; ++i)
+		{
+			auto leaving = std::next(population.begin(), std::uniform_int_distribution<size_t>(0, population.size() - 1)(generator));
+			layers.erase(*leaving);
+			population.erase(leaving);
+
+			population.push_back(draw());
+			layers.insert(population.back());
+		}
+
+		if (!agree()) { return false; }
+
+	//	a few members are overwritten in place, as the memetic stage does
+		for (size_t i = 0; i < 5; ++i)
+		{
+			auto changed = *std::next(population.begin(), std::uniform_int_distribution<size_t>(0, population.size() - 1)(generator));
+			for (size_t j = 0; j < dimension; ++j) { changed->objectives[j] = grid(generator); }
+		}
+
+		layers.synchronize(population);
+		if (!agree()) { return false; }
+	}
+
+	return true;
+}
+
+//	the exact contributions of a 3 objective front against the hypervolume lost by removing each point, and the pruning to the capacity,
+//	the corners of the simplex make the normalization the identity
+bool archive()
+{
+	const size_t count = 60;
+	std::mt19937_64 generator(11);
+	std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+	std::vector<double> points = { 1, 0, 0, 0, 1, 0, 0, 0, 1 };
+	while (points.size() < 3 * count)
+	{
+		double x = uniform(generator), y = uniform(generator) * (1 - x);
+		points.insert(points.end(), { x, y, 1 - x - y });
+	}
+
+	Evolutionary::Archive archive(0, 3, 0, count);
+	for (size_t i = 0; i < count; ++i) { archive.insert(nullptr, &points[3 * i], nullptr); }
+
+	auto&& contributions = archive.contributions();
+	if (archive.members().size() != count) { return false; }
+
+	const double reference[3] = { 1.1, 1.1, 1.1 };
+	double whole = Evolutionary::hypervolume(3, points, reference);
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		std::vector<double> others(points);
+		others.erase(others.begin() + 3 * i, others.begin() + 3 * i + 3);
+
+		if (std::abs(whole - Evolutionary::hypervolume(3, others, reference) - contributions[i]) > 1e-12) { return false; }
+	}
+
+//	the offsprings may overflow the archive until the end of the generation
+	Evolutionary::Archive bounded(0, 3, 0, count / 2);
+	for (size_t i = 0; i < count; ++i) { bounded.insert(nullptr, &points[3 * i], nullptr); }
+	if (bounded.members().size() != count) { return false; }
+
+	bounded.prune();
+	return bounded.members().size() == count / 2;
+}
+
+//	the hypervolume updated by the points inserted and removed against the full recursion over the generations of a shrinking 3 objective front,
+//	and the stagnation counted once the front stops changing
+bool monitor()
+{
+	const size_t count = 40, dimension = 3;
+	std::mt19937_64 generator(13);
+	std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+	auto draw = [&](double radius, double* point)
+		{
+			double x = uniform(generator), y = uniform(generator) * (1 - x);
+			point[0] = radius * x, point[1] = radius * y, point[2] = radius * (1 - x - y);
+		};
+
+	std::vector<double> front(count * dimension);
+	for (size_t i = 0; i < count; ++i) { draw(1.0, &front[i * dimension]); }
+
+	Evolutionary::Monitor monitor(dimension, 4, 3, 1e-9);
+	std::vector<double> lower(dimension, +INFINITY), upper(dimension, -INFINITY);
+
+	for (size_t generation = 0; generation < 30; ++generation)
+	{
+	//	a few points move towards the origin, every tenth generation most of them
+		size_t moved = generation % 10 == 9 ? count * 3 / 4 : 3;
+		for (size_t k = 0; generation && k < moved; ++k)
+		{
+			draw(1.0 - 0.01 * generation, &front[std::uniform_int_distribution<size_t>(0, count - 1)(generator) * dimension]);
+		}
+
+		std::list<const double*> rows;
+		for (size_t i = 0; i < count; ++i) { rows.push_back(&front[i * dimension]); }
+
+		if (monitor.update(rows)) { return false; }
+
+	//	the bounds of the first front normalize every later one
+		for (size_t j = 0; !generation && j < front.size(); ++j)
+		{
+			lower[j % dimension] = std::min(lower[j % dimension], front[j]);
+			upper[j % dimension] = std::max(upper[j % dimension], front[j]);
+		}
+
+		std::vector<double> normalized(front.size());
+		for (size_t j = 0; j < front.size(); ++j) { normalized[j] = (front[j] - lower[j % dimension]) / (upper[j % dimension] - lower[j % dimension]); }
+
+		const double reference[3] = { 1.1, 1.1, 1.1 };
+		double whole = Evolutionary::hypervolume(dimension, Evolutionary::nondominated(dimension, normalized), reference);
+		if (std::abs(monitor.history().back().hypervolume - whole) > 1e-9 * whole) { return false; }
+	}
+
+//	the unchanged front stagnates for the patience of three generations
+	std::list<const double*> rows;
+	for (size_t i = 0; i < count; ++i) { rows.push_back(&front[i * dimension]); }
+
+	return !monitor.update(rows) && !monitor.update(rows) && monitor.update(rows);
+}
+
+//	counts its evaluations, and fails on the decisions above 10
+class Counted : public math::Optimizor::Objective
+{
+public:
+	size_t evaluations = 0;
+
+	virtual void operator() (const double * decisions, double * objectives, double *)
+	{
+		evaluations++;
+		objectives[0] = decisions[0] > 10 ? std::numeric_limits<double>::quiet_NaN() : decisions[0] * decisions[0];
+	}
+};
+
+//	the hits, the keys of the signed zeros and of the rounded decisions, the failures evaluated again, and the least recently used
+//	entries evicted from the shards while the one used the most recently stays
+bool cache()
+{
+	Counted objective;
+	double objectives[1], voilations[1];
+
+	auto evaluate = [&](Evolutionary::Cache& cache, double decision)
+		{
+			size_t before = objective.evaluations;
+			cache(&decision, objectives, voilations);
+			return objective.evaluations - before;
+		};
+
+	Evolutionary::Cache exact(&objective, 1, 1, 0, 32);
+	if (evaluate(exact, 0.5) != 1 || evaluate(exact, 0.5) != 0 || exact.hits() != 1 || objectives[0] != 0.25) { return false; }
+	if (evaluate(exact, 0.0) != 1 || evaluate(exact, -0.0) != 0) { return false; }
+	if (evaluate(exact, 11.0) != 1 || evaluate(exact, 11.0) != 1) { return false; }
+
+	Evolutionary::Cache rounded(&objective, 1, 1, 0, 32, 0.1);
+	if (evaluate(rounded, 0.31) != 1 || evaluate(rounded, 0.29) != 0 || evaluate(rounded, 0.36) != 1) { return false; }
+	if (evaluate(rounded, -0.04) != 1 || evaluate(rounded, 0.04) != 0) { return false; }
+
+//	two entries a shard, the first key is used after every insert, the second never again
+	Evolutionary::Cache bounded(&objective, 1, 1, 0, 32);
+	evaluate(bounded, 9.5);
+	evaluate(bounded, -9.5);
+
+	for (size_t i = 0; i < 300; ++i)
+	{
+		evaluate(bounded, double(i) / 64);
+		if (evaluate(bounded, 9.5)) { return false; }
+	}
+
+	return evaluate(bounded, -9.5) == 1;
+}
+
+//	the text and the two binary modes read back to the values written, the binary ones column after column past a tile,
+//	and a path that cannot be opened is reported
+bool writer()
+{
+	const size_t scale = 11, dimension = 2, constraint = 1, count = 5, columns = scale + dimension + constraint;
+
+	std::mt19937_64 generator(3);
+	std::uniform_real_distribution<double> uniform(-1e3, 1e3);
+	std::vector<std::vector<double>> values(count, std::vector<double>(columns));
+	std::vector<Evolutionary::Row> rows;
+
+	for (auto& row : values)
+	{
+		std::generate(row.begin(), row.end(), [&]() { return uniform(generator); });
+		rows.push_back({ row.data(), row.data() + scale, row.data() + scale + dimension });
+	}
+
+	auto path = (std::filesystem::temp_directory_path() / ("unsga.writer." + std::to_string(::getpid()))).string();
+	Evolutionary::Writer writer(scale, dimension, constraint);
+
+	auto text = [&]()
+		{
+			std::ifstream file(path);
+			std::string line;
+
+			for (size_t r = 0; r < count; ++r)
+			{
+				if (!std::getline(file, line)) { return false; }
+
+				std::istringstream stream(line);
+				for (size_t c = 0; c < columns; ++c)
+				{
+					std::string field;
+					if (!std::getline(stream, field, '\t') || std::stod(field) != values[r][c]) { return false; }
+				}
+			}
+
+			return !std::getline(file, line);
+		};
+
+	auto binary = [&]()
+		{
+			std::ifstream file(path, std::ios::binary);
+			char magic[8];
+			uint64_t header[4];
+			std::vector<double> blocks(columns * count);
+
+			file.read(magic, sizeof(magic));
+			file.read(reinterpret_cast<char*>(header), sizeof(header));
+			file.read(reinterpret_cast<char*>(blocks.data()), blocks.size() * sizeof(double));
+
+			if (!file || file.peek() != EOF || std::memcmp(magic, "EVOLCOLS", 8)) { return false; }
+			if (header[0] != count || header[1] != scale || header[2] != dimension || header[3] != constraint) { return false; }
+
+			for (size_t r = 0; r < count; ++r)
+			{
+				for (size_t c = 0; c < columns; ++c)
+				{
+					if (blocks[c * count + r] != values[r][c]) { return false; }
+				}
+			}
+
+			return true;
+		};
+
+	bool status = writer.write(path.c_str(), 't', rows) && text();
+	status = status && writer.write(path.c_str(), 'b', rows) && binary();
+	status = status && writer.write(path.c_str(), 'm', rows) && binary();
+	std::filesystem::remove(path);
+
+	return status && !writer.write((path + "/missing/results").c_str(), 'b', rows);
+}
+
+//	counts the evaluations of the problem it wraps
+class Tally : public math::Optimizor::Objective
+{
+public:
+	std::unique_ptr<math::Optimizor::Objective> problem;
+	size_t evaluations = 0;
+
+	virtual void operator() (const double * decisions, double * objectives, double * voilations)
+	{
+		evaluations++;
+		(*problem)(decisions, objectives, voilations);
+	}
+};
+
+//	the local search of a zdt1 front spends the budget of each search and reports it, and leaves every member as it was or better
+//	by the scalarization along the direction nearest to it, with its objectives those of its decisions
+bool memetic()
+{
+	const size_t scale = 10, dimension = 2, size = 30, count = 3, budget = 20, division = 10;
+
+	Tally objective;
+	objective.problem = Benchmark::create("zdt1", dimension, scale);
+
+	std::vector<double> upper(scale, 1.0), lower(scale, 0.0), integer(scale, 0.0);
+	std::mt19937_64 generator(11);
+	std::uniform_real_distribution<double> uniform(0, 1);
+
+	std::list<Point> points;
+	std::list<Point*> front;
+
+	for (size_t p = 0; p < size; ++p)
+	{
+		auto& point = points.emplace_back(dimension, scale);
+		std::generate(point.decisions, point.decisions + scale, [&]() { return uniform(generator); });
+		(*objective.problem)(point.decisions, point.objectives, point.voilations);
+		front.push_back(&point);
+	}
+
+//	the penalty boundary intersection of the search, normalized by the front before it
+	std::vector<double> ideal(dimension, +INFINITY), range(dimension, -INFINITY), directions = Evolutionary::simplex(dimension, division);
+	for (const auto& point : points)
+	{
+		for (size_t i = 0; i < dimension; ++i)
+		{
+			ideal[i] = std::min(ideal[i], point.objectives[i]);
+			range[i] = std::max(range[i], point.objectives[i]);
+		}
+	}
+
+	for (size_t i = 0; i < dimension; ++i) { range[i] = std::max(range[i] - ideal[i], 1e-10); }
+	for (size_t k = 0; k < directions.size(); k += dimension)
+	{
+		double norm = std::hypot(directions[k], directions[k + 1]);
+		directions[k] /= norm;
+		directions[k + 1] /= norm;
+	}
+
+	auto distance = [&](const double* objectives, size_t k)
+		{
+			double along = 0, norm = 0;
+			for (size_t i = 0; i < dimension; ++i) { along += (objectives[i] - ideal[i]) / range[i] * directions[k + i]; }
+			for (size_t i = 0; i < dimension; ++i) { norm += std::pow((objectives[i] - ideal[i]) / range[i] - along * directions[k + i], 2); }
+			return std::make_pair(along, std::sqrt(norm));
+		};
+
+//	the direction of a member is the nearest one to its objectives before the search
+	std::vector<size_t> nearest;
+	std::vector<double> before;
+
+	for (const auto& point : points)
+	{
+		size_t best = 0;
+		for (size_t k = 0; k < directions.size(); k += dimension)
+		{
+			best = distance(point.objectives, k).second < distance(point.objectives, best).second ? k : best;
+		}
+
+		auto [along, norm] = distance(point.objectives, best);
+		nearest.push_back(best);
+		before.push_back(along + 5.0 * norm);
+	}
+
+	Evolutionary::Memetic<Point> search(&objective, scale, dimension, 0, count, budget, division, upper.data(), lower.data(), integer.data(), 13);
+	size_t evaluations = search.improve(front);
+
+	if (evaluations != count * budget || objective.evaluations != evaluations) { return false; }
+
+	size_t improved = 0, p = 0;
+	for (const auto& point : points)
+	{
+		std::vector<double> objectives(dimension);
+		(*objective.problem)(point.decisions, objectives.data(), nullptr);
+
+		if (!std::equal(objectives.begin(), objectives.end(), point.objectives)) { return false; }
+
+		auto [along, norm] = distance(point.objectives, nearest[p]);
+		if (along + 5.0 * norm > before[p]) { return false; }
+
+		improved += along + 5.0 * norm < before[p++];
+	}
+
+	return improved > 0 && improved <= count;
+}
+
+#ifdef STATIC_OPTIMIZOR
+//	a run stopped at the fifth of ten generations and resumed from its snapshot ends as the uninterrupted one bit for bit,
+//	with the archive, the surrogate and the memetic stage restored too, and a snapshot of a damaged length is not read
+bool resume()
+{
+	auto path = (std::filesystem::temp_directory_path() / ("unsga.resume." + std::to_string(::getpid()))).string();
+
+	auto configure = [&path](size_t maximum, bool checkpoint)
+		{
+			math::Optimizor::Configuration configuration;
+			configuration.objective = std::make_unique<Objective>();
+
+			configuration["scale"] = size_t(2);
+			configuration["dimension"] = size_t(2);
+			configuration["upper"] = std::vector<double>{ 1.0, 1.0 };
+			configuration["lower"] = std::vector<double>{ -1.0, -1.0 };
+
+			configuration["cross"] = 0.8;
+			configuration["mutation"] = 0.8;
+			configuration["division"] = size_t(10);
+			configuration["population"] = size_t(40);
+			configuration["maximum"] = maximum;
+			configuration["seed"] = size_t(5);
+
+			configuration["archive"] = size_t(30);
+			configuration["surrogate"] = size_t(60);
+			configuration["memetic"] = size_t(2);
+			configuration["budget"] = size_t(20);
+
+			checkpoint ? void(configuration["checkpoint"] = path) : void();
+			configuration["interval"] = size_t(5);
+			return configuration;
+		};
+
+	auto same = [](const std::list<std::shared_ptr<const double[]>>& lhs, const std::list<std::shared_ptr<const double[]>>& rhs)
+		{
+			return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin(), [](const auto& lhs, const auto& rhs)
+				{ return !std::memcmp(lhs.get(), rhs.get(), 4 * sizeof(double)); });
+		};
+
+	auto whole = configure(10, false), first = configure(5, true), second = configure(10, false);
+
+	UNSGA uninterrupted, stopped, resumed;
+	auto&& expected = static_cast<math::Optimizor&>(uninterrupted).optimize(whole).results();
+	static_cast<math::Optimizor&>(stopped).optimize(first);
+	auto&& results = resumed.resume(path.c_str(), second).results();
+
+//	a length field far beyond the size of the file
+	{
+		std::ofstream file(path, std::ios::binary | std::ios::trunc);
+		uint64_t fields[3] = { 1, uint64_t(1) << 62, 0 };
+		file.write("EVOLSNAP", 8);
+		file.write(reinterpret_cast<const char*>(fields), sizeof(fields));
+	}
+
+	bool damaged = Evolutionary::Checkpoint::read(path).empty();
+	std::filesystem::remove(path);
+
+	return !expected.empty() && same(expected, results) && damaged;
+}
+#endif
+
+int main(int argc, char* argv[])
+{
+#ifdef STATIC_OPTIMIZOR
+	register_unsga();
+#else
+//	the shared library is discovered in the directory given, the one it was built in
+	if (argc < 2 || !math::Registry::instance().discover(argv[1])) { return 1; }
+#endif
+
+	if (!layers()) { std::cout << "the persistent layers differ from a full sort" << std::endl; return 1; }
+	if (!archive()) { std::cout << "the contributions of the archive differ from the hypervolumes lost" << std::endl; return 1; }
+	if (!monitor()) { std::cout << "the hypervolume updated differs from the one measured again, or the stagnation" << std::endl; return 1; }
+	if (!cache()) { std::cout << "the cache missed a hit, kept a failure or evicted the wrong entry" << std::endl; return 1; }
+#ifdef STATIC_OPTIMIZOR
+	if (!resume()) { std::cout << "the resumed run differs from the uninterrupted one, or a damaged snapshot was read" << std::endl; return 1; }
+#endif
+	if (!memetic()) { std::cout << "the local search spent another budget or left a member worse" << std::endl; return 1; }
+	if (!writer()) { std::cout << "the results read back differ from the ones written" << std::endl; return 1; }
+	if (!pool()) { std::cout << "the pool kept a failed evaluation or its directories" << std::endl; return 1; }
+
 	std::unique_ptr<math::Optimizor::Configuration> config = std::make_unique<math::Optimizor::Configuration>();
 	config->objective = std::make_unique<Objective>();
 
@@ -50,9 +588,22 @@ int main()
 	(*config)["division"] = size_t(10);
 	(*config)["population"] = size_t(1000);
 
-	std::unique_ptr<math::Optimizor> optimizer = std::make_unique<UNSGA>();
+	std::unique_ptr<math::Optimizor> optimizer = math::Registry::instance().create("unsga");
+	if (!optimizer) { return 1; }
+
 	auto& results = optimizer->optimize(*config);
 	results.write("results.txt", 0);
+
+//	a failure to write is thrown rather than lost
+	try
+	{
+		results.write("missing/results.txt", 'b');
+		return 1;
+	}
+	catch (const std::runtime_error&)
+	{
+	}
+
 	std::cout << "hello" << std::endl;
 	return 0;
 };
@@ -1,9 +1,34 @@
 #include "unsga.h"
 
+#ifdef STATIC_OPTIMIZOR
+REGISTER_OPTIMIZOR(unsga, []() -> void* { return static_cast<math::Optimizor*>(new UNSGA()); })
+#else
 extern "C" EXPORT void* create()
 {
-	return new UNSGA();
+	return static_cast<math::Optimizor*>(new UNSGA());
 }
+#endif
+
+#ifdef COUNT_ALLOCATIONS
+//	the heap blocks of the containers are counted too while a generation is profiled, the array forms end up here as well
+void* operator new(std::size_t size)
+{
+	math::recorders().load(std::memory_order_relaxed) ? void(math::allocations().fetch_add(1, std::memory_order_relaxed)) : void();
+
+	if (auto block = std::malloc(size ? size : 1)) { return block; }
+	throw std::bad_alloc();
+}
+
+void operator delete(void* block) noexcept
+{
+	std::free(block);
+}
+
+void operator delete(void* block, std::size_t) noexcept
+{
+	std::free(block);
+}
+#endif
 
 void UNSGA::evolve(size_t generation)
 {
@@ -11,48 +36,135 @@ void UNSGA::evolve(size_t generation)
 	auto& selector = population_->selector();
 	auto& reproducor = population_->reproducor();
 
+	auto telemetry = telemetry_.empty() ? nullptr : &telemetry_;
+	auto hits = [this]() { return population_->cache() ? population_->cache()->hits() : 0; };
+
     for (size_t i = 0; i < generation; ++i)
     {
+        telemetry ? telemetry->begin(generation_ + 1, hits()) : void();
+
         individuals = reproducor.reproduce(selector.select(individuals));
+        population_->improve(generation_ + 1);
+
+        {
+            ::Evolutionary::Timer timer(telemetry, ::Evolutionary::Phase::archive);
+            archive(individuals);
+        }
+
+        bool status = false;
+
+        {
+            ::Evolutionary::Timer timer(telemetry, ::Evolutionary::Phase::monitor);
+            status = converged(individuals);
+        }
+
+        generation_++;
+
+    //	the snapshot is taken once the generation is complete, the last one is always kept
+        if (checkpoint_ && (generation_ % interval_ == 0 || status))
+        {
+            ::Evolutionary::Timer timer(telemetry, ::Evolutionary::Phase::checkpoint);
+            save(checkpoint_->buffer());
+            checkpoint_->commit();
+        }
+
+        telemetry ? telemetry->end(hits()) : void();
+
+        if (status) { break; }
     }
 }
 
-void UNSGA::write(const char * filepath, char mode)
+void UNSGA::save(::Evolutionary::Snapshot& snapshot) const
 {
-	std::ofstream file(filepath);
+	::Evolutionary::serialize(snapshot, "generation", generation_);
+	population_->save(snapshot);
 
-	auto& individuals = population_->individuals;
-	auto& selector = population_->selector();
+	archive_ ? archive_->save(snapshot, "archive") : void();
+	monitor_ ? monitor_->save(snapshot, "monitor") : void();
+}
 
-	auto&& layers = selector.sort(individuals);
+bool UNSGA::restore(const ::Evolutionary::Snapshot& snapshot)
+{
+	if (!population_->restore(snapshot)) { return false; }
+
+	::Evolutionary::deserialize(snapshot, "generation", generation_);
+
+	archive_ ? archive_->restore(snapshot, "archive") : void();
+	monitor_ ? monitor_->restore(snapshot, "monitor") : void();
+	return true;
+}
+
+void UNSGA::archive(const std::list<Individual*>& individuals)
+{
+	if (!archive_) { return; }
+
+	for (const auto& individual : individuals)
+	{
+		archive_->insert(individual->decisions, individual->objectives, individual->voilations);
+	}
+
+	archive_->prune();
+}
+
+bool UNSGA::converged(const std::list<Individual*>& individuals)
+{
+	if (!monitor_) { return false; }
+
+	auto&& layers = population_->selector().sort(individuals);
+
+	std::list<const double*> front;
 	for (const auto& individual : *layers.begin())
-//	for (const auto& individual : individuals_)
 	{
-		for (size_t i = 0; i < population_->scale; ++i)
-		{
-			file << individual->decisions[i] << "\t";
-		}
+		front.push_back(individual->objectives);
+	}
+
+	return monitor_->update(front);
+}
 
-		for (size_t i = 0; i < population_->dimension; ++i)
+void UNSGA::write(const char * filepath, char mode)
+{
+	std::vector<::Evolutionary::Row> rows;
+
+	if (archive_)
+	{
+		for (const auto& member : archive_->members())
 		{
-			file << individual->objectives[i] << "\t";
+			auto decisions = member.get(), objectives = decisions + population_->scale, voilations = objectives + population_->dimension;
+			rows.push_back({ decisions, objectives, voilations });
 		}
+	}
+	else
+	{
+		auto& individuals = population_->individuals;
+		auto& selector = population_->selector();
 
-		for (size_t i = 0; i < population_->constraint; ++i)
+	//	the layers are kept across the generations, so sorting here only synchronizes them
+		auto&& layers = selector.sort(individuals);
+		for (const auto& individual : *layers.begin())
 		{
-			file << individual->voilations[i] << "\t";
+			rows.push_back({ individual->decisions, individual->objectives, individual->voilations });
 		}
-
-		file << std::endl;
 	}
 
-	file.close();
+	bool status = ::Evolutionary::Writer(population_->scale, population_->dimension, population_->constraint).write(filepath, mode, rows);
+	if (!status) { throw std::runtime_error(std::string("the results could not be written to ") + filepath); }
 }
 
 std::list<std::shared_ptr<const double[]>> UNSGA::results()
 {
 	elites_.clear();
 
+	if (archive_)
+	{
+	//	the aliasing pointers keep the archived members alive
+		for (const auto& member : archive_->members())
+		{
+			elites_.emplace_back(std::shared_ptr<const double[]>(member, member.get()));
+		}
+
+		return elites_;
+	}
+
 	auto& individuals = population_->individuals;
 	auto& selector = population_->selector();
 
@@ -67,9 +179,70 @@ std::list<std::shared_ptr<const double[]>> UNSGA::results()
 }
 
 
+//	the options of the selection and the variation are needed besides the problem
+std::shared_ptr<const ::Evolutionary::Settings> compile(const math::Optimizor::Configuration& configuration)
+{
+	return ::Evolutionary::Settings::compile(configuration, { "cross", "mutation", "division", "maximum" });
+}
+
+void UNSGA::configure(std::shared_ptr<const ::Evolutionary::Settings> settings)
+{
+	if (!settings->division) { throw std::invalid_argument("the option division must be positive"); }
+
+	population_ = std::make_unique<Population>(settings);
+
+	archive_ = settings->archive ? std::make_unique<::Evolutionary::Archive>(settings->scale, settings->dimension, settings->constraint, settings->archive, 10000, settings->seed + 4) : nullptr;
+
+//	the run stops once the indicators improve less than the tolerance for the given generations
+	monitor_ = settings->stagnation ? std::make_unique<::Evolutionary::Monitor>(settings->dimension, settings->division,
+		settings->stagnation, settings->tolerance) : nullptr;
+
+//	a snapshot is written every interval generations if the path is given
+	checkpoint_ = settings->checkpoint.empty() ? nullptr : std::make_unique<::Evolutionary::Checkpoint>(settings->checkpoint);
+	interval_ = settings->interval;
+	generation_ = 0;
+
+//	the profiles of the generations are traced as json lines if the path is given
+	telemetry_.trace(settings->trace);
+	population_->instrument(telemetry_.empty() ? nullptr : &telemetry_);
+}
+
 math::Optimizor::Result& UNSGA::optimize(math::Optimizor::Configuration& configuration)
 {
-	population_ = std::make_unique<Population>(configuration);
-	evolve(std::get<size_t>(configuration["maximum"]));
+	return optimize(compile(configuration));
+}
+
+math::Optimizor::Result& UNSGA::optimize(std::shared_ptr<const ::Evolutionary::Settings> settings)
+{
+	configure(settings);
+
+	population_->evaluate();
+	archive(population_->individuals);
+
+	evolve(settings->maximum);
+
+	checkpoint_ ? void(checkpoint_->flush()) : void();
 	return *this;
-}
\ No newline at end of file
+}
+
+math::Optimizor::Result& UNSGA::resume(const char* path, math::Optimizor::Configuration& configuration)
+{
+	return resume(path, compile(configuration));
+}
+
+math::Optimizor::Result& UNSGA::resume(const char* path, std::shared_ptr<const ::Evolutionary::Settings> settings)
+{
+	configure(settings);
+
+//	a missing or mismatched snapshot starts a new run
+	if (!restore(::Evolutionary::Checkpoint::read(path)))
+	{
+		population_->evaluate();
+		archive(population_->individuals);
+	}
+
+	evolve(settings->maximum > generation_ ? settings->maximum - generation_ : 0);
+
+	checkpoint_ ? void(checkpoint_->flush()) : void();
+	return *this;
+}
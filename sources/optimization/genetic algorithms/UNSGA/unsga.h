@@ -15,9 +15,18 @@
 #include <numeric>
 #include <utility>
 #include <ranges>
+#include <optional>
 
 #include "../../../math.h"
+#include "../../registry.h"
+#include "../../parallel.h"
 #include "../evolutionary.h"
+#include "../layers.h"
+#include "../cache.h"
+#include "../pool.h"
+#include "../surrogate.h"
+#include "../memetic.h"
+#include "../sampling.h"
 
 #ifndef _MATH_OPTIMIZATION_UNSGA_
 #define _MATH_OPTIMIZATION_UNSGA_
@@ -42,6 +51,10 @@ private:
 //	simplified reference plain
 	std::list<std::tuple<math::pointer<double>, size_t, std::list<Individual*>>> associations_;
 
+//	non dominated layers kept across the generations
+	mutable Evolutionary::Layers<Individual> layers_;
+	Evolutionary::Telemetry* telemetry_;
+
 private:
 	void dispense(size_t needed, std::list<Individual*>& elites, std::list<Individual*>& cirticals);
 
@@ -49,18 +62,33 @@ private:
 	virtual std::pair<std::list<Individual*>, std::list<Individual*>> select(const std::list<Individual*>& population);
 
 public:
-	Reference(const math::Optimizor::Configuration& configuration);
+	void instrument(Evolutionary::Telemetry* telemetry);
+	void save(Evolutionary::Snapshot& snapshot, const std::list<Individual*>& population) const;
+	void restore(const Evolutionary::Snapshot& snapshot, const std::list<Individual*>& population);
+
+public:
+	Reference(const Evolutionary::Settings& settings);
 	virtual ~Reference() {}
 };
 
 class Reproducor : public Evolutionary::Reproducor<Individual>
 {
 private:
-	size_t scale_, dimension_;
+	size_t scale_, dimension_, constraint_, generation_;
 	double cross_, mutation_, threshold_;
-	math::pointer<double> upper_, lower_, integer_;
+//	the bounds shared by the settings
+	const double *upper_, *lower_, *integer_;
 	math::Optimizor::Objective *function_;
 
+//	fractions of the children truly evaluated per generation, the last one holds for the later generations
+	std::vector<double> fractions_;
+	Evolutionary::Surrogate *surrogate_;
+	std::vector<std::unique_ptr<Individual>> candidates_;
+
+//	scratch of the variation operators, reused between the generations
+	std::vector<double> randoms_, weights_;
+	Evolutionary::Telemetry* telemetry_;
+
 private:
 	std::mt19937_64 generator_;
 	std::uniform_real_distribution<double> uniform_;
@@ -70,30 +98,71 @@ private:
 	virtual void cross(const Individual& father, const Individual& mother, Individual& son, Individual& daughter);
 	virtual void mutate(Individual& individua);
 
+	void check(const std::vector<Individual*>& individuals);
+	void cross(const std::vector<const Individual*>& parents, const std::vector<Individual*>& children);
+	void mutate(const std::vector<Individual*>& individuals);
+
+	std::list<Individual*> evaluate(const std::list<Individual*>& individuals);
+	size_t screen(const std::vector<Individual*>& children, const std::list<Individual*>& elites, std::list<Individual*>& ordinaries);
+
 private:
 	virtual std::list<Individual*> reproduce(std::pair<std::list<Individual*>, std::list<Individual*>>&& population);
 
 public:
-	Reproducor(math::Optimizor::Configuration& configuration);
+	void instrument(Evolutionary::Telemetry* telemetry);
+	void save(Evolutionary::Snapshot& snapshot) const;
+	void restore(const Evolutionary::Snapshot& snapshot);
+
+public:
+	Reproducor(const Evolutionary::Settings& settings, math::Optimizor::Objective* objective, Evolutionary::Surrogate* surrogate);
 	virtual ~Reproducor() {}
 };
 
 class Population : public Evolutionary::Population<Individual>
 {
 private:
+//	the compiled configuration, whose bounds the components share
+	std::shared_ptr<const Evolutionary::Settings> settings_;
+//	worker processes evaluating the objective, null if disabled
+	std::unique_ptr<Evolutionary::Pool> pool_;
+//	evaluation cache in front of the objective, null if disabled
+	std::unique_ptr<Evolutionary::Cache> cache_;
+//	kriging model pre-screening the children, null if disabled
+	std::unique_ptr<Evolutionary::Surrogate> surrogate_;
+//	the front of the chain of the objective, the cache, the pool or the objective itself
+	math::Optimizor::Objective *objective_;
 	std::unique_ptr<Reference> selector_;
 	std::unique_ptr<Reproducor> reproducor_;
+//	local search of the first front every interval generations, null if disabled
+	std::unique_ptr<Evolutionary::Memetic<Individual>> memetic_;
+	size_t interval_;
+	Evolutionary::Telemetry* telemetry_;
+
+//	evaluate the given individuals once through the front of the chain
+	void evaluate(const std::list<Individual*>& individuals);
 
 public:
 	virtual Evolutionary::Selector<Individual>& selector();
 	virtual Evolutionary::Reproducor<Individual>& reproducor();
+	const Evolutionary::Cache* cache() const;
+
+//	evaluate the initial individuals, which is skipped when the population is restored from a snapshot
+	void evaluate();
+//	the memetic stage of the generation, if it is due
+	void improve(size_t generation);
+
+//	hand the telemetry to the selector and the reproducor, null to disable it
+	void instrument(Evolutionary::Telemetry* telemetry);
+
+	void save(Evolutionary::Snapshot& snapshot) const;
+	bool restore(const Evolutionary::Snapshot& snapshot);
 
 public:
 	size_t scale, dimension, constraint;
 	std::list<Individual*> individuals;
 
 public:
-	Population(math::Optimizor::Configuration& configuration);
+	Population(std::shared_ptr<const Evolutionary::Settings> settings);
 	virtual ~Population();
 };
 
@@ -102,6 +171,15 @@ class UNSGA : public Evolutionary::Evolutionary
 private:
 	std::unique_ptr<Population> population_;
 	std::list<std::shared_ptr<const double[]>> elites_;
+	size_t interval_;
+
+private:
+	void configure(std::shared_ptr<const ::Evolutionary::Settings> settings);
+	void archive(const std::list<Individual*>& individuals);
+	bool converged(const std::list<Individual*>& individuals);
+
+	void save(::Evolutionary::Snapshot& snapshot) const;
+	bool restore(const ::Evolutionary::Snapshot& snapshot);
 
 protected:
 	virtual void write(const char * filepath, char mode);
@@ -111,6 +189,9 @@ protected:
 	virtual math::Optimizor::Result& optimize(math::Optimizor::Configuration& configuration);
 
 public:
+	virtual math::Optimizor::Result& optimize(std::shared_ptr<const ::Evolutionary::Settings> settings);
+	virtual math::Optimizor::Result& resume(const char* path, math::Optimizor::Configuration& configuration);
+	virtual math::Optimizor::Result& resume(const char* path, std::shared_ptr<const ::Evolutionary::Settings> settings);
 	virtual ~UNSGA() {}
 };
 
@@ -120,5 +201,9 @@ public:
 	#define EXPORT __attribute__((visibility("default")))
 #endif
 
+#ifndef STATIC_OPTIMIZOR
 extern "C" EXPORT void* create();
+#else
+bool register_unsga();
+#endif
 #endif //!_MATH_OPTIMIZATION_UNSGA_
\ No newline at end of file
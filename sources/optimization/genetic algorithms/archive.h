@@ -0,0 +1,288 @@
+#include <list>
+#include <map>
+#include <vector>
+#include <memory>
+#include <random>
+#include <numeric>
+#include <algorithm>
+
+#include "dominance.h"
+#include "checkpoint.h"
+
+#ifndef _math_optimization_evolutionary_archive_
+#define _math_optimization_evolutionary_archive_
+namespace Evolutionary
+{
+//  external archive keeping the non dominated solutions found during the whole evolution,
+//  once the capacity is exceeded, the members contributing the least hypervolume are pruned at the end of the generation
+    class Archive
+    {
+    private:
+        size_t scale_, dimension_, constraint_, capacity_, samples_;
+        std::mt19937_64 generator_;
+
+    //  each member is laid out as the individuals, decisions, objectives and voilations
+        std::list<std::shared_ptr<double[]>> members_;
+
+    private:
+    //  objectives of the members normalized by the ideal and nadir of the archive, the reference point is 1.1 in each axis
+        std::vector<double> normalize() const
+        {
+            std::vector<double> points(members_.size() * dimension_);
+            std::vector<double> lower(dimension_, +INFINITY), upper(dimension_, -INFINITY);
+
+            for (const auto& member : members_)
+            {
+                for (size_t i = 0; i < dimension_; ++i)
+                {
+                    lower[i] = std::min(lower[i], member[scale_ + i]);
+                    upper[i] = std::max(upper[i], member[scale_ + i]);
+                }
+            }
+
+            auto point = points.begin();
+            for (const auto& member : members_)
+            {
+                for (size_t i = 0; i < dimension_; ++i, ++point)
+                {
+                    *point = upper[i] > lower[i] ? (member[scale_ + i] - lower[i]) / (upper[i] - lower[i]) : 0.0;
+                }
+            }
+
+            return points;
+        }
+
+    //  exact sweep along the first objective, O(n log n)
+        std::vector<double> planar(const std::vector<double>& points, double reference) const
+        {
+            size_t count = points.size() / 2;
+            std::vector<size_t> orders(count);
+            std::iota(orders.begin(), orders.end(), 0);
+            std::sort(orders.begin(), orders.end(), [&points](size_t lhs, size_t rhs) { return points[2 * lhs] < points[2 * rhs]; });
+
+            std::vector<double> contributions(count, 0.0);
+            for (size_t i = 0; i < count; ++i)
+            {
+                double right = i + 1 < count ? points[2 * orders[i + 1]] : reference;
+                double top = i > 0 ? points[2 * orders[i - 1] + 1] : reference;
+                contributions[orders[i]] = (right - points[2 * orders[i]]) * (top - points[2 * orders[i] + 1]);
+            }
+
+            return contributions;
+        }
+
+    //  exact sweep along the third objective, the planar front of the swept points is kept ordered by the first objective,
+    //  the exclusive area of a point only changes with its neighbours, so the volume is accumulated lazily,
+    //  the points covered by a front point in the plane are kept as its children, they are not exclusive to it
+        std::vector<double> spatial(const std::vector<double>& points, double reference) const
+        {
+            size_t count = points.size() / 3;
+            std::vector<size_t> orders(count);
+            std::iota(orders.begin(), orders.end(), 0);
+            std::sort(orders.begin(), orders.end(), [&points](size_t lhs, size_t rhs) { return points[3 * lhs + 2] < points[3 * rhs + 2]; });
+
+            std::vector<double> contributions(count, 0.0), areas(count, 0.0), heights(count, 0.0);
+            std::vector<std::vector<size_t>> children(count);
+            std::map<double, size_t> front;
+
+            auto update = [&](size_t index, double height)
+                {
+                    contributions[index] += areas[index] * (height - heights[index]);
+                    heights[index] = height;
+                };
+
+            auto area = [&](std::map<double, size_t>::iterator iter)
+                {
+                    size_t index = iter->second;
+                    double right = std::next(iter) == front.end() ? reference : std::next(iter)->first;
+                    double top = iter == front.begin() ? reference : points[3 * std::prev(iter)->second + 1];
+
+                //  planar hypervolume of the children clipped to the box of the point, swept along the first objective
+                    std::vector<std::pair<double, double>> covered;
+                    for (const auto& child : children[index])
+                    {
+                        double x = points[3 * child], y = points[3 * child + 1];
+                        if (x < right && y < top) { covered.emplace_back(x, y); }
+                    }
+                    std::sort(covered.begin(), covered.end());
+
+                    double lowest = top, shared = 0;
+                    for (const auto& [x, y] : covered)
+                    {
+                        shared += y < lowest ? (right - x) * (lowest - y) : 0.0;
+                        lowest = std::min(lowest, y);
+                    }
+
+                    return (right - iter->first) * (top - points[3 * index + 1]) - shared;
+                };
+
+            for (const auto& index : orders)
+            {
+                double x = points[3 * index], y = points[3 * index + 1], z = points[3 * index + 2];
+
+            //  the points covered by the new one in the plane stop contributing and become its children
+                auto iter = front.lower_bound(x);
+                while (iter != front.end() && points[3 * iter->second + 1] >= y)
+                {
+                    size_t covered = iter->second;
+                    update(covered, z);
+                    areas[covered] = 0;
+
+                    children[index].push_back(covered);
+                    children[index].insert(children[index].end(), children[covered].begin(), children[covered].end());
+                    children[covered].clear();
+
+                    iter = front.erase(iter);
+                }
+
+                heights[index] = z;
+                iter = front.emplace_hint(iter, x, index);
+
+                for (auto neighbour : { iter == front.begin() ? front.end() : std::prev(iter), iter, std::next(iter) })
+                {
+                    if (neighbour == front.end()) { continue; }
+
+                    update(neighbour->second, z);
+                    areas[neighbour->second] = area(neighbour);
+                }
+            }
+
+            for (const auto& [x, index] : front)
+            {
+                update(index, reference);
+            }
+
+            return contributions;
+        }
+
+    //  monte carlo estimation for many objectives, a sample is credited to a point only if it is dominated by the point alone
+        std::vector<double> sampled(const std::vector<double>& points, double reference)
+        {
+            size_t count = points.size() / dimension_;
+            std::vector<double> contributions(count, 0.0), sample(dimension_);
+            std::uniform_real_distribution<double> uniform(0.0, reference);
+
+            for (size_t s = 0; s < samples_; ++s)
+            {
+                std::generate(sample.begin(), sample.end(), [&uniform, this]() { return uniform(generator_); });
+
+                size_t dominators = 0, owner = 0;
+                for (size_t i = 0; i < count && dominators < 2; ++i)
+                {
+                    bool status = std::equal(sample.begin(), sample.end(), points.begin() + i * dimension_,
+                        [](double value, double point) { return point <= value; });
+                    owner = status ? i : owner;
+                    dominators += status;
+                }
+
+                contributions[owner] += dominators == 1 ? 1.0 : 0.0;
+            }
+
+            return contributions;
+        }
+
+    //  the contributions of the normalized members, exact up to 3 objectives and sampled beyond
+        std::vector<double> contribute(const std::vector<double>& points)
+        {
+            const double reference = 1.1;
+            return dimension_ == 2 ? planar(points, reference) : (dimension_ == 3 ? spatial(points, reference) : sampled(points, reference));
+        }
+
+    public:
+    //  the members of the least contributions are dropped until the capacity is met, once all the offsprings of a generation
+    //  are inserted, the exact contributions are computed again after each drop, the sampled ones once for all the drops,
+    //  as a sampling costs the samples times the members and objectives
+        void prune()
+        {
+            while (members_.size() > capacity_)
+            {
+                auto&& contributions = contribute(normalize());
+                size_t excess = dimension_ > 3 ? members_.size() - capacity_ : 1;
+
+                std::vector<size_t> orders(contributions.size());
+                std::iota(orders.begin(), orders.end(), 0);
+                std::partial_sort(orders.begin(), orders.begin() + excess, orders.end(),
+                    [&contributions](size_t lhs, size_t rhs) { return contributions[lhs] < contributions[rhs]; });
+
+                std::vector<bool> dropped(members_.size(), false);
+                for (size_t i = 0; i < excess; ++i) { dropped[orders[i]] = true; }
+
+                size_t index = 0;
+                members_.remove_if([&dropped, &index](const std::shared_ptr<double[]>&) { return dropped[index++]; });
+            }
+        }
+
+    //  the hypervolume contributions of the members by the normalized objectives, with the reference point at 1.1
+        std::vector<double> contributions()
+        {
+            return contribute(normalize());
+        }
+
+    //  return true if the solution enters the archive, the archive may exceed its capacity until it is pruned
+        bool insert(const double* decisions, const double* objectives, const double* voilations)
+        {
+            auto member = std::make_shared<double[]>(scale_ + dimension_ + constraint_);
+            std::copy(decisions, decisions + scale_, member.get());
+            std::copy(objectives, objectives + dimension_, member.get() + scale_);
+            std::copy(voilations, voilations + constraint_, member.get() + scale_ + dimension_);
+
+            const double* values = member.get() + scale_;
+            for (auto iter = members_.begin(); iter != members_.end();)
+            {
+                const double* other = iter->get() + scale_;
+                int status = dominate(dimension_, constraint_, other, values);
+
+                bool same = std::equal(values, values + dimension_ + constraint_, other,
+                    [](double lhs, double rhs) { return std::abs(lhs - rhs) < 1e-10; });
+
+                if (status == 1 || same) { return false; }
+
+                iter = status == -1 ? members_.erase(iter) : std::next(iter);
+            }
+
+            members_.push_back(member);
+            return true;
+        }
+
+        const std::list<std::shared_ptr<double[]>>& members() const
+        {
+            return members_;
+        }
+
+        void save(Snapshot& snapshot, const std::string& name) const
+        {
+            std::vector<double> values;
+            for (const auto& member : members_)
+            {
+                values.insert(values.end(), member.get(), member.get() + scale_ + dimension_ + constraint_);
+            }
+
+            store(snapshot, name + ".members", values);
+            serialize(snapshot, name + ".generator", generator_);
+        }
+
+        void restore(const Snapshot& snapshot, const std::string& name)
+        {
+            auto&& values = load<double>(snapshot, name + ".members");
+            size_t length = scale_ + dimension_ + constraint_;
+
+            members_.clear();
+            for (size_t i = 0; i + length <= values.size(); i += length)
+            {
+                auto member = std::make_shared<double[]>(length);
+                std::copy(values.begin() + i, values.begin() + i + length, member.get());
+                members_.push_back(member);
+            }
+
+            deserialize(snapshot, name + ".generator", generator_);
+        }
+
+    public:
+        Archive(size_t scale, size_t dimension, size_t constraint, size_t capacity, size_t samples = 10000, size_t seed = std::random_device()()) :
+            scale_(scale), dimension_(dimension), constraint_(constraint), capacity_(std::max<size_t>(capacity, 1)), samples_(samples),
+            generator_(seed)
+        {
+        }
+    };
+}
+#endif //! _math_optimization_evolutionary_archive_
@@ -0,0 +1,136 @@
+#include <bit>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+
+#ifndef _math_optimization_evolutionary_bitset_
+#define _math_optimization_evolutionary_bitset_
+namespace Evolutionary
+{
+//  the bits packed in words of 64, the counts are popcounts of the words and the set bits are visited word by word,
+//  so a mask costs a bit per decision and a visit costs the words plus the bits set
+    class Bitset
+    {
+    private:
+        static constexpr size_t width_ = 64;
+
+        size_t size_;
+        std::vector<uint64_t> words_;
+
+    private:
+    //  the bits of the word that lie within the size
+        uint64_t tail(size_t word) const
+        {
+            return (word + 1 == words_.size() && size_ % width_) ? (uint64_t(1) << (size_ % width_)) - 1 : ~uint64_t(0);
+        }
+
+    public:
+        size_t size() const
+        {
+            return size_;
+        }
+
+        size_t words() const
+        {
+            return words_.size();
+        }
+
+        const uint64_t* data() const
+        {
+            return words_.data();
+        }
+
+        uint64_t* data()
+        {
+            return words_.data();
+        }
+
+        bool test(size_t index) const
+        {
+            return (words_[index / width_] >> (index % width_)) & 1;
+        }
+
+        void set(size_t index, bool value = true)
+        {
+            uint64_t bit = uint64_t(1) << (index % width_);
+            words_[index / width_] = value ? (words_[index / width_] | bit) : (words_[index / width_] & ~bit);
+        }
+
+        void flip(size_t index)
+        {
+            words_[index / width_] ^= uint64_t(1) << (index % width_);
+        }
+
+        void reset()
+        {
+            std::fill(words_.begin(), words_.end(), 0);
+        }
+
+        size_t count() const
+        {
+            size_t result = 0;
+            for (auto word : words_) { result += std::popcount(word); }
+            return result;
+        }
+
+    //  the indices of the set bits in ascending order
+        template<typename F>
+        void visit(F&& function) const
+        {
+            for (size_t w = 0; w < words_.size(); ++w)
+            {
+                for (uint64_t word = words_[w]; word; word &= word - 1) { function(w * width_ + std::countr_zero(word)); }
+            }
+        }
+
+    //  the indices of the bits set in the combination of the words of the two sets, the bits past the size are never visited
+        template<typename Operation, typename F>
+        static void visit(const Bitset& lhs, const Bitset& rhs, Operation&& operation, F&& function)
+        {
+            for (size_t w = 0; w < lhs.words_.size(); ++w)
+            {
+                uint64_t word = operation(lhs.words_[w], rhs.words_[w]) & lhs.tail(w);
+                for (; word; word &= word - 1) { function(w * width_ + std::countr_zero(word)); }
+            }
+        }
+
+    //  the number of bits set in the combination of the words of the two sets
+        template<typename Operation>
+        static size_t count(const Bitset& lhs, const Bitset& rhs, Operation&& operation)
+        {
+            size_t result = 0;
+            for (size_t w = 0; w < lhs.words_.size(); ++w) { result += std::popcount(operation(lhs.words_[w], rhs.words_[w]) & lhs.tail(w)); }
+            return result;
+        }
+
+    //  the index of the rank-th bit set in the combination of the words of the two sets, the size if there are not as many
+        template<typename Operation>
+        static size_t select(const Bitset& lhs, const Bitset& rhs, Operation&& operation, size_t rank)
+        {
+            for (size_t w = 0; w < lhs.words_.size(); ++w)
+            {
+                uint64_t word = operation(lhs.words_[w], rhs.words_[w]) & lhs.tail(w);
+                size_t count = std::popcount(word);
+
+                if (rank >= count)
+                {
+                    rank -= count;
+                    continue;
+                }
+
+                for (; rank; --rank) { word &= word - 1; }
+                return w * width_ + std::countr_zero(word);
+            }
+
+            return lhs.size_;
+        }
+
+        bool operator == (const Bitset& other) const = default;
+
+    public:
+        Bitset(size_t size = 0) : size_(size), words_((size + width_ - 1) / width_, 0)
+        {
+        }
+    };
+}
+#endif //! _math_optimization_evolutionary_bitset_
@@ -0,0 +1,196 @@
+#include <list>
+#include <cmath>
+#include <array>
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <cstring>
+#include <algorithm>
+#include <unordered_map>
+
+#include "../optimizor.h"
+
+#ifndef _math_optimization_evolutionary_cache_
+#define _math_optimization_evolutionary_cache_
+namespace Evolutionary
+{
+//  evaluation cache in front of the objective, keyed on the bits of the decision vector,
+//  or on the decisions rounded to the quantum for continuous variables,
+//  the entries are split into shards with their own lock and least recently used list
+    class Cache : public math::Optimizor::Objective
+    {
+    private:
+        struct Entry
+        {
+            size_t hash;
+            std::vector<double> key, values;
+        };
+
+        struct Shard
+        {
+            std::mutex mutex;
+            std::list<Entry> entries;
+            std::unordered_multimap<size_t, std::list<Entry>::iterator> index;
+        };
+
+    private:
+        static constexpr size_t partitions_ = 16;
+
+        size_t scale_, dimension_, constraint_, capacity_;
+        double quantum_;
+        math::Optimizor::Objective* objective_;
+
+        std::array<Shard, partitions_> shards_;
+        std::atomic<size_t> hits_, misses_;
+
+    private:
+    //  the negative zeros, also those of the values rounded to zero, are made positive, as their bits differ
+        std::vector<double> key(const double* decisions) const
+        {
+            std::vector<double> results(decisions, decisions + scale_);
+
+            if (quantum_ > 0)
+            {
+                std::transform(results.begin(), results.end(), results.begin(), [this](double value) { return std::round(value / quantum_); });
+            }
+
+            std::transform(results.begin(), results.end(), results.begin(), [](double value) { return value == 0 ? 0.0 : value; });
+            return results;
+        }
+
+    //  FNV-1a over the bits of the key
+        size_t hash(const std::vector<double>& key) const
+        {
+            size_t result = 14695981039346656037ull;
+            auto bytes = reinterpret_cast<const unsigned char*>(key.data());
+
+            for (size_t i = 0; i < key.size() * sizeof(double); ++i)
+            {
+                result = (result ^ bytes[i]) * 1099511628211ull;
+            }
+
+            return result;
+        }
+
+        std::list<Entry>::iterator find(Shard& shard, size_t hash, const std::vector<double>& key)
+        {
+            auto [begin, end] = shard.index.equal_range(hash);
+            auto iter = std::find_if(begin, end, [&key](const auto& pair)
+                { return !std::memcmp(pair.second->key.data(), key.data(), key.size() * sizeof(double)); });
+
+            return iter == end ? shard.entries.end() : iter->second;
+        }
+
+    //  copy the cached values of the decisions into the outputs, return false on a miss
+        bool lookup(const double* decisions, double* objectives, double* voilations)
+        {
+            auto&& key = this->key(decisions);
+            size_t hash = this->hash(key);
+            auto& shard = shards_[hash % shards_.size()];
+
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            auto entry = find(shard, hash, key);
+
+            if (entry == shard.entries.end())
+            {
+                misses_++;
+                return false;
+            }
+
+            std::copy(entry->values.begin(), entry->values.begin() + dimension_, objectives);
+            std::copy(entry->values.begin() + dimension_, entry->values.end(), voilations);
+            shard.entries.splice(shard.entries.begin(), shard.entries, entry);
+
+            hits_++;
+            return true;
+        }
+
+    //  an evaluation that failed, with not a number in its outputs, is not kept so it runs again at the next request
+        void store(const double* decisions, const double* objectives, const double* voilations)
+        {
+            auto invalid = [](double value) { return std::isnan(value); };
+            if (std::any_of(objectives, objectives + dimension_, invalid) || std::any_of(voilations, voilations + constraint_, invalid)) { return; }
+
+            auto&& key = this->key(decisions);
+            size_t hash = this->hash(key);
+            auto& shard = shards_[hash % shards_.size()];
+
+            std::lock_guard<std::mutex> lock(shard.mutex);
+
+            if (find(shard, hash, key) != shard.entries.end()) { return; }
+
+            std::vector<double> values(objectives, objectives + dimension_);
+            values.insert(values.end(), voilations, voilations + constraint_);
+
+            shard.entries.push_front({ hash, std::move(key), std::move(values) });
+            shard.index.emplace(hash, shard.entries.begin());
+
+            if (shard.entries.size() > capacity_)
+            {
+                auto& last = shard.entries.back();
+                auto [begin, end] = shard.index.equal_range(last.hash);
+                shard.index.erase(std::find_if(begin, end, [&last](const auto& pair) { return &*pair.second == &last; }));
+                shard.entries.pop_back();
+            }
+        }
+
+    public:
+    //  the objective is evaluated out of the lock, so the other threads are not blocked by the expensive model
+        virtual void operator () (const double* decisions, double* objectives, double* voilations)
+        {
+            if (lookup(decisions, objectives, voilations)) { return; }
+
+            (*objective_)(decisions, objectives, voilations);
+            store(decisions, objectives, voilations);
+        }
+
+    //  the misses of a batch are evaluated together, so a parallel objective behind the cache still gets whole batches
+        virtual void operator () (size_t count, const double* const* decisions, double* const* objectives, double* const* voilations)
+        {
+            std::vector<const double*> missed;
+            std::vector<double*> results, violated;
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                if (lookup(decisions[i], objectives[i], voilations[i])) { continue; }
+
+                missed.push_back(decisions[i]);
+                results.push_back(objectives[i]);
+                violated.push_back(voilations[i]);
+            }
+
+            if (missed.empty()) { return; }
+
+            (*objective_)(missed.size(), missed.data(), results.data(), violated.data());
+
+            for (size_t i = 0; i < missed.size(); ++i) { store(missed[i], results[i], violated[i]); }
+        }
+
+    public:
+        size_t hits() const
+        {
+            return hits_;
+        }
+
+        size_t misses() const
+        {
+            return misses_;
+        }
+
+        double rate() const
+        {
+            size_t total = hits_ + misses_;
+            return total ? double(hits_) / total : 0.0;
+        }
+
+    public:
+        Cache(math::Optimizor::Objective* objective, size_t scale, size_t dimension, size_t constraint, size_t capacity, double quantum = 0) :
+            scale_(scale), dimension_(dimension), constraint_(constraint), capacity_(std::max<size_t>(capacity / partitions_, 1)),
+            quantum_(quantum), objective_(objective), hits_(0), misses_(0)
+        {
+        }
+
+        virtual ~Cache() {}
+    };
+}
+#endif //! _math_optimization_evolutionary_cache_
@@ -0,0 +1,221 @@
+#include <map>
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <fstream>
+#include <sstream>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+
+#ifndef _math_optimization_evolutionary_checkpoint_
+#define _math_optimization_evolutionary_checkpoint_
+namespace Evolutionary
+{
+//  snapshot of an evolution as named sections of bytes
+    using Snapshot = std::map<std::string, std::string>;
+
+    template<typename T>
+    void store(Snapshot& snapshot, const std::string& name, const T* values, size_t count)
+    {
+        snapshot[name].assign(reinterpret_cast<const char*>(values), count * sizeof(T));
+    }
+
+    template<typename T>
+    void store(Snapshot& snapshot, const std::string& name, const std::vector<T>& values)
+    {
+        store(snapshot, name, values.data(), values.size());
+    }
+
+    template<typename T>
+    std::vector<T> load(const Snapshot& snapshot, const std::string& name)
+    {
+        auto iter = snapshot.find(name);
+
+        if (iter == snapshot.end()) { return {}; }
+
+        std::vector<T> values(iter->second.size() / sizeof(T));
+        std::memcpy(values.data(), iter->second.data(), values.size() * sizeof(T));
+        return values;
+    }
+
+//  the engines and distributions are kept in their textual form, which restores them exactly
+    template<typename... T>
+    void serialize(Snapshot& snapshot, const std::string& name, const T&... states)
+    {
+        std::ostringstream stream;
+        ((stream << states << ' '), ...);
+        snapshot[name] = stream.str();
+    }
+
+    template<typename... T>
+    bool deserialize(const Snapshot& snapshot, const std::string& name, T&... states)
+    {
+        auto iter = snapshot.find(name);
+
+        if (iter == snapshot.end()) { return false; }
+
+        std::istringstream stream(iter->second);
+        ((stream >> states), ...);
+        return !stream.fail();
+    }
+
+//  periodic snapshots written by a background thread, the evolution fills the front buffer while the back one is written,
+//  the file is replaced by renaming a temporary one, so a crash while writing leaves the previous snapshot intact
+    class Checkpoint
+    {
+    private:
+        static constexpr char magic_[8] = { 'E', 'V', 'O', 'L', 'S', 'N', 'A', 'P' };
+
+        std::string path_;
+        Snapshot front_, back_;
+        bool pending_, stopping_, good_;
+
+        std::mutex mutex_;
+        std::condition_variable condition_;
+        std::thread thread_;
+
+    private:
+        void run()
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+
+            while (true)
+            {
+                condition_.wait(lock, [this]() { return pending_ || stopping_; });
+
+                if (!pending_) { return; }
+
+                lock.unlock();
+                bool status = write(path_, back_);
+                lock.lock();
+
+                good_ = good_ && status;
+                pending_ = false;
+                condition_.notify_all();
+            }
+        }
+
+    public:
+        static bool write(const std::string& path, const Snapshot& snapshot)
+        {
+            std::string temporary = path + ".tmp";
+
+            {
+                std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+
+                auto put = [&file](uint64_t value) { file.write(reinterpret_cast<const char*>(&value), sizeof(value)); };
+
+                file.write(magic_, sizeof(magic_));
+                put(snapshot.size());
+
+                for (const auto& [name, bytes] : snapshot)
+                {
+                    put(name.size());
+                    file.write(name.data(), name.size());
+                    put(bytes.size());
+                    file.write(bytes.data(), bytes.size());
+                }
+
+                if (!file.flush()) { return false; }
+            }
+
+            std::error_code error;
+            std::filesystem::rename(temporary, path, error);
+            return !error;
+        }
+
+    //  return an empty snapshot if the file is missing or damaged, every length is checked against the bytes left
+    //  before anything is allocated, so a damaged length cannot ask for more memory than the file holds
+        static Snapshot read(const std::string& path)
+        {
+            std::error_code error;
+            uint64_t left = std::filesystem::file_size(path, error);
+
+            if (error || left < sizeof(magic_)) { return {}; }
+
+            std::ifstream file(path, std::ios::binary);
+            Snapshot snapshot;
+
+            auto get = [&file, &left]()
+                {
+                    uint64_t value = 0;
+                    left < sizeof(value) ? file.setstate(std::ios::failbit) : void(file.read(reinterpret_cast<char*>(&value), sizeof(value)));
+                    left -= file ? sizeof(value) : 0;
+                    return value;
+                };
+
+            auto text = [&file, &left](uint64_t length)
+                {
+                    std::string result;
+                    if (!file || length > left) { file.setstate(std::ios::failbit); return result; }
+
+                    result.resize(length);
+                    file.read(result.data(), length);
+                    left -= length;
+                    return result;
+                };
+
+            char magic[sizeof(magic_)] = {};
+            file.read(magic, sizeof(magic));
+            left -= sizeof(magic);
+
+            if (!file || std::memcmp(magic, magic_, sizeof(magic_))) { return {}; }
+
+            for (uint64_t count = get(); file && count > 0; --count)
+            {
+                auto name = text(get());
+                auto bytes = text(get());
+
+                file ? void(snapshot.emplace(std::move(name), std::move(bytes))) : void();
+            }
+
+            return file ? snapshot : Snapshot();
+        }
+
+    public:
+        Snapshot& buffer()
+        {
+            return front_;
+        }
+
+    //  hand the filled buffer over to the writer, only waits if the previous snapshot is still being written
+        void commit()
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            condition_.wait(lock, [this]() { return !pending_; });
+
+            front_.swap(back_);
+            pending_ = true;
+            condition_.notify_all();
+        }
+
+    //  wait for the last snapshot to be written, return false if any of them failed
+        bool flush()
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            condition_.wait(lock, [this]() { return !pending_; });
+            return good_;
+        }
+
+    public:
+        Checkpoint(const std::string& path) :
+            path_(path), pending_(false), stopping_(false), good_(true), thread_(&Checkpoint::run, this)
+        {
+        }
+
+        ~Checkpoint()
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                stopping_ = true;
+            }
+
+            condition_.notify_all();
+            thread_.join();
+        }
+    };
+}
+#endif //! _math_optimization_evolutionary_checkpoint_
@@ -0,0 +1,35 @@
+#include <cmath>
+#include <cstddef>
+
+#ifndef _math_optimization_evolutionary_dominance_
+#define _math_optimization_evolutionary_dominance_
+namespace Evolutionary
+{
+    inline int dominate(size_t length, const double* lhs, const double* rhs)
+    /*
+     *  1 indicates lhs dominate rhs
+     *  0 indicates non dominated
+     * -1 indicates rhs domiantes lhs
+     */
+    {
+        size_t counts[3] = { 0, 0, 0 };
+
+        for (size_t i = 0; i < length; ++i)
+        {
+            counts[std::abs(lhs[i] - rhs[i]) < 1e-10 ? 1 : (lhs[i] > rhs[i] ? 0 : 2)]++;
+        }
+
+        return (counts[1] == length) ? 0 : ((!counts[0]) ? 1 : ((!counts[2]) ? -1 : 0));
+    }
+
+//  lhs and rhs are laid out as the individuals, objectives followed by the voilations
+    inline int dominate(size_t dimension, size_t constraint, const double* lhs, const double* rhs)
+    {
+    //  compare the voilations of the constraints first
+    //  by this way, voilations have higher priority
+        int status = dominate(constraint, lhs + dimension, rhs + dimension);
+    //  compare the objectives if no constraints voilation of the two individuals
+        return status != 0 ? status : dominate(dimension, lhs, rhs);
+    }
+}
+#endif //! _math_optimization_evolutionary_dominance_
@@ -3,6 +3,12 @@
 #include <memory>
 
 #include "../optimizor.h"
+#include "archive.h"
+#include "monitor.h"
+#include "checkpoint.h"
+#include "writer.h"
+#include "telemetry.h"
+#include "settings.h"
 
 #ifndef _math_optimization_evolutionary_framework_
 #define _math_optimization_evolutionary_framework_
@@ -51,6 +57,17 @@ namespace Evolutionary
 //   the evolutionary algorithms only involves one specie
     class Evolutionary : public math::Optimizor, public math::Optimizor::Result
     {
+    protected:
+    //  optional external archive of the non dominated solutions found in all the generations
+        std::unique_ptr<Archive> archive_;
+    //  optional quality indicators per generation, the evolution stops early once they stagnate
+        std::unique_ptr<Monitor> monitor_;
+    //  optional snapshots of the whole evolution written in the background, and the generations evolved so far
+        std::unique_ptr<Checkpoint> checkpoint_;
+        size_t generation_ = 0;
+    //  profiles of the generations, only taken while something observes them
+        Telemetry telemetry_;
+
     protected:
         virtual void evolve(size_t generation) = 0;
 
@@ -60,16 +77,34 @@ namespace Evolutionary
         virtual std::list<std::shared_ptr<const double[]>> results() = 0;
        
     public:
+        void attach(std::shared_ptr<Observer> observer)
+        {
+            telemetry_.attach(observer);
+        }
+
+    //  run on the settings compiled beforehand, so the restarts and the islands share them instead of compiling them again
+        virtual Optimizor::Result& optimize(std::shared_ptr<const Settings> settings) = 0;
+
+    //  continue the evolution saved in the snapshot file for the generations left
+        virtual Optimizor::Result& resume(const char* path, Optimizor::Configuration& configuration) = 0;
+        virtual Optimizor::Result& resume(const char* path, std::shared_ptr<const Settings> settings) = 0;
         virtual ~Evolutionary() {}
     };
 
-//  the co-evolutionary algorithm involves multi species, mainly aim at large scale problems
+//  the co-evolutionary algorithm involves multi species, mainly aim at large scale problems,
+//  every specie evolves a group of the decisions while the others are fixed at the context vector
     class Coevolutionary : public math::Optimizor, public math::Optimizor::Result
     {
     protected:
         virtual void coevole(size_t generation) = 0;
 
+        virtual Optimizor::Result& optimize(Optimizor::Configuration& configuration) = 0;
+
+        virtual void write(const char*, char mode) = 0;
+        virtual std::list<std::shared_ptr<const double[]>> results() = 0;
+
     public:
+        virtual Optimizor::Result& optimize(std::shared_ptr<const Settings> settings) = 0;
         virtual ~Coevolutionary() {}
     };
 }
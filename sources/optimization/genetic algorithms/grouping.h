@@ -0,0 +1,221 @@
+#include <list>
+#include <deque>
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <random>
+#include <numeric>
+#include <algorithm>
+#include <functional>
+
+#include "../optimizor.h"
+
+#ifndef _math_optimization_evolutionary_grouping_
+#define _math_optimization_evolutionary_grouping_
+namespace Evolutionary
+{
+//  decomposition of the decisions into groups without interaction, for the cooperative coevolution,
+//  the interactions are found by recursive differential grouping, a set of variables interacts with another set
+//  if moving the first changes the fitness differently once the second is moved, the second set is split in halves
+//  recursively to find the interacting variables in O(n log n) evaluations, the halves of a level are evaluated in one batch
+    class Grouping
+    {
+    public:
+    //  the scalar fitness of the objectives and the voilations, the smaller the better
+        using Fitness = std::function<double(const double* objectives, const double* voilations)>;
+
+    private:
+    //  the number of decisions held by a batch of points
+        static constexpr size_t chunk_ = size_t(1) << 22;
+
+        size_t scale_, dimension_, constraint_;
+        std::vector<double> upper_, lower_, middle_, shift_;
+        math::Optimizor::Objective* objective_;
+        Fitness fitness_;
+
+        size_t evaluations_;
+
+    private:
+    //  the fitness of the points, laid out one after another
+        std::vector<double> evaluate(const std::vector<double>& points)
+        {
+            size_t count = points.size() / scale_;
+            std::vector<double> objectives(count * dimension_), voilations(count * std::max<size_t>(constraint_, 1)), results(count);
+            std::vector<const double*> decisions(count);
+            std::vector<double*> outputs(count), violated(count);
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                decisions[i] = &points[i * scale_];
+                outputs[i] = &objectives[i * dimension_];
+                violated[i] = &voilations[i * std::max<size_t>(constraint_, 1)];
+            }
+
+            (*objective_)(count, decisions.data(), outputs.data(), violated.data());
+            evaluations_ += count;
+
+            for (size_t i = 0; i < count; ++i) { results[i] = fitness_(outputs[i], violated[i]); }
+            return results;
+        }
+
+    //  the bound of the rounding errors of the four fitness values, so only the genuine interactions are kept
+        double threshold(double a, double b, double c, double d) const
+        {
+            double unit = std::numeric_limits<double>::epsilon() / 2, k = std::sqrt(double(scale_)) + 2;
+            return k * unit / (1 - k * unit) * (std::abs(a) + std::abs(b) + std::abs(c) + std::abs(d));
+        }
+
+    //  the variables of the candidates interacting with the set
+        std::vector<size_t> interact(const std::vector<size_t>& set, const std::deque<size_t>& candidates, double base)
+        {
+            std::vector<double> shifted(lower_);
+            for (auto variable : set) { shifted[variable] = shift_[variable]; }
+            double moved = evaluate(shifted)[0];
+
+            std::vector<size_t> results;
+            std::list<std::vector<size_t>> frontier = { std::vector<size_t>(candidates.begin(), candidates.end()) };
+
+            while (!frontier.empty())
+            {
+            //  both points of every subset of the level, the subset moved to the middle without and with the set moved,
+            //  a level is evaluated by batches of bounded memory as the deep levels hold many subsets
+                std::vector<double> fitnesses;
+                size_t batch = std::max<size_t>(chunk_ / (2 * scale_), 1);
+
+                for (auto subset = frontier.begin(); subset != frontier.end();)
+                {
+                    std::vector<double> points;
+                    for (size_t i = 0; i < batch && subset != frontier.end(); ++i, ++subset)
+                    {
+                        for (const auto* origin : { &lower_, &shifted })
+                        {
+                            size_t offset = points.size();
+                            points.insert(points.end(), origin->begin(), origin->end());
+                            for (auto variable : *subset) { points[offset + variable] = middle_[variable]; }
+                        }
+                    }
+
+                    auto&& values = evaluate(points);
+                    fitnesses.insert(fitnesses.end(), values.begin(), values.end());
+                }
+
+                std::list<std::vector<size_t>> next;
+
+                size_t k = 0;
+                for (const auto& subset : frontier)
+                {
+                    double still = fitnesses[k++], both = fitnesses[k++];
+
+                    if (std::abs((base - moved) - (still - both)) <= threshold(base, moved, still, both)) { continue; }
+
+                    if (subset.size() == 1)
+                    {
+                        results.push_back(subset[0]);
+                        continue;
+                    }
+
+                    next.emplace_back(subset.begin(), subset.begin() + subset.size() / 2);
+                    next.emplace_back(subset.begin() + subset.size() / 2, subset.end());
+                }
+
+                frontier = std::move(next);
+            }
+
+            std::sort(results.begin(), results.end());
+            return results;
+        }
+
+    public:
+    //  the non separable groups first, then the separable variables in groups of the size
+        std::vector<std::vector<size_t>> group(size_t size)
+        {
+            std::vector<std::vector<size_t>> groups, separables(1);
+            std::deque<size_t> rest(scale_);
+            std::vector<size_t> set;
+
+            std::iota(rest.begin(), rest.end(), 0);
+            double base = evaluate(lower_)[0];
+
+            set.push_back(rest.front());
+            rest.pop_front();
+
+            while (!set.empty())
+            {
+                auto&& found = rest.empty() ? std::vector<size_t>() : interact(set, rest, base);
+
+                if (!found.empty())
+                {
+                    std::deque<size_t> remains;
+                    std::set_difference(rest.begin(), rest.end(), found.begin(), found.end(), std::back_inserter(remains));
+                    rest = std::move(remains);
+
+                    set.insert(set.end(), found.begin(), found.end());
+                    std::sort(set.begin(), set.end());
+                    continue;
+                }
+
+                if (set.size() > 1)
+                {
+                    groups.push_back(std::move(set));
+                }
+                else
+                {
+                    if (separables.back().size() == size) { separables.emplace_back(); }
+                    separables.back().push_back(set[0]);
+                }
+
+                set.clear();
+
+                if (rest.empty()) { break; }
+
+                set.push_back(rest.front());
+                rest.pop_front();
+            }
+
+            for (auto& separable : separables)
+            {
+                separable.empty() ? void() : groups.push_back(std::move(separable));
+            }
+
+            return groups;
+        }
+
+    //  random groups of the size, redrawn by the caller, when the detection costs too many evaluations
+        std::vector<std::vector<size_t>> shuffle(size_t size, std::mt19937_64& generator) const
+        {
+            std::vector<size_t> variables(scale_);
+            std::iota(variables.begin(), variables.end(), 0);
+            std::shuffle(variables.begin(), variables.end(), generator);
+
+            std::vector<std::vector<size_t>> groups;
+            for (size_t i = 0; i < scale_; i += size)
+            {
+                groups.emplace_back(variables.begin() + i, variables.begin() + std::min(i + size, scale_));
+                std::sort(groups.back().begin(), groups.back().end());
+            }
+
+            return groups;
+        }
+
+        size_t evaluations() const
+        {
+            return evaluations_;
+        }
+
+    public:
+        Grouping(math::Optimizor::Objective* objective, Fitness fitness, size_t scale, size_t dimension, size_t constraint,
+            const double* upper, const double* lower) :
+            scale_(scale), dimension_(dimension), constraint_(constraint), upper_(upper, upper + scale), lower_(lower, lower + scale), middle_(scale),
+            shift_(scale), objective_(objective), fitness_(fitness), evaluations_(0)
+        {
+        //  the set is moved to three quarters of the range rather than to the upper bound,
+        //  so the even functions of the symmetric bounds still show their interactions
+            for (size_t i = 0; i < scale_; ++i)
+            {
+                middle_[i] = (upper_[i] + lower_[i]) / 2;
+                shift_[i] = lower_[i] + 0.75 * (upper_[i] - lower_[i]);
+            }
+        }
+    };
+}
+#endif //! _math_optimization_evolutionary_grouping_
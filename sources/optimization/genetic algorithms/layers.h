@@ -0,0 +1,248 @@
+#include <list>
+#include <vector>
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "evolutionary.h"
+#include "dominance.h"
+#include "checkpoint.h"
+
+#ifndef _math_optimization_evolutionary_layers_
+#define _math_optimization_evolutionary_layers_
+namespace Evolutionary
+{
+//  persistent non dominated layers, individuals are inserted and erased one by one instead of re-sorting the population,
+//  only the layers below the changed one are visited, as the efficient non-domination level update (ENLU) does
+    template<Individual T>
+    class Layers
+    {
+    private:
+        struct Member
+        {
+            T* individual;
+            size_t rank;
+        //  snapshot of the objectives and voilations, the individuals may be overwritten in place by the reproducor
+            std::vector<double> values;
+        };
+
+    private:
+        size_t dimension_, constraint_;
+        std::vector<std::list<Member*>> layers_;
+        std::unordered_map<T*, Member> members_;
+
+    private:
+        bool dominated(const Member& member, const std::list<Member*>& layer) const
+        {
+            return std::any_of(layer.begin(), layer.end(), [this, &member](const Member* other)
+                { return dominate(dimension_, constraint_, other->values.data(), member.values.data()) == 1; });
+        }
+
+        bool changed(const Member& member) const
+        {
+            return !std::equal(member.individual->objectives, member.individual->objectives + dimension_, member.values.begin()) ||
+                !std::equal(member.individual->voilations, member.individual->voilations + constraint_, member.values.begin() + dimension_);
+        }
+
+        void renumber(size_t from)
+        {
+            for (size_t rank = from; rank < layers_.size(); ++rank)
+            {
+                for (auto& member : layers_[rank]) { member->rank = rank; }
+            }
+        }
+
+    public:
+        void insert(T* individual)
+        {
+            auto [iter, status] = members_.try_emplace(individual, Member{ individual, 0, std::vector<double>(dimension_ + constraint_) });
+
+            if (!status) { return; }
+
+            auto& member = iter->second;
+            std::copy(individual->objectives, individual->objectives + dimension_, member.values.begin());
+            std::copy(individual->voilations, individual->voilations + constraint_, member.values.begin() + dimension_);
+
+        //  if a member of a layer dominates the individual, so does a member of every layer above,
+        //  so the first layer without any dominating member is located by the binary search
+            size_t left = 0, right = layers_.size();
+            while (left < right)
+            {
+                size_t middle = (left + right) / 2;
+                dominated(member, layers_[middle]) ? left = middle + 1 : right = middle;
+            }
+
+        //  the members dominated by the incoming ones are pushed to the next layer, layer by layer
+            std::list<Member*> incoming = { &member };
+            for (size_t rank = left; !incoming.empty(); ++rank)
+            {
+                for (auto& member : incoming) { member->rank = rank; }
+
+                if (rank == layers_.size())
+                {
+                    layers_.push_back(std::move(incoming));
+                    break;
+                }
+
+                auto& layer = layers_[rank];
+                std::list<Member*> lower;
+
+                for (auto member = layer.begin(); member != layer.end();)
+                {
+                    bool status = std::any_of(incoming.begin(), incoming.end(), [this, member](const Member* other)
+                        { return dominate(dimension_, constraint_, other->values.data(), (*member)->values.data()) == 1; });
+                    status ? lower.splice(lower.end(), layer, member++) : void(++member);
+                }
+
+            //  the whole layer is dominated, the incoming members form a new layer above it
+                if (layer.empty())
+                {
+                    layer.swap(incoming);
+                    layers_.insert(std::next(layers_.begin(), rank + 1), std::move(lower));
+                    renumber(rank + 1);
+                    break;
+                }
+
+                layer.splice(layer.end(), incoming);
+                incoming.swap(lower);
+            }
+        }
+
+        void erase(T* individual)
+        {
+            auto iter = members_.find(individual);
+
+            if (iter == members_.end()) { return; }
+
+            size_t rank = iter->second.rank;
+            layers_[rank].remove(&iter->second);
+
+        //  only the members dominated by the removed ones could be promoted to the upper layer
+            std::list<Member*> removed = { &iter->second };
+            for (size_t lower = rank + 1; lower < layers_.size() && !removed.empty(); ++lower)
+            {
+                auto& upper = layers_[lower - 1];
+                std::list<Member*> promoted;
+
+                for (auto member = layers_[lower].begin(); member != layers_[lower].end();)
+                {
+                    bool status = std::any_of(removed.begin(), removed.end(), [this, member](const Member* other)
+                        { return dominate(dimension_, constraint_, other->values.data(), (*member)->values.data()) == 1; });
+                    status = status && !dominated(**member, upper);
+                    status ? promoted.splice(promoted.end(), layers_[lower], member++) : void(++member);
+                }
+
+                for (auto& member : promoted) { member->rank = lower - 1; }
+
+                removed.assign(promoted.begin(), promoted.end());
+                upper.splice(upper.end(), promoted);
+            }
+
+            auto empty = std::find_if(layers_.begin(), layers_.end(), [](const std::list<Member*>& layer) { return layer.empty(); });
+            size_t from = std::distance(layers_.begin(), empty);
+            std::erase_if(layers_, [](const std::list<Member*>& layer) { return layer.empty(); });
+            renumber(from);
+
+            members_.erase(iter);
+        }
+
+    //  bring the layers up to date with the population, the individuals left or overwritten are re-inserted
+        void synchronize(const std::list<T*>& population)
+        {
+            std::unordered_set<T*> present(population.begin(), population.end());
+            std::vector<T*> stales;
+
+            //  the layers are visited in order, so the same layers are rebuilt in the same order
+            for (const auto& layer : layers_)
+            {
+                for (const auto& member : layer)
+                {
+                    (!present.count(member->individual) || changed(*member)) ? stales.push_back(member->individual) : void();
+                }
+            }
+
+            for (auto& individual : stales) { erase(individual); }
+            for (auto& individual : population) { insert(individual); }
+        }
+
+        void clear()
+        {
+            layers_.clear();
+            members_.clear();
+        }
+
+    //  the members are saved by their positions in the population, with their snapshots
+        void save(Snapshot& snapshot, const std::string& name, const std::list<T*>& population) const
+        {
+            std::unordered_map<T*, size_t> positions;
+            for (auto& individual : population) { positions.emplace(individual, positions.size()); }
+
+            std::vector<size_t> structures;
+            std::vector<double> values;
+
+            for (const auto& layer : layers_)
+            {
+                structures.push_back(layer.size());
+                for (const auto& member : layer)
+                {
+                    structures.push_back(positions.at(member->individual));
+                    values.insert(values.end(), member->values.begin(), member->values.end());
+                }
+            }
+
+            store(snapshot, name + ".layers", structures);
+            store(snapshot, name + ".values", values);
+        }
+
+        void restore(const Snapshot& snapshot, const std::string& name, const std::list<T*>& population)
+        {
+            std::vector<T*> individuals(population.begin(), population.end());
+            auto&& structures = load<size_t>(snapshot, name + ".layers");
+            auto&& values = load<double>(snapshot, name + ".values");
+
+            clear();
+
+            auto value = values.begin();
+            for (auto iter = structures.begin(); iter != structures.end();)
+            {
+                auto& layer = layers_.emplace_back();
+
+                for (size_t count = *iter++; count > 0; --count, ++iter, value += dimension_ + constraint_)
+                {
+                    auto individual = individuals.at(*iter);
+                    auto& member = members_.try_emplace(individual, Member{ individual, layers_.size() - 1, std::vector<double>(value, value + dimension_ + constraint_) }).first->second;
+                    layer.push_back(&member);
+                }
+            }
+        }
+
+    public:
+        size_t size() const
+        {
+            return layers_.size();
+        }
+
+        size_t rank(T* individual) const
+        {
+            return members_.at(individual).rank;
+        }
+
+        std::list<T*> layer(size_t rank) const
+        {
+            std::list<T*> results;
+            for (const auto& member : layers_[rank]) { results.push_back(member->individual); }
+            return results;
+        }
+
+        std::list<std::list<T*>> fronts() const
+        {
+            std::list<std::list<T*>> results;
+            for (size_t rank = 0; rank < layers_.size(); ++rank) { results.push_back(layer(rank)); }
+            return results.empty() ? std::list<std::list<T*>>{ {} } : results;
+        }
+
+    public:
+        Layers(size_t dimension, size_t constraint) : dimension_(dimension), constraint_(constraint) {}
+    };
+}
+#endif //! _math_optimization_evolutionary_layers_
@@ -0,0 +1,147 @@
+#include <bit>
+#include <random>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+
+#include "bitset.h"
+
+#ifndef _math_optimization_evolutionary_mask_
+#define _math_optimization_evolutionary_mask_
+namespace Evolutionary
+{
+//  the bits of a mask along with the list of its set positions in no particular order, a random set position is drawn
+//  from the list and an unset one by rejection against the bits while at most half are set, a mask costs a bit per decision
+//  and 4 bytes per set one, so a sparse mask stays near the size of its bits
+    class Mask
+    {
+    private:
+        Bitset bits_;
+        std::vector<uint32_t> actives_;
+
+    public:
+        size_t size() const
+        {
+            return bits_.size();
+        }
+
+        size_t count() const
+        {
+            return actives_.size();
+        }
+
+        size_t words() const
+        {
+            return bits_.words();
+        }
+
+        const uint64_t* data() const
+        {
+            return bits_.data();
+        }
+
+        const Bitset& bits() const
+        {
+            return bits_;
+        }
+
+        bool test(size_t index) const
+        {
+            return bits_.test(index);
+        }
+
+    //  the rank-th set position, in no particular order
+        size_t active(size_t rank) const
+        {
+            return actives_[rank];
+        }
+
+    //  a random unset position, the size if there is none, a draw takes two tries at most on average while at most half
+    //  of the bits are set, the rank among the unset bits is located word by word otherwise
+        template<typename Generator>
+        size_t inactive(Generator& generator) const
+        {
+            size_t size = bits_.size(), count = actives_.size();
+            if (count == size) { return size; }
+
+            if (2 * count <= size)
+            {
+                std::uniform_int_distribution<size_t> pick(0, size - 1);
+
+                for (;;)
+                {
+                    size_t index = pick(generator);
+                    if (!bits_.test(index)) { return index; }
+                }
+            }
+
+            size_t rank = std::uniform_int_distribution<size_t>(0, size - count - 1)(generator);
+            return Bitset::select(bits_, bits_, [](uint64_t lhs, uint64_t) { return ~lhs; }, rank);
+        }
+
+    //  a bit is cleared at the cost of finding it among the set positions
+        void set(size_t index, bool value = true)
+        {
+            if (bits_.test(index) == value) { return; }
+
+            bits_.flip(index);
+
+            if (value)
+            {
+                actives_.push_back(uint32_t(index));
+                return;
+            }
+
+            auto position = std::find(actives_.begin(), actives_.end(), uint32_t(index));
+            *position = actives_.back();
+            actives_.pop_back();
+        }
+
+    //  only the set positions are visited, so a reset costs the bits set
+        void reset()
+        {
+            for (auto index : actives_) { bits_.set(index, false); }
+            actives_.clear();
+        }
+
+    //  the bits of the other mask, at the cost of the bits set in both, without any allocation once the list has grown
+        void assign(const Mask& other)
+        {
+            reset();
+            for (auto index : other.actives_) { set(index); }
+        }
+
+    //  the bits packed as the words of a bitset of the same size, the bits past the size are ignored
+        void assign(const uint64_t* words)
+        {
+            reset();
+
+            for (size_t w = 0; w < bits_.words(); ++w)
+            {
+                for (uint64_t word = words[w]; word; word &= word - 1)
+                {
+                    size_t index = w * 64 + std::countr_zero(word);
+                    index < bits_.size() ? set(index) : void();
+                }
+            }
+        }
+
+    //  the indices of the set bits in ascending order
+        template<typename F>
+        void visit(F&& function) const
+        {
+            bits_.visit(std::forward<F>(function));
+        }
+
+        bool operator == (const Mask& other) const
+        {
+            return bits_ == other.bits_;
+        }
+
+    public:
+        Mask(size_t size = 0) : bits_(size)
+        {
+        }
+    };
+}
+#endif //! _math_optimization_evolutionary_mask_
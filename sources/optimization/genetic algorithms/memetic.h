@@ -0,0 +1,256 @@
+#include <list>
+#include <cmath>
+#include <vector>
+#include <random>
+#include <numeric>
+#include <algorithm>
+
+#include "../optimizor.h"
+#include "monitor.h"
+#include "checkpoint.h"
+
+#ifndef _math_optimization_evolutionary_memetic_
+#define _math_optimization_evolutionary_memetic_
+namespace Evolutionary
+{
+//  budgeted local search of the members of the first front, each one along the reference direction nearest to it,
+//  the objectives are normalized by the ideal and nadir of the front and scalarized by the penalty boundary intersection,
+//  a search polls both sides of a few coordinates per step, the searches advance in lockstep and their polls are evaluated
+//  as one batch, so a pool or an objective of its own batch operator runs them in parallel, the default one runs them serially
+    template<typename T>
+    class Memetic
+    {
+    private:
+        struct Search
+        {
+            T* individual;
+            const double* direction;
+            std::vector<double> values;
+            double fitness, penalty, step;
+            size_t cursor, failures, evaluations;
+        };
+
+    private:
+    //  the weight of the distance to the direction, and the coordinates polled per step
+        static constexpr double theta_ = 5.0;
+        static constexpr size_t width_ = 4;
+
+        size_t scale_, dimension_, constraint_, count_, budget_;
+        const double *upper_, *lower_, *integer_;
+        std::vector<double> directions_;
+        std::vector<double> ideal_, range_;
+        math::Optimizor::Objective* objective_;
+        std::mt19937_64 generator_;
+
+    private:
+        double fitness(const double* objectives, const double* direction) const
+        {
+            double along = 0, norm = 0;
+            for (size_t i = 0; i < dimension_; ++i)
+            {
+                along += (objectives[i] - ideal_[i]) / range_[i] * direction[i];
+            }
+
+            for (size_t i = 0; i < dimension_; ++i)
+            {
+                norm += std::pow((objectives[i] - ideal_[i]) / range_[i] - along * direction[i], 2);
+            }
+
+            return along + theta_ * std::sqrt(norm);
+        }
+
+        double penalty(const double* voilations) const
+        {
+            return std::accumulate(voilations, voilations + constraint_, 0.0, [](double sum, double value) { return sum + std::max(value, 0.0); });
+        }
+
+        const double* nearest(const double* objectives) const
+        {
+            const double* result = nullptr;
+            double minimum = +INFINITY;
+
+            for (size_t k = 0; k < directions_.size(); k += dimension_)
+            {
+                double along = 0, norm = 0;
+                for (size_t i = 0; i < dimension_; ++i) { along += (objectives[i] - ideal_[i]) / range_[i] * directions_[k + i]; }
+                for (size_t i = 0; i < dimension_; ++i) { norm += std::pow((objectives[i] - ideal_[i]) / range_[i] - along * directions_[k + i], 2); }
+
+                result = norm < minimum ? &directions_[k] : result;
+                minimum = std::min(norm, minimum);
+            }
+
+            return result;
+        }
+
+    //  at most one member per direction, the best one of it, the directions are drawn at random when there are more than the count
+        std::vector<Search> choose(const std::list<T*>& front)
+        {
+            std::vector<Search> searches;
+
+            for (const auto& individual : front)
+            {
+                auto direction = nearest(individual->objectives);
+                double fitness = this->fitness(individual->objectives, direction), penalty = this->penalty(individual->voilations);
+
+                auto iter = std::find_if(searches.begin(), searches.end(), [direction](const Search& search) { return search.direction == direction; });
+
+                if (iter == searches.end())
+                {
+                    searches.push_back({ individual, direction, {}, fitness, penalty, 0.1, 0, 0, 0 });
+                    continue;
+                }
+
+                bool better = penalty < iter->penalty || (penalty == iter->penalty && fitness < iter->fitness);
+                better ? void(*iter = Search{ individual, direction, {}, fitness, penalty, 0.1, 0, 0, 0 }) : void();
+            }
+
+            std::shuffle(searches.begin(), searches.end(), generator_);
+            searches.resize(std::min(searches.size(), count_));
+
+            for (auto& search : searches)
+            {
+                search.values.assign(search.individual->decisions, search.individual->decisions + scale_);
+                search.values.insert(search.values.end(), search.individual->objectives, search.individual->objectives + dimension_);
+                search.values.insert(search.values.end(), search.individual->voilations, search.individual->voilations + constraint_);
+            }
+
+            return searches;
+        }
+
+    public:
+    //  improve the members of the front in place, return the number of evaluations
+        size_t improve(const std::list<T*>& front)
+        {
+            if (front.empty()) { return 0; }
+
+            ideal_.assign(dimension_, +INFINITY);
+            range_.assign(dimension_, -INFINITY);
+
+            for (const auto& individual : front)
+            {
+                for (size_t i = 0; i < dimension_; ++i)
+                {
+                    ideal_[i] = std::min(ideal_[i], individual->objectives[i]);
+                    range_[i] = std::max(range_[i], individual->objectives[i]);
+                }
+            }
+
+            for (size_t i = 0; i < dimension_; ++i) { range_[i] = std::max(range_[i] - ideal_[i], 1e-10); }
+
+            auto&& searches = choose(front);
+            size_t length = scale_ + dimension_ + constraint_, total = 0;
+
+            std::vector<double> polls;
+            std::vector<Search*> owners;
+            std::vector<const double*> decisions;
+            std::vector<double*> objectives, voilations;
+
+            while (true)
+            {
+                polls.clear();
+                owners.clear();
+
+            //  both sides of the next coordinates of every search still within its budget
+                for (auto& search : searches)
+                {
+                    if (search.evaluations + 2 > budget_ || search.step < 1e-8) { continue; }
+
+                    size_t width = std::min({ width_, scale_, (budget_ - search.evaluations) / 2 });
+                    for (size_t c = 0; c < width; ++c)
+                    {
+                        size_t k = (search.cursor + c) % scale_;
+                        double range = upper_[k] - lower_[k], delta = integer_[k] ? std::max(std::round(search.step * range), 1.0) : search.step * range;
+
+                        for (double sign : { -1.0, 1.0 })
+                        {
+                            size_t offset = polls.size();
+                            polls.insert(polls.end(), search.values.begin(), search.values.end());
+
+                            double value = std::max(std::min(search.values[k] + sign * delta, upper_[k]), lower_[k]);
+                            polls[offset + k] = integer_[k] ? std::round(value) : value;
+                            owners.push_back(&search);
+                        }
+                    }
+
+                    search.cursor = (search.cursor + width) % scale_;
+                    search.failures += width;
+                    search.evaluations += 2 * width;
+                }
+
+                if (owners.empty()) { break; }
+
+                decisions.resize(owners.size());
+                objectives.resize(owners.size());
+                voilations.resize(owners.size());
+
+                for (size_t p = 0; p < owners.size(); ++p)
+                {
+                    decisions[p] = &polls[p * length];
+                    objectives[p] = &polls[p * length + scale_];
+                    voilations[p] = &polls[p * length + scale_ + dimension_];
+                }
+
+                (*objective_)(owners.size(), decisions.data(), objectives.data(), voilations.data());
+                total += owners.size();
+
+            //  every search moves to its best poll if it improves, the step is halved once all the coordinates failed in a row
+                for (size_t p = 0; p < owners.size(); ++p)
+                {
+                    auto& search = *owners[p];
+                    double fitness = this->fitness(objectives[p], search.direction), penalty = this->penalty(voilations[p]);
+
+                    if (penalty < search.penalty || (penalty == search.penalty && fitness < search.fitness))
+                    {
+                        std::copy(&polls[p * length], &polls[(p + 1) * length], search.values.begin());
+                        search.fitness = fitness;
+                        search.penalty = penalty;
+                        search.failures = 0;
+                    }
+                }
+
+                for (auto& search : searches)
+                {
+                    if (search.failures < scale_) { continue; }
+
+                    search.step /= 2;
+                    search.failures = 0;
+                }
+            }
+
+            for (auto& search : searches)
+            {
+                std::copy(search.values.begin(), search.values.begin() + scale_, search.individual->decisions);
+                std::copy(search.values.begin() + scale_, search.values.begin() + scale_ + dimension_, search.individual->objectives);
+                std::copy(search.values.begin() + scale_ + dimension_, search.values.end(), search.individual->voilations);
+            }
+
+            return total;
+        }
+
+        void save(Snapshot& snapshot, const std::string& name) const
+        {
+            serialize(snapshot, name, generator_);
+        }
+
+        void restore(const Snapshot& snapshot, const std::string& name)
+        {
+            deserialize(snapshot, name, generator_);
+        }
+
+    public:
+    //  the directions are the reference points of the division, normalized to unit length, the bounds are borrowed and outlive the search
+        Memetic(math::Optimizor::Objective* objective, size_t scale, size_t dimension, size_t constraint, size_t count, size_t budget,
+            size_t division, const double* upper, const double* lower, const double* integer, size_t seed = std::random_device()()) :
+            scale_(scale), dimension_(dimension), constraint_(constraint), count_(count), budget_(budget),
+            upper_(upper), lower_(lower), integer_(integer),
+            directions_(simplex(dimension, std::max<size_t>(division, 1))), objective_(objective), generator_(seed)
+        {
+            for (size_t k = 0; k < directions_.size(); k += dimension_)
+            {
+                double norm = std::sqrt(std::inner_product(&directions_[k], &directions_[k] + dimension_, &directions_[k], 0.0));
+                std::transform(&directions_[k], &directions_[k] + dimension_, &directions_[k], [norm](double value) { return value / norm; });
+            }
+        }
+    };
+}
+#endif //! _math_optimization_evolutionary_memetic_
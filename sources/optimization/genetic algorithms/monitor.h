@@ -0,0 +1,372 @@
+#include <list>
+#include <vector>
+#include <numeric>
+#include <iterator>
+#include <algorithm>
+#include <cmath>
+
+#include "checkpoint.h"
+
+#ifndef _math_optimization_evolutionary_monitor_
+#define _math_optimization_evolutionary_monitor_
+namespace Evolutionary
+{
+//  the points not dominated by another, of two equal points the first one is kept
+    inline std::vector<double> nondominated(size_t dimension, const std::vector<double>& points)
+    {
+        std::vector<double> results;
+
+        for (size_t j = 0; j < points.size(); j += dimension)
+        {
+            bool dominated = false;
+            for (size_t l = 0; l < points.size() && !dominated; l += dimension)
+            {
+                bool covers = l != j && std::equal(points.begin() + l, points.begin() + l + dimension, points.begin() + j, std::less_equal<double>());
+                bool same = covers && std::equal(points.begin() + l, points.begin() + l + dimension, points.begin() + j);
+                dominated = covers && (!same || l < j);
+            }
+
+            if (!dominated) { results.insert(results.end(), points.begin() + j, points.begin() + j + dimension); }
+        }
+
+        return results;
+    }
+
+    inline double hypervolume(size_t dimension, std::vector<double> points, const double* reference);
+
+//  the volume dominated by the point alone and not by any of the others, the inclusive volume of the point
+//  less the hypervolume of the others limited by it
+    inline double exclusive(size_t dimension, const double* point, const std::vector<double>& others, const double* reference)
+    {
+        double inclusive = 1;
+        for (size_t i = 0; i < dimension; ++i) { inclusive *= reference[i] - point[i]; }
+
+        std::vector<double> limits(others.size());
+        for (size_t j = 0; j < others.size(); ++j) { limits[j] = std::max(point[j % dimension], others[j]); }
+
+        return inclusive - hypervolume(dimension, nondominated(dimension, limits), reference);
+    }
+
+//  hypervolume of the points (minimization) dominated below the reference point, per the WFG algorithm,
+//  the points are sorted by the last objective so that the limit sets lose one dimension
+    inline double hypervolume(size_t dimension, std::vector<double> points, const double* reference)
+    {
+        size_t count = points.size() / dimension;
+
+        if (count == 0) { return 0; }
+
+        std::vector<size_t> orders(count);
+        std::iota(orders.begin(), orders.end(), 0);
+
+        if (dimension == 1)
+        {
+            return reference[0] - *std::min_element(points.begin(), points.end());
+        }
+
+        if (dimension == 2)
+        {
+            std::sort(orders.begin(), orders.end(), [&points](size_t lhs, size_t rhs) { return points[2 * lhs] < points[2 * rhs]; });
+
+            double volume = 0, lowest = reference[1];
+            for (const auto& order : orders)
+            {
+                volume += points[2 * order + 1] < lowest ? (reference[0] - points[2 * order]) * (lowest - points[2 * order + 1]) : 0.0;
+                lowest = std::min(lowest, points[2 * order + 1]);
+            }
+
+            return volume;
+        }
+
+        size_t last = dimension - 1;
+        std::sort(orders.begin(), orders.end(), [&points, dimension, last](size_t lhs, size_t rhs)
+            { return points[dimension * lhs + last] > points[dimension * rhs + last]; });
+
+        double volume = 0;
+        std::vector<double> limits;
+
+        for (size_t k = 0; k < count; ++k)
+        {
+            const double* point = &points[dimension * orders[k]];
+
+            double inclusive = 1;
+            for (size_t i = 0; i < dimension; ++i) { inclusive *= reference[i] - point[i]; }
+
+        //  the points behind share the last objective of the current one once limited by it
+            limits.clear();
+            for (size_t j = k + 1; j < count; ++j)
+            {
+                const double* other = &points[dimension * orders[j]];
+                for (size_t i = 0; i < last; ++i) { limits.push_back(std::max(point[i], other[i])); }
+            }
+
+        //  only the non dominated limited points matter
+            auto fronts = nondominated(last, limits);
+
+            volume += inclusive - (reference[last] - point[last]) * hypervolume(last, std::move(fronts), reference);
+        }
+
+        return volume;
+    }
+
+//  uniformly distributed points on the unit simplex, as the reference plain of UNSGA
+    inline std::vector<double> simplex(size_t dimension, size_t division)
+    {
+        std::vector<double> points, point(dimension, 0.0);
+
+        auto recurse = [&](auto& self, size_t axis, size_t left) -> void
+            {
+                if (axis + 1 == dimension)
+                {
+                    point[axis] = double(left) / division;
+                    points.insert(points.end(), point.begin(), point.end());
+                    return;
+                }
+
+                for (size_t i = 0; i <= left; ++i)
+                {
+                    point[axis] = double(i) / division;
+                    self(self, axis + 1, left - i);
+                }
+            };
+
+        recurse(recurse, 0, division);
+        return points;
+    }
+
+//  quality indicators of the first front per generation, the run is considered converged
+//  once none of them improves more than the tolerance for the given number of generations
+    class Monitor
+    {
+    public:
+        struct Indicators
+        {
+            double hypervolume, distance, spread;
+        };
+
+    private:
+        size_t dimension_, patience_, stagnation_;
+        double tolerance_, volume_;
+
+    //  the hypervolume is measured with the bounds of the first front, so it is comparable between generations,
+    //  the points dominating its reference point are kept to update it by the points inserted and removed
+        std::vector<double> lower_, upper_, references_, points_, dominating_;
+        std::vector<Indicators> history_;
+
+    private:
+        bool dominates(const double* point) const
+        {
+            return std::all_of(point, point + dimension_, [](double value) { return value < 1.1; });
+        }
+
+    //  the exclusive volumes of the points removed are taken off, those of the points inserted are added,
+    //  unless most of the front has changed, then it is measured again
+        double hypervolume(const std::vector<double>& points)
+        {
+            std::vector<double> reference(dimension_, 1.1), remained;
+
+            auto rows = [this](const std::vector<double>& values)
+                {
+                    std::vector<std::vector<double>> results;
+                    for (size_t i = 0; i < values.size(); i += dimension_)
+                    {
+                        dominates(&values[i]) ? void(results.emplace_back(values.begin() + i, values.begin() + i + dimension_)) : void();
+                    }
+
+                    std::sort(results.begin(), results.end());
+                    return results;
+                };
+
+            auto before = rows(dominating_), after = rows(points);
+            std::vector<std::vector<double>> insertions, removals;
+            std::set_difference(after.begin(), after.end(), before.begin(), before.end(), std::back_inserter(insertions));
+            std::set_difference(before.begin(), before.end(), after.begin(), after.end(), std::back_inserter(removals));
+
+            dominating_.clear();
+            for (const auto& row : after) { dominating_.insert(dominating_.end(), row.begin(), row.end()); }
+
+            if (2 * (insertions.size() + removals.size()) > after.size())
+            {
+                return volume_ = Evolutionary::hypervolume(dimension_, dominating_, reference.data());
+            }
+
+            std::vector<std::vector<double>> current;
+            std::set_intersection(before.begin(), before.end(), after.begin(), after.end(), std::back_inserter(current));
+
+            for (const auto& row : removals) { remained.insert(remained.end(), row.begin(), row.end()); }
+            for (const auto& row : current) { remained.insert(remained.end(), row.begin(), row.end()); }
+
+            for (const auto& row : removals)
+            {
+                remained.erase(remained.begin(), remained.begin() + dimension_);
+                volume_ -= exclusive(dimension_, row.data(), remained, reference.data());
+            }
+
+            for (const auto& row : insertions)
+            {
+                volume_ += exclusive(dimension_, row.data(), remained, reference.data());
+                remained.insert(remained.end(), row.begin(), row.end());
+            }
+
+            return volume_;
+        }
+
+        double distance(const double* lhs, const double* rhs) const
+        {
+            double sum = 0;
+            for (size_t i = 0; i < dimension_; ++i) { sum += (lhs[i] - rhs[i]) * (lhs[i] - rhs[i]); }
+            return std::sqrt(sum);
+        }
+
+    //  inverted generational distance from the reference points to the front
+        double generational(const std::vector<double>& points) const
+        {
+            double sum = 0;
+            for (size_t r = 0; r < references_.size(); r += dimension_)
+            {
+                double nearest = +INFINITY;
+                for (size_t p = 0; p < points.size(); p += dimension_)
+                {
+                    nearest = std::min(nearest, distance(&references_[r], &points[p]));
+                }
+                sum += nearest;
+            }
+
+            return sum / (references_.size() / dimension_);
+        }
+
+    //  coefficient of variation of the nearest neighbour distances, 0 for an evenly spread front
+        double spread(const std::vector<double>& points) const
+        {
+            size_t count = points.size() / dimension_;
+
+            if (count < 2) { return 0; }
+
+            std::vector<double> nearests(count, +INFINITY);
+            for (size_t i = 0; i < count; ++i)
+            {
+                for (size_t j = 0; j < count; ++j)
+                {
+                    nearests[i] = i == j ? nearests[i] : std::min(nearests[i], distance(&points[i * dimension_], &points[j * dimension_]));
+                }
+            }
+
+            double mean = std::accumulate(nearests.begin(), nearests.end(), 0.0) / count;
+            double variance = std::accumulate(nearests.begin(), nearests.end(), 0.0, [mean](double sum, double value)
+                { return sum + (value - mean) * (value - mean); }) / count;
+
+            return mean > 0 ? std::sqrt(variance) / mean : 0.0;
+        }
+
+    //  the front between its own ideal and nadir points, as the reference plain normalizes it, so the distance
+    //  to the reference points measures the shape of the front in each generation
+        std::vector<double> normalize(const std::vector<double>& points) const
+        {
+            std::vector<double> ideal(dimension_, +INFINITY), nadir(dimension_, -INFINITY), results(points.size());
+
+            for (size_t j = 0; j < points.size(); ++j)
+            {
+                ideal[j % dimension_] = std::min(ideal[j % dimension_], points[j]);
+                nadir[j % dimension_] = std::max(nadir[j % dimension_], points[j]);
+            }
+
+            for (size_t j = 0; j < points.size(); ++j)
+            {
+                size_t i = j % dimension_;
+                results[j] = nadir[i] > ideal[i] ? (points[j] - ideal[i]) / (nadir[i] - ideal[i]) : 0.0;
+            }
+
+            return results;
+        }
+
+    public:
+    //  return true if the run has stagnated
+        bool update(const std::list<const double*>& front)
+        {
+            if (lower_.empty())
+            {
+                lower_.assign(dimension_, +INFINITY);
+                upper_.assign(dimension_, -INFINITY);
+
+                for (const auto& objectives : front)
+                {
+                    for (size_t i = 0; i < dimension_; ++i)
+                    {
+                        lower_[i] = std::min(lower_[i], objectives[i]);
+                        upper_[i] = std::max(upper_[i], objectives[i]);
+                    }
+                }
+            }
+
+            std::vector<double> points;
+            for (const auto& objectives : front)
+            {
+                for (size_t i = 0; i < dimension_; ++i)
+                {
+                    points.push_back(upper_[i] > lower_[i] ? (objectives[i] - lower_[i]) / (upper_[i] - lower_[i]) : objectives[i] - lower_[i]);
+                }
+            }
+
+        //  the indicators are only re-computed when the front has changed
+            if (history_.empty() || points != points_)
+            {
+                points_.swap(points);
+
+                auto normalized = normalize(points_);
+                history_.push_back({ hypervolume(points_), generational(normalized), spread(normalized) });
+            }
+            else
+            {
+                history_.push_back(history_.back());
+            }
+
+            if (history_.size() > 1)
+            {
+                const auto &current = history_.back(), &previous = *std::prev(history_.end(), 2);
+
+                auto relative = [](double current, double previous) { return std::abs(current - previous) / std::max(std::abs(previous), 1e-12); };
+
+                bool status = relative(current.hypervolume, previous.hypervolume) < tolerance_ && relative(current.distance, previous.distance) < tolerance_;
+                stagnation_ = status ? stagnation_ + 1 : 0;
+            }
+
+            return patience_ && stagnation_ >= patience_;
+        }
+
+        const std::vector<Indicators>& history() const
+        {
+            return history_;
+        }
+
+        void save(Snapshot& snapshot, const std::string& name) const
+        {
+            store(snapshot, name + ".lower", lower_);
+            store(snapshot, name + ".upper", upper_);
+            store(snapshot, name + ".points", points_);
+            store(snapshot, name + ".dominating", dominating_);
+            store(snapshot, name + ".volume", &volume_, 1);
+            store(snapshot, name + ".history", history_);
+            serialize(snapshot, name + ".stagnation", stagnation_);
+        }
+
+        void restore(const Snapshot& snapshot, const std::string& name)
+        {
+            lower_ = load<double>(snapshot, name + ".lower");
+            upper_ = load<double>(snapshot, name + ".upper");
+            points_ = load<double>(snapshot, name + ".points");
+            dominating_ = load<double>(snapshot, name + ".dominating");
+
+            auto volume = load<double>(snapshot, name + ".volume");
+            volume_ = volume.empty() ? 0.0 : volume.front();
+            history_ = load<Indicators>(snapshot, name + ".history");
+            deserialize(snapshot, name + ".stagnation", stagnation_);
+        }
+
+    public:
+        Monitor(size_t dimension, size_t division, size_t patience, double tolerance) :
+            dimension_(dimension), patience_(patience), stagnation_(0), tolerance_(tolerance), volume_(0),
+            references_(simplex(dimension, std::max<size_t>(division, 1)))
+        {
+        }
+    };
+}
+#endif //! _math_optimization_evolutionary_monitor_
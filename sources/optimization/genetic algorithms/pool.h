@@ -0,0 +1,442 @@
+#include <new>
+#include <deque>
+#include <vector>
+#include <string>
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <cmath>
+#include <cstring>
+#include <thread>
+#include <algorithm>
+#include <filesystem>
+#include <system_error>
+
+#ifndef _WINDOWS_
+#include <ctime>
+#include <cerrno>
+#include <csignal>
+#include <poll.h>
+#include <unistd.h>
+#include <semaphore.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#endif
+
+#include "../optimizor.h"
+
+#ifndef _math_optimization_evolutionary_pool_
+#define _math_optimization_evolutionary_pool_
+namespace Evolutionary
+{
+//  evaluation by a pool of forked worker processes, for the objectives running external models through shared files,
+//  every worker runs in its own scratch directory, seeded with the files of the prototype directory,
+//  the decisions go to the workers and the results come back through a ring of slots per worker in shared memory,
+//  a worker exceeding the timeout is killed and a crashed one restarted, the evaluation it held fails with not a number,
+//  the workers are forked by a server process forked once at the construction, which never starts a thread,
+//  so a worker restarted later does not inherit the locks held by the threads of the parent
+    class Pool : public math::Optimizor::Objective
+    {
+    private:
+    //  one slot is evaluated while the next one waits, so a worker never idles between two evaluations
+        static constexpr size_t depth_ = 2;
+        static constexpr size_t empty_ = 0, queued_ = 1, done_ = 2, stop_ = 3;
+
+    //  the semaphore and the states are shared with the worker, the rest of the ring belongs to the parent
+    //  the process of the worker is set by the server, -1 while requested and 0 once reaped
+        struct Channel
+        {
+        #ifndef _WINDOWS_
+            sem_t requests;
+        #endif
+            std::atomic<size_t> states[depth_];
+            std::atomic<int> pid;
+        };
+
+        struct Worker
+        {
+            Channel* channel;
+            double* values;
+            size_t head, tail, tasks[depth_];
+            std::chrono::steady_clock::time_point since;
+            std::filesystem::path directory;
+        };
+
+    private:
+        size_t scale_, dimension_, constraint_, length_;
+        double timeout_;
+        math::Optimizor::Objective* objective_;
+
+        void* memory_;
+        size_t bytes_;
+    #ifndef _WINDOWS_
+        sem_t* responses_;
+    #endif
+        std::vector<Worker> workers_;
+        size_t failures_;
+
+    //  the fork server and the pipe of its requests, the directories created for the workers, removed with the pool
+        int server_, requests_;
+        std::vector<std::filesystem::path> directories_;
+
+    private:
+        double* slot(Worker& worker, size_t index)
+        {
+            return worker.values + (index % depth_) * length_;
+        }
+
+    //  the loop of the worker process, it starts at the first slot of the ring reset for it and never returns
+        [[noreturn]] void work(Worker& worker)
+        {
+        #ifndef _WINDOWS_
+            std::error_code error;
+            std::filesystem::current_path(worker.directory, error);
+
+            for (size_t index = 0;; ++index)
+            {
+                while (sem_wait(&worker.channel->requests) != 0) {}
+
+                auto& state = worker.channel->states[index % depth_];
+                if (state.load(std::memory_order_acquire) == stop_) { ::_exit(0); }
+
+                double* values = slot(worker, index);
+                (*objective_)(values, values + scale_, values + scale_ + dimension_);
+
+                state.store(done_, std::memory_order_release);
+                sem_post(responses_);
+            }
+        #endif
+            std::abort();
+        }
+
+    //  the loop of the fork server, a worker per index read from the pipe, the workers that exit are reaped and marked as such,
+    //  once the pipe closes the workers left are killed and the server exits
+        [[noreturn]] void serve(int requests)
+        {
+        #ifndef _WINDOWS_
+            auto reap = [this]()
+                {
+                    for (int pid; (pid = ::waitpid(-1, nullptr, WNOHANG)) > 0;)
+                    {
+                        for (auto& worker : workers_)
+                        {
+                            int expected = pid;
+                            worker.channel->pid.compare_exchange_strong(expected, 0);
+                        }
+                    }
+                };
+
+            for (;;)
+            {
+                pollfd descriptor = { requests, POLLIN, 0 };
+                int status = ::poll(&descriptor, 1, 10);
+                reap();
+
+                if (status <= 0) { continue; }
+
+                size_t index = 0;
+                if (::read(requests, &index, sizeof(index)) != ssize_t(sizeof(index)))
+                {
+                    for (auto& worker : workers_)
+                    {
+                        int pid = worker.channel->pid.load();
+                        pid > 0 ? void(::kill(pid, SIGKILL)) : void();
+                    }
+
+                    while (::waitpid(-1, nullptr, 0) > 0) {}
+                    ::_exit(0);
+                }
+
+                int pid = ::fork();
+                if (pid == 0)
+                {
+                    ::close(requests);
+                    work(workers_[index]);
+                }
+
+                workers_[index].channel->pid.store(pid > 0 ? pid : 0);
+            }
+        #endif
+            std::abort();
+        }
+
+    //  the ring is reset and the server asked for a new process
+        void spawn(Worker& worker)
+        {
+        #ifndef _WINDOWS_
+            worker.head = worker.tail = 0;
+            for (auto& state : worker.channel->states) { state.store(empty_); }
+            sem_init(&worker.channel->requests, 1, 0);
+            worker.channel->pid.store(-1);
+
+            size_t index = &worker - workers_.data();
+            ssize_t written = ::write(requests_, &index, sizeof(index));
+            written == ssize_t(sizeof(index)) ? void() : worker.channel->pid.store(0);
+        #endif
+        }
+
+    //  the process is killed and waited for until the server has reaped it
+        void kill(Worker& worker)
+        {
+        #ifndef _WINDOWS_
+            for (int pid; (pid = worker.channel->pid.load()) != 0;)
+            {
+                pid > 0 ? void(::kill(pid, SIGKILL)) : void();
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+
+            sem_destroy(&worker.channel->requests);
+        #endif
+        }
+
+        void push(Worker& worker, size_t task, const double* decisions)
+        {
+            worker.head == worker.tail ? void(worker.since = std::chrono::steady_clock::now()) : void();
+
+            std::copy(decisions, decisions + scale_, slot(worker, worker.tail));
+            worker.tasks[worker.tail % depth_] = task;
+            worker.channel->states[worker.tail % depth_].store(queued_, std::memory_order_release);
+            worker.tail++;
+
+        #ifndef _WINDOWS_
+            sem_post(&worker.channel->requests);
+        #endif
+        }
+
+    //  copy out the finished evaluations of the worker in order, return their number
+        size_t collect(Worker& worker, double* const* objectives, double* const* voilations)
+        {
+            size_t count = 0;
+            while (worker.head != worker.tail && worker.channel->states[worker.head % depth_].load(std::memory_order_acquire) == done_)
+            {
+                const double* values = slot(worker, worker.head);
+                size_t task = worker.tasks[worker.head % depth_];
+
+                std::copy(values + scale_, values + scale_ + dimension_, objectives[task]);
+                std::copy(values + scale_ + dimension_, values + length_, voilations[task]);
+                worker.channel->states[worker.head % depth_].store(empty_);
+
+                worker.head++;
+                worker.since = std::chrono::steady_clock::now();
+                count++;
+            }
+
+            return count;
+        }
+
+    //  a worker which died or overran the timeout is replaced, the evaluation it was running fails and the waiting ones go back to the queue,
+    //  return the number of failed evaluations
+        size_t supervise(Worker& worker, std::deque<size_t>& pending, double* const* objectives, double* const* voilations)
+        {
+        #ifndef _WINDOWS_
+            bool dead = worker.channel->pid.load() == 0;
+            bool late = timeout_ > 0 && worker.head != worker.tail &&
+                std::chrono::duration<double>(std::chrono::steady_clock::now() - worker.since).count() > timeout_;
+
+            if (!dead && !late) { return 0; }
+
+            kill(worker);
+
+            size_t count = 0;
+            if (worker.head != worker.tail)
+            {
+                size_t task = worker.tasks[worker.head % depth_];
+                std::fill(objectives[task], objectives[task] + dimension_, failure());
+                std::fill(voilations[task], voilations[task] + constraint_, failure());
+
+                for (size_t index = worker.tail; index-- > worker.head + 1;) { pending.push_front(worker.tasks[index % depth_]); }
+
+                failures_++;
+                count++;
+            }
+
+            spawn(worker);
+            return count;
+        #else
+            return 0;
+        #endif
+        }
+
+    //  wait until a worker posts a result or the polling interval passes
+        void wait()
+        {
+        #ifndef _WINDOWS_
+            timespec deadline;
+            clock_gettime(CLOCK_REALTIME, &deadline);
+            deadline.tv_nsec += 50000000;
+            deadline.tv_sec += deadline.tv_nsec / 1000000000;
+            deadline.tv_nsec %= 1000000000;
+
+            sem_timedwait(responses_, &deadline);
+        #endif
+        }
+
+    public:
+    //  the times a failed evaluation is tried again before the population gives up on the individual
+        static constexpr size_t retries = 2;
+
+    //  the objectives and voilations of a failed evaluation, the cache does not keep them and the population evaluates them again
+        static double failure()
+        {
+            return std::numeric_limits<double>::quiet_NaN();
+        }
+
+        static bool failed(size_t dimension, const double* objectives)
+        {
+            return std::any_of(objectives, objectives + dimension, [](double value) { return std::isnan(value); });
+        }
+
+        size_t workers() const
+        {
+            return workers_.size();
+        }
+
+        size_t failures() const
+        {
+            return failures_;
+        }
+
+    public:
+        virtual void operator () (const double* decisions, double* objectives, double* voilations)
+        {
+            (*this)(1, &decisions, &objectives, &voilations);
+        }
+
+        virtual void operator () (size_t count, const double* const* decisions, double* const* objectives, double* const* voilations)
+        {
+            if (workers_.empty())
+            {
+                (*objective_)(count, decisions, objectives, voilations);
+                return;
+            }
+
+            std::deque<size_t> pending(count);
+            for (size_t i = 0; i < count; ++i) { pending[i] = i; }
+
+            for (size_t done = 0; done < count;)
+            {
+                for (auto& worker : workers_)
+                {
+                    while (worker.tail - worker.head < depth_ && !pending.empty())
+                    {
+                        push(worker, pending.front(), decisions[pending.front()]);
+                        pending.pop_front();
+                    }
+                }
+
+                wait();
+
+                for (auto& worker : workers_)
+                {
+                    done += collect(worker, objectives, voilations);
+                    done += supervise(worker, pending, objectives, voilations);
+                }
+            }
+        }
+
+    public:
+    //  the server is forked at once, so the objective must be ready to evaluate, and no other thread should run yet,
+    //  without a scratch directory the workers get their own under the temporary directory
+        Pool(math::Optimizor::Objective* objective, size_t scale, size_t dimension, size_t constraint, size_t workers,
+            double timeout = 0, const std::string& scratch = "", const std::string& prototype = "") :
+            scale_(scale), dimension_(dimension), constraint_(constraint), length_(scale + dimension + constraint),
+            timeout_(timeout), objective_(objective), memory_(nullptr), bytes_(0), failures_(0), server_(0), requests_(-1)
+        {
+        #ifndef _WINDOWS_
+            size_t stride = (sizeof(Channel) + sizeof(double) - 1) / sizeof(double) * sizeof(double) + depth_ * length_ * sizeof(double);
+            bytes_ = sizeof(sem_t) + sizeof(double) + workers * stride;
+            memory_ = ::mmap(nullptr, bytes_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+
+            if (memory_ == MAP_FAILED)
+            {
+                memory_ = nullptr;
+                return;
+            }
+
+            responses_ = new (memory_) sem_t;
+            sem_init(responses_, 1, 0);
+
+            std::filesystem::path base = scratch.empty() ?
+                std::filesystem::temp_directory_path() / ("evolutionary." + std::to_string(::getpid())) : std::filesystem::path(scratch);
+
+            std::error_code error;
+            bool fresh = !std::filesystem::exists(base, error);
+            fresh ? directories_.push_back(base) : void();
+
+            auto bytes = static_cast<char*>(memory_) + (sizeof(sem_t) + sizeof(double) - 1) / sizeof(double) * sizeof(double);
+            workers_.resize(workers);
+
+            for (size_t i = 0; i < workers; ++i)
+            {
+                auto& worker = workers_[i];
+                worker.channel = new (bytes + i * stride) Channel;
+                worker.channel->pid.store(0);
+                worker.values = reinterpret_cast<double*>(bytes + i * stride + stride - depth_ * length_ * sizeof(double));
+                worker.directory = base / std::to_string(i);
+
+                bool created = std::filesystem::create_directories(worker.directory, error);
+                created && !fresh ? directories_.push_back(worker.directory) : void();
+
+                prototype.empty() ? void() : std::filesystem::copy(prototype, worker.directory,
+                    std::filesystem::copy_options::recursive | std::filesystem::copy_options::overwrite_existing, error);
+            }
+
+            int pipe[2];
+            if (::pipe(pipe) != 0)
+            {
+                workers_.clear();
+                return;
+            }
+
+            server_ = ::fork();
+            if (server_ == 0)
+            {
+                ::close(pipe[1]);
+                serve(pipe[0]);
+            }
+
+            ::close(pipe[0]);
+            requests_ = pipe[1];
+
+            if (server_ < 0)
+            {
+                workers_.clear();
+                return;
+            }
+
+            for (auto& worker : workers_) { spawn(worker); }
+        #endif
+        }
+
+        virtual ~Pool()
+        {
+        #ifndef _WINDOWS_
+            for (auto& worker : workers_)
+            {
+            //  the idle worker reads the stop state at its next slot and exits by itself, a busy one is killed
+                worker.channel->states[worker.tail % depth_].store(stop_, std::memory_order_release);
+                sem_post(&worker.channel->requests);
+
+                auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+                while (worker.channel->pid.load() > 0 && std::chrono::steady_clock::now() < deadline)
+                {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+
+                kill(worker);
+            }
+
+        //  the server kills what is left and exits once its pipe closes
+            requests_ >= 0 ? void(::close(requests_)) : void();
+            server_ > 0 ? void(::waitpid(server_, nullptr, 0)) : void();
+
+            memory_ ? void(sem_destroy(responses_)) : void();
+            memory_ ? void(::munmap(memory_, bytes_)) : void();
+
+            std::error_code error;
+            for (auto& directory : directories_) { std::filesystem::remove_all(directory, error); }
+        #endif
+        }
+    };
+}
+#endif //! _math_optimization_evolutionary_pool_
@@ -0,0 +1,793 @@
+#include <map>
+#include <cmath>
+#include <string>
+#include <vector>
+#include <memory>
+#include <random>
+#include <numeric>
+#include <algorithm>
+#include <functional>
+
+#include "../optimizor.h"
+#include "dominance.h"
+#include "monitor.h"
+
+#ifndef _math_optimization_evolutionary_problems_
+#define _math_optimization_evolutionary_problems_
+//  the scalable test problems of ZDT, DTLZ, WFG, LSMOP and SMOP, all to be minimized
+namespace Benchmark
+{
+    constexpr double pi = 3.14159265358979323846;
+
+    class Problem : public math::Optimizor::Objective
+    {
+    protected:
+        size_t dimension_, scale_;
+        std::vector<double> upper_, lower_, integer_;
+
+    protected:
+    //  decisions on the pareto set for the random positions, used to sample the front of the problems without an analytic one
+        virtual void optimum(std::mt19937_64& generator, double* decisions) const
+        {
+            std::uniform_real_distribution<double> uniform(0, 1);
+            for (size_t i = 0; i < scale_; ++i) { decisions[i] = lower_[i] + uniform(generator) * (upper_[i] - lower_[i]); }
+        }
+
+    //  only the non dominated points are kept
+        std::vector<double> filter(const std::vector<double>& points) const
+        {
+            std::vector<double> results;
+            size_t count = points.size() / dimension_;
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                bool dominated = false;
+                for (size_t j = 0; j < count && !dominated; ++j)
+                {
+                    dominated = Evolutionary::dominate(dimension_, &points[j * dimension_], &points[i * dimension_]) == 1;
+                }
+
+                if (!dominated) { results.insert(results.end(), points.begin() + i * dimension_, points.begin() + (i + 1) * dimension_); }
+            }
+
+            return results;
+        }
+
+    //  uniformly spread points of the unit simplex, as many as the count allows
+        std::vector<double> lattice(size_t count) const
+        {
+            size_t division = 1;
+            auto combinations = [this](size_t division)
+                {
+                    double result = 1;
+                    for (size_t i = 1; i < dimension_; ++i) { result = result * (division + i) / i; }
+                    return result;
+                };
+
+            while (combinations(division + 1) <= count) { division++; }
+            return Evolutionary::simplex(dimension_, division);
+        }
+
+        std::vector<double> sphere(size_t count) const
+        {
+            auto&& points = lattice(count);
+            for (size_t i = 0; i < points.size(); i += dimension_)
+            {
+                double norm = std::sqrt(std::inner_product(points.begin() + i, points.begin() + i + dimension_, points.begin() + i, 0.0));
+                std::transform(points.begin() + i, points.begin() + i + dimension_, points.begin() + i, [norm](double value) { return value / norm; });
+            }
+
+            return points;
+        }
+
+    public:
+    //  sample points of the pareto front
+        virtual std::vector<double> front(size_t count)
+        {
+            std::mt19937_64 generator(count);
+            std::vector<double> decisions(scale_), objectives(dimension_), voilations(1), points;
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                optimum(generator, decisions.data());
+                (*this)(decisions.data(), objectives.data(), voilations.data());
+                points.insert(points.end(), objectives.begin(), objectives.end());
+            }
+
+            return filter(points);
+        }
+
+        size_t dimension() const { return dimension_; }
+        size_t scale() const { return scale_; }
+
+        const std::vector<double>& upper() const { return upper_; }
+        const std::vector<double>& lower() const { return lower_; }
+        const std::vector<double>& integer() const { return integer_; }
+
+    public:
+        Problem(size_t dimension, size_t scale, double upper = 1, double lower = 0) :
+            dimension_(dimension), scale_(scale), upper_(scale, upper), lower_(scale, lower), integer_(scale, 0.0)
+        {
+        }
+
+        virtual ~Problem() {}
+    };
+
+/**************************************************************************
+ *  ZDT, two objectives
+ ***************************************************************/
+    class ZDT : public Problem
+    {
+    private:
+        size_t index_;
+
+    private:
+    //  decoded value of the bits, ZDT5 only
+        static size_t decode(const double* bits, size_t length)
+        {
+            return std::count_if(bits, bits + length, [](double bit) { return bit > 0.5; });
+        }
+
+    protected:
+        virtual void optimum(std::mt19937_64& generator, double* decisions) const
+        {
+            std::uniform_real_distribution<double> uniform(0, 1);
+
+            std::fill(decisions, decisions + scale_, index_ == 5 ? 1.0 : 0.0);
+            if (index_ == 5)
+            {
+                size_t ones = size_t(uniform(generator) * 31);
+                std::fill(decisions, decisions + 30, 0.0);
+                std::fill(decisions, decisions + std::min<size_t>(ones, 30), 1.0);
+                return;
+            }
+
+            decisions[0] = uniform(generator);
+        }
+
+    public:
+        virtual void operator () (const double* decisions, double* objectives, double*)
+        {
+            const double* x = decisions;
+            size_t n = scale_;
+
+            if (index_ == 5)
+            {
+                objectives[0] = 1.0 + decode(x, 30);
+
+                double g = 0;
+                for (size_t i = 30; i + 5 <= n; i += 5)
+                {
+                    size_t u = decode(x + i, 5);
+                    g += u < 5 ? 2.0 + u : 1.0;
+                }
+
+                objectives[1] = g / objectives[0];
+                return;
+            }
+
+            double sum = 0;
+            for (size_t i = 1; i < n; ++i) { sum += index_ == 4 ? x[i] * x[i] - 10 * std::cos(4 * pi * x[i]) : x[i]; }
+
+            double g = index_ == 4 ? 1 + 10.0 * (n - 1) + sum : (index_ == 6 ? 1 + 9 * std::pow(sum / (n - 1), 0.25) : 1 + 9 * sum / (n - 1));
+            double f = index_ == 6 ? 1 - std::exp(-4 * x[0]) * std::pow(std::sin(6 * pi * x[0]), 6) : x[0];
+
+            objectives[0] = f;
+
+            switch (index_)
+            {
+            case 2:
+            case 6:
+                objectives[1] = g * (1 - std::pow(f / g, 2));
+                break;
+            case 3:
+                objectives[1] = g * (1 - std::sqrt(f / g) - f / g * std::sin(10 * pi * f));
+                break;
+            default:
+                objectives[1] = g * (1 - std::sqrt(f / g));
+            }
+        }
+
+    public:
+        ZDT(size_t index, size_t scale) :
+            Problem(2, index == 5 ? 30 + 5 * std::max<size_t>((scale > 30 ? scale - 30 : 0) / 5, 1) : std::max<size_t>(scale, 2)), index_(index)
+        {
+            if (index_ == 4)
+            {
+                std::fill(upper_.begin() + 1, upper_.end(), 5.0);
+                std::fill(lower_.begin() + 1, lower_.end(), -5.0);
+            }
+
+            if (index_ == 5) { std::fill(integer_.begin(), integer_.end(), 1.0); }
+        }
+    };
+
+/**************************************************************************
+ *  DTLZ, the first dimension - 1 decisions are the positions
+ ***************************************************************/
+    class DTLZ : public Problem
+    {
+    private:
+        size_t index_;
+
+    protected:
+        virtual void optimum(std::mt19937_64& generator, double* decisions) const
+        {
+            std::uniform_real_distribution<double> uniform(0, 1);
+
+            std::generate(decisions, decisions + dimension_ - 1, [&]() { return uniform(generator); });
+            std::fill(decisions + dimension_ - 1, decisions + scale_, index_ >= 6 ? 0.0 : 0.5);
+        }
+
+    public:
+        virtual void operator () (const double* decisions, double* objectives, double*)
+        {
+            const double* x = decisions;
+            size_t m = dimension_, n = scale_, k = n - m + 1;
+
+            double g = 0;
+            for (size_t i = m - 1; i < n; ++i)
+            {
+                switch (index_)
+                {
+                case 1:
+                case 3:
+                    g += std::pow(x[i] - 0.5, 2) - std::cos(20 * pi * (x[i] - 0.5));
+                    break;
+                case 6:
+                    g += std::pow(x[i], 0.1);
+                    break;
+                case 7:
+                    g += x[i];
+                    break;
+                default:
+                    g += std::pow(x[i] - 0.5, 2);
+                }
+            }
+
+            g = (index_ == 1 || index_ == 3) ? 100 * (k + g) : (index_ == 7 ? 1 + 9 * g / k : g);
+
+            if (index_ == 1)
+            {
+                for (size_t o = 0; o < m; ++o)
+                {
+                    double f = 0.5 * (1 + g);
+                    for (size_t j = 0; j + o + 1 < m; ++j) { f *= x[j]; }
+                    objectives[o] = o ? f * (1 - x[m - o - 1]) : f;
+                }
+
+                return;
+            }
+
+            if (index_ == 7)
+            {
+                double h = double(m);
+                for (size_t o = 0; o + 1 < m; ++o)
+                {
+                    objectives[o] = x[o];
+                    h -= x[o] / (1 + g) * (1 + std::sin(3 * pi * x[o]));
+                }
+
+                objectives[m - 1] = (1 + g) * h;
+                return;
+            }
+
+            std::vector<double> angles(m - 1);
+            for (size_t j = 0; j + 1 < m; ++j)
+            {
+                double position = index_ == 4 ? std::pow(x[j], 100.0) : x[j];
+                angles[j] = (index_ == 5 || index_ == 6) && j > 0 ? pi / (4 * (1 + g)) * (1 + 2 * g * x[j]) : position * pi / 2;
+            }
+
+            for (size_t o = 0; o < m; ++o)
+            {
+                double f = 1 + g;
+                for (size_t j = 0; j + o + 1 < m; ++j) { f *= std::cos(angles[j]); }
+                objectives[o] = o ? f * std::sin(angles[m - o - 1]) : f;
+            }
+        }
+
+        virtual std::vector<double> front(size_t count)
+        {
+            if (index_ == 1)
+            {
+                auto&& points = lattice(count);
+                std::transform(points.begin(), points.end(), points.begin(), [](double value) { return value / 2; });
+                return points;
+            }
+
+            return index_ >= 2 && index_ <= 4 ? sphere(count) : Problem::front(count);
+        }
+
+    public:
+        DTLZ(size_t index, size_t dimension, size_t scale) : Problem(dimension, std::max(scale, dimension)), index_(index) {}
+    };
+
+/**************************************************************************
+ *  WFG, the first k decisions are the positions, the others the distances
+ ***************************************************************/
+    class WFG : public Problem
+    {
+    private:
+        size_t index_, k_, l_;
+
+    private:
+        static double linear(double y, double a)
+        {
+            return std::abs(y - a) / std::abs(std::floor(a - y) + a);
+        }
+
+        static double deceptive(double y, double a, double b, double c)
+        {
+            return 1 + (std::abs(y - a) - b) * (std::floor(y - a + b) * (1 - c + (a - b) / b) / (a - b) +
+                std::floor(a + b - y) * (1 - c + (1 - a - b) / b) / (1 - a - b) + 1 / b);
+        }
+
+        static double multimodal(double y, double a, double b, double c)
+        {
+            double t = std::abs(y - c) / (2 * (std::floor(c - y) + c));
+            return (1 + std::cos((4 * a + 2) * pi * (0.5 - t)) + 4 * b * t * t) / (b + 2);
+        }
+
+    //  the rounding can leave the value slightly outside [0, 1], which the later powers do not accept
+        static double flat(double y, double a, double b, double c)
+        {
+            double result = a + std::min(0.0, std::floor(y - b)) * a * (b - y) / b - std::min(0.0, std::floor(c - y)) * (1 - a) * (y - c) / (1 - c);
+            return std::clamp(result, 0.0, 1.0);
+        }
+
+        static double parameter(double y, double u, double a, double b, double c)
+        {
+            return std::pow(y, b + (c - b) * (a - (1 - 2 * u) * std::abs(std::floor(0.5 - u) + a)));
+        }
+
+        static double sum(const double* y, const double* w, size_t length)
+        {
+            return std::inner_product(y, y + length, w, 0.0) / std::accumulate(w, w + length, 0.0);
+        }
+
+        static double nonseparable(const double* y, size_t length, size_t a)
+        {
+            double result = 0;
+            for (size_t j = 0; j < length; ++j)
+            {
+                result += y[j];
+                for (size_t i = 0; i + 2 <= a; ++i) { result += std::abs(y[j] - y[(j + i + 1) % length]); }
+            }
+
+            double half = std::ceil(a / 2.0);
+            return result / (double(length) / a * half * (1 + 2 * a - 2 * half));
+        }
+
+    //  the positions are reduced group by group, and the distances into the last one
+        std::vector<double> reduce(const std::vector<double>& y, bool weighted, bool separable, size_t distances) const
+        {
+            size_t m = dimension_, group = k_ / (m - 1);
+            std::vector<double> weights(scale_), results(m);
+
+            for (size_t i = 0; i < scale_; ++i) { weights[i] = weighted ? 2.0 * (i + 1) : 1.0; }
+
+            for (size_t o = 0; o + 1 < m; ++o)
+            {
+                results[o] = separable ? sum(&y[o * group], &weights[o * group], group) : nonseparable(&y[o * group], group, group);
+            }
+
+            results[m - 1] = separable ? sum(&y[k_], &weights[k_], distances) : nonseparable(&y[k_], distances, distances);
+            return results;
+        }
+
+    protected:
+        virtual void optimum(std::mt19937_64& generator, double* decisions) const
+        {
+            std::uniform_real_distribution<double> uniform(0, 1);
+
+            for (size_t i = 0; i < scale_; ++i)
+            {
+                decisions[i] = upper_[i] * (i < k_ ? uniform(generator) : 0.35);
+            }
+        }
+
+    public:
+        virtual void operator () (const double* decisions, double* objectives, double*)
+        {
+            size_t m = dimension_, n = scale_;
+            std::vector<double> y(n);
+
+            for (size_t i = 0; i < n; ++i) { y[i] = decisions[i] / (2.0 * (i + 1)); }
+
+            std::vector<double> t;
+            switch (index_)
+            {
+            case 1:
+                for (size_t i = k_; i < n; ++i) { y[i] = linear(y[i], 0.35); }
+                for (size_t i = k_; i < n; ++i) { y[i] = flat(y[i], 0.8, 0.75, 0.85); }
+                for (size_t i = 0; i < n; ++i) { y[i] = std::pow(y[i], 0.02); }
+                t = reduce(y, true, true, l_);
+                break;
+            case 2:
+            case 3:
+                for (size_t i = k_; i < n; ++i) { y[i] = linear(y[i], 0.35); }
+                for (size_t i = 0; i < l_ / 2; ++i) { y[k_ + i] = nonseparable(&y[k_ + 2 * i], 2, 2); }
+                t = reduce(y, false, true, l_ / 2);
+                break;
+            case 4:
+                for (size_t i = 0; i < n; ++i) { y[i] = multimodal(y[i], 30, 10, 0.35); }
+                t = reduce(y, false, true, l_);
+                break;
+            case 5:
+                for (size_t i = 0; i < n; ++i) { y[i] = deceptive(y[i], 0.35, 0.001, 0.05); }
+                t = reduce(y, false, true, l_);
+                break;
+            case 6:
+                for (size_t i = k_; i < n; ++i) { y[i] = linear(y[i], 0.35); }
+                t = reduce(y, false, false, l_);
+                break;
+            case 7:
+            {
+            //  the mean of the decisions behind, from the last one backwards
+                std::vector<double> behinds(n, 0.0);
+                for (size_t i = n - 1; i-- > 0;) { behinds[i] = behinds[i + 1] + y[i + 1]; }
+                for (size_t i = 0; i < k_; ++i) { y[i] = parameter(y[i], behinds[i] / (n - i - 1), 0.98 / 49.98, 0.02, 50); }
+                for (size_t i = k_; i < n; ++i) { y[i] = linear(y[i], 0.35); }
+                t = reduce(y, false, true, l_);
+                break;
+            }
+            case 8:
+            {
+                std::vector<double> original(y);
+                double front = std::accumulate(original.begin(), original.begin() + k_, 0.0);
+                for (size_t i = k_; i < n; ++i)
+                {
+                    y[i] = parameter(original[i], front / i, 0.98 / 49.98, 0.02, 50);
+                    front += original[i];
+                }
+                for (size_t i = k_; i < n; ++i) { y[i] = linear(y[i], 0.35); }
+                t = reduce(y, false, true, l_);
+                break;
+            }
+            default:
+            {
+                std::vector<double> behinds(n, 0.0);
+                for (size_t i = n - 1; i-- > 0;) { behinds[i] = behinds[i + 1] + y[i + 1]; }
+                for (size_t i = 0; i + 1 < n; ++i) { y[i] = parameter(y[i], behinds[i] / (n - i - 1), 0.98 / 49.98, 0.02, 50); }
+                for (size_t i = 0; i < k_; ++i) { y[i] = deceptive(y[i], 0.35, 0.001, 0.05); }
+                for (size_t i = k_; i < n; ++i) { y[i] = multimodal(y[i], 30, 95, 0.35); }
+                t = reduce(y, false, false, l_);
+            }
+            }
+
+        //  the positions of the shape, degenerated for WFG3
+            std::vector<double> x(m);
+            for (size_t o = 0; o + 1 < m; ++o)
+            {
+                double a = index_ == 3 && o > 0 ? 0.0 : 1.0;
+                x[o] = std::max(t[m - 1], a) * (t[o] - 0.5) + 0.5;
+            }
+            x[m - 1] = t[m - 1];
+
+            for (size_t o = 0; o < m; ++o)
+            {
+                double h = 1;
+                size_t count = m - o - 1;
+
+                if (index_ == 3)
+                {
+                    for (size_t j = 0; j < count; ++j) { h *= x[j]; }
+                    h = o ? h * (1 - x[count]) : h;
+                }
+                else if (index_ <= 2)
+                {
+                    for (size_t j = 0; j < count; ++j) { h *= 1 - std::cos(x[j] * pi / 2); }
+                    h = o ? h * (1 - std::sin(x[count] * pi / 2)) : h;
+
+                    if (o == m - 1)
+                    {
+                        h = index_ == 1 ? 1 - x[0] - std::cos(10 * pi * x[0] + pi / 2) / (10 * pi) : 1 - x[0] * std::pow(std::cos(5 * x[0] * pi), 2);
+                    }
+                }
+                else
+                {
+                    for (size_t j = 0; j < count; ++j) { h *= std::sin(x[j] * pi / 2); }
+                    h = o ? h * std::cos(x[count] * pi / 2) : h;
+                }
+
+                objectives[o] = x[m - 1] + 2.0 * (o + 1) * h;
+            }
+        }
+
+        virtual std::vector<double> front(size_t count)
+        {
+            if (index_ <= 3) { return Problem::front(count); }
+
+            auto&& points = sphere(count);
+            for (size_t i = 0; i < points.size(); ++i) { points[i] *= 2.0 * (i % dimension_ + 1); }
+            return points;
+        }
+
+    public:
+    //  the positions are 2 per objective, the distances are the rest, even for WFG2 and WFG3
+        static size_t size(size_t index, size_t dimension, size_t scale)
+        {
+            size_t k = 2 * (dimension - 1), l = scale > k + 1 ? scale - k : 2;
+            return k + ((index == 2 || index == 3) && l % 2 ? l + 1 : l);
+        }
+
+        WFG(size_t index, size_t dimension, size_t scale) :
+            Problem(dimension, size(index, dimension, scale)), index_(index), k_(2 * (dimension - 1)), l_(scale_ - k_)
+        {
+            for (size_t i = 0; i < scale_; ++i) { upper_[i] = 2.0 * (i + 1); }
+        }
+    };
+
+/**************************************************************************
+ *  LSMOP, the distances are split into subcomponents of chaotic sizes, each with its own landscape
+ ***************************************************************/
+    class LSMOP : public Problem
+    {
+    private:
+        static constexpr size_t subcomponents_ = 5;
+
+        size_t index_;
+        std::vector<size_t> lengths_, offsets_;
+
+    private:
+        static double sphere(const double* x, size_t n)
+        {
+            return std::inner_product(x, x + n, x, 0.0);
+        }
+
+        static double schwefel(const double* x, size_t n)
+        {
+            double result = 0;
+            for (size_t i = 0; i < n; ++i) { result = std::max(result, std::abs(x[i])); }
+            return result;
+        }
+
+        static double rosenbrock(const double* x, size_t n)
+        {
+            double result = 0;
+            for (size_t i = 0; i + 1 < n; ++i) { result += 100 * std::pow(x[i] * x[i] - x[i + 1], 2) + std::pow(x[i] - 1, 2); }
+            return result;
+        }
+
+        static double rastrigin(const double* x, size_t n)
+        {
+            double result = 0;
+            for (size_t i = 0; i < n; ++i) { result += x[i] * x[i] - 10 * std::cos(2 * pi * x[i]) + 10; }
+            return result;
+        }
+
+        static double griewank(const double* x, size_t n)
+        {
+            double sum = 0, product = 1;
+            for (size_t i = 0; i < n; ++i)
+            {
+                sum += x[i] * x[i] / 4000;
+                product *= std::cos(x[i] / std::sqrt(i + 1.0));
+            }
+            return sum - product + 1;
+        }
+
+        static double ackley(const double* x, size_t n)
+        {
+            double squares = 0, cosines = 0;
+            for (size_t i = 0; i < n; ++i)
+            {
+                squares += x[i] * x[i];
+                cosines += std::cos(2 * pi * x[i]);
+            }
+            return n ? 20 - 20 * std::exp(-0.2 * std::sqrt(squares / n)) - std::exp(cosines / n) + std::exp(1.0) : 0.0;
+        }
+
+    //  the landscapes of the odd and even objectives
+        std::pair<double(*)(const double*, size_t), double(*)(const double*, size_t)> landscapes() const
+        {
+            switch (index_)
+            {
+            case 1: case 5: return { sphere, sphere };
+            case 2: return { griewank, schwefel };
+            case 3: return { rastrigin, rosenbrock };
+            case 4: return { ackley, griewank };
+            case 6: return { rosenbrock, schwefel };
+            case 7: return { ackley, rosenbrock };
+            case 8: return { griewank, sphere };
+            default: return { sphere, ackley };
+            }
+        }
+
+    public:
+        virtual void operator () (const double* decisions, double* objectives, double*)
+        {
+            size_t m = dimension_, n = scale_;
+            std::vector<double> x(decisions, decisions + n);
+
+        //  linear linkage of the distances to the first position for LSMOP1-4, non linear for the others
+            for (size_t i = m - 1; i < n; ++i)
+            {
+                double factor = index_ <= 4 ? 1 + (i + 1.0) / n : 1 + std::cos(0.5 * pi * (i + 1.0) / n);
+                x[i] = factor * x[i] - 10 * x[0];
+            }
+
+            auto [odd, even] = landscapes();
+            std::vector<double> g(m, 0.0);
+
+            for (size_t o = 0; o < m; ++o)
+            {
+                for (size_t j = 0; j < subcomponents_ && lengths_[o]; ++j)
+                {
+                    const double* begin = &x[m - 1 + offsets_[o] + j * lengths_[o]];
+                    g[o] += (o % 2 ? even : odd)(begin, lengths_[o]);
+                }
+
+                g[o] = lengths_[o] ? g[o] / lengths_[o] / subcomponents_ : 0.0;
+            }
+
+            if (index_ == 9)
+            {
+                double sum = 1 + std::accumulate(g.begin(), g.end(), 0.0), h = double(m);
+                for (size_t o = 0; o + 1 < m; ++o)
+                {
+                    objectives[o] = x[o];
+                    h -= x[o] / (1 + sum) * (1 + std::sin(3 * pi * x[o]));
+                }
+
+                objectives[m - 1] = (1 + sum) * h;
+                return;
+            }
+
+            for (size_t o = 0; o < m; ++o)
+            {
+                double f = index_ <= 4 ? 1 + g[o] : 1 + g[o] + (o + 1 < m ? g[o + 1] : 0.0);
+                for (size_t j = 0; j + o + 1 < m; ++j) { f *= index_ <= 4 ? x[j] : std::cos(x[j] * pi / 2); }
+
+                if (o) { f *= index_ <= 4 ? 1 - x[m - o - 1] : std::sin(x[m - o - 1] * pi / 2); }
+                objectives[o] = f;
+            }
+        }
+
+        virtual std::vector<double> front(size_t count)
+        {
+            if (index_ <= 4) { return lattice(count); }
+            if (index_ <= 8) { return Problem::sphere(count); }
+
+        //  the disconnected front of LSMOP9, the positions are free and the landscapes are at their optimum
+            std::mt19937_64 generator(count);
+            std::uniform_real_distribution<double> uniform(0, 1);
+            std::vector<double> points;
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                double h = double(dimension_);
+                for (size_t o = 0; o + 1 < dimension_; ++o)
+                {
+                    double f = uniform(generator);
+                    points.push_back(f);
+                    h -= f / 2 * (1 + std::sin(3 * pi * f));
+                }
+                points.push_back(2 * h);
+            }
+
+            return filter(points);
+        }
+
+    public:
+        LSMOP(size_t index, size_t dimension, size_t scale) :
+            Problem(dimension, std::max(scale, dimension + subcomponents_ * dimension), 10.0, 0.0), index_(index), lengths_(dimension), offsets_(dimension)
+        {
+            std::fill(upper_.begin(), upper_.begin() + dimension - 1, 1.0);
+
+        //  the sizes of the subcomponents follow the logistic map
+            std::vector<double> chaos(dimension);
+            chaos[0] = 3.8 * 0.1 * (1 - 0.1);
+            for (size_t o = 1; o < dimension; ++o) { chaos[o] = 3.8 * chaos[o - 1] * (1 - chaos[o - 1]); }
+
+            double total = std::accumulate(chaos.begin(), chaos.end(), 0.0);
+            for (size_t o = 0, offset = 0; o < dimension; ++o)
+            {
+                lengths_[o] = size_t(std::floor(chaos[o] / total * (scale_ - dimension + 1) / subcomponents_));
+                offsets_[o] = offset;
+                offset += lengths_[o] * subcomponents_;
+            }
+        }
+    };
+
+/**************************************************************************
+ *  SMOP, sparse pareto sets after the suite of Tian et al., the positions lie in [0, 1], the distances in [-1, 2],
+ *  a tenth of the distances are pi / 3 on the pareto set and the others zero, the problems combine a unimodal and
+ *  a multimodal landscape on the non zero and the zero distances, SMOP3, 4, 7 and 8 scale the distances by the first
+ *  position, SMOP1-4 have the linear front of DTLZ1 and SMOP5-8 the spherical one of DTLZ2
+ ***************************************************************/
+    class SMOP : public Problem
+    {
+    private:
+        static constexpr double sparsity_ = 0.1, target_ = pi / 3;
+
+        size_t index_, nonzeros_;
+
+    private:
+        static double unimodal(double distance)
+        {
+            return distance * distance;
+        }
+
+        static double multimodal(double distance)
+        {
+            return 2 * distance * distance + std::pow(std::sin(2 * pi * distance), 2);
+        }
+
+    protected:
+        virtual void optimum(std::mt19937_64& generator, double* decisions) const
+        {
+            std::uniform_real_distribution<double> uniform(0, 1);
+
+            std::generate(decisions, decisions + dimension_ - 1, [&]() { return uniform(generator); });
+            std::fill(decisions + dimension_ - 1, decisions + scale_, 0.0);
+            std::fill(decisions + dimension_ - 1, decisions + dimension_ - 1 + nonzeros_, target_);
+        }
+
+    public:
+        virtual void operator () (const double* decisions, double* objectives, double*)
+        {
+            const double* x = decisions;
+            size_t m = dimension_, n = scale_, k = n - m + 1;
+
+            auto nonzero = index_ % 4 == 1 || index_ % 4 == 2 ? unimodal : multimodal;
+            auto zero = index_ % 2 ? unimodal : multimodal;
+            double linkage = index_ % 4 == 3 || index_ % 4 == 0 ? 1 + x[0] : 1.0;
+
+            double g = 0;
+            for (size_t i = m - 1; i < n; ++i)
+            {
+                bool active = i < m - 1 + nonzeros_;
+                g += (active ? nonzero : zero)(linkage * (x[i] - (active ? target_ : 0.0)));
+            }
+
+            g = 1 + g / k;
+
+            for (size_t o = 0; o < m; ++o)
+            {
+                double f = g;
+                for (size_t j = 0; j + o + 1 < m; ++j) { f *= index_ <= 4 ? x[j] : std::cos(x[j] * pi / 2); }
+
+                if (o) { f *= index_ <= 4 ? 1 - x[m - o - 1] : std::sin(x[m - o - 1] * pi / 2); }
+                objectives[o] = f;
+            }
+        }
+
+        virtual std::vector<double> front(size_t count)
+        {
+            return index_ <= 4 ? lattice(count) : Problem::sphere(count);
+        }
+
+    public:
+        SMOP(size_t index, size_t dimension, size_t scale) :
+            Problem(dimension, std::max(scale, dimension), 2.0, -1.0), index_(index), nonzeros_(0)
+        {
+            std::fill(upper_.begin(), upper_.begin() + dimension - 1, 1.0);
+            std::fill(lower_.begin(), lower_.begin() + dimension - 1, 0.0);
+
+            nonzeros_ = size_t(std::ceil(sparsity_ * (scale_ - dimension + 1)));
+        }
+    };
+
+//  the problem by its name, zdt1 to zdt6, dtlz1 to dtlz7, wfg1 to wfg9, lsmop1 to lsmop9 and smop1 to smop8, null if unknown
+    inline std::unique_ptr<Problem> create(const std::string& name, size_t dimension, size_t scale)
+    {
+        size_t split = name.find_first_of("0123456789");
+
+        if (split == std::string::npos) { return nullptr; }
+
+        std::string family = name.substr(0, split);
+        size_t index = std::stoul(name.substr(split));
+        dimension = std::max<size_t>(dimension, 2);
+
+        if (family == "zdt" && index >= 1 && index <= 6) { return std::make_unique<ZDT>(index, scale); }
+        if (family == "dtlz" && index >= 1 && index <= 7) { return std::make_unique<DTLZ>(index, dimension, scale); }
+        if (family == "wfg" && index >= 1 && index <= 9) { return std::make_unique<WFG>(index, dimension, scale); }
+        if (family == "lsmop" && index >= 1 && index <= 9) { return std::make_unique<LSMOP>(index, dimension, scale); }
+        if (family == "smop" && index >= 1 && index <= 8) { return std::make_unique<SMOP>(index, dimension, scale); }
+
+        return nullptr;
+    }
+}
+#endif //! _math_optimization_evolutionary_problems_
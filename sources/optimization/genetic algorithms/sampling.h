@@ -0,0 +1,49 @@
+#include <cmath>
+#include <string>
+#include <vector>
+#include <random>
+#include <algorithm>
+
+#include "../../statistics/sampler/latin hypercube sampling/latin hypercube sampling.h"
+#include "../../statistics/sampler/sobol sequence/sobol sequence.h"
+
+#ifndef _math_optimization_evolutionary_sampling_
+#define _math_optimization_evolutionary_sampling_
+namespace Evolutionary
+{
+//  the candidates of the maximin latin hypercube
+    constexpr size_t candidates = 10;
+
+//  the decisions of count individuals, one row each, drawn in a single pass as uniform numbers, a maximin latin hypercube
+//  or a sobol sequence in the unit cube, then mapped to the bounds and rounded for the integer decisions,
+//  the sobol sequence covers a limited number of decisions, beyond them the latin hypercube is drawn instead
+    inline void sample(const std::string& design, size_t count, size_t scale, double* decisions,
+        const double* upper, const double* lower, const double* integer, std::mt19937_64& generator)
+    {
+        if (design == "sobol" && scale <= Sobol::maximum)
+        {
+            Sobol(scale).sample(count, decisions, generator);
+        }
+        else if (design == "latin" || design == "sobol")
+        {
+            LHD(scale, candidates).sample(count, decisions, generator);
+        }
+        else
+        {
+        //  the 53 high bits of the generator straight into the mantissa, without a distribution per number
+            std::generate(decisions, decisions + count * scale, [&generator]() { return double(generator() >> 11) * 0x1.0p-53; });
+        }
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            double* row = decisions + i * scale;
+
+            for (size_t k = 0; k < scale; ++k)
+            {
+                double value = lower[k] + row[k] * (upper[k] - lower[k]);
+                row[k] = integer[k] ? std::round(value) : value;
+            }
+        }
+    }
+}
+#endif //! _math_optimization_evolutionary_sampling_
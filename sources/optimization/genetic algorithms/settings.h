@@ -0,0 +1,210 @@
+#include <string>
+#include <vector>
+#include <memory>
+#include <optional>
+#include <random>
+#include <variant>
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+
+#include "../optimizor.h"
+
+#ifndef _math_optimization_evolutionary_settings_
+#define _math_optimization_evolutionary_settings_
+namespace Evolutionary
+{
+//  the configuration compiled once per run, every option is looked up, typed and validated here, so the components
+//  read plain fields, the bounds lie in one array shared by all of them instead of a copy per component,
+//  the settings are immutable and borrow the objective of the configuration, which has to outlive them
+    class Settings
+    {
+    private:
+    //  upper, lower and integer one after another
+        std::vector<double> bounds_;
+
+    private:
+    //  a missing option is null, a whole number is taken where a real one is expected
+        template<typename T>
+        static std::optional<T> find(const math::Optimizor::Configuration& configuration, const std::string& name)
+        {
+            if (!configuration.contains(name)) { return std::nullopt; }
+
+            const auto& value = configuration[name];
+
+            if (auto result = std::get_if<T>(&value)) { return *result; }
+
+            if constexpr (std::is_same_v<T, double>)
+            {
+                if (auto result = std::get_if<size_t>(&value)) { return double(*result); }
+            }
+
+            throw std::invalid_argument("the option " + name + " is of a wrong type");
+        }
+
+        template<typename T>
+        static T optional(const math::Optimizor::Configuration& configuration, const std::string& name, const T& fallback)
+        {
+            auto value = find<T>(configuration, name);
+            return value ? std::move(*value) : fallback;
+        }
+
+        template<typename T>
+        static T required(const math::Optimizor::Configuration& configuration, const std::string& name)
+        {
+            auto value = find<T>(configuration, name);
+
+            if (!value) { throw std::invalid_argument("the option " + name + " is missing"); }
+            return std::move(*value);
+        }
+
+    public:
+        math::Optimizor::Objective* objective = nullptr;
+
+    //  the problem, the decisions the population starts from and the design drawing the others, uniform, latin or sobol
+        size_t scale = 0, dimension = 0, constraint = 0;
+        std::vector<std::vector<double>> initials;
+        std::string initialization;
+    //  the decisions of the sparse problems screened together when ranking their importances, zero or one probe them one by one
+        size_t screening = 0;
+    //  the seed of the random engines of the run, each component draws from its own offset, from the device if not given
+        size_t seed = 0;
+
+    //  the evolution, the distribution indexes of the variation and the fractions truly evaluated per generation
+        size_t population = 0, maximum = 0, division = 0;
+        double cross = 0, mutation = 0;
+        std::vector<double> fractions = { 0.2 };
+
+    //  the archive, the stagnation, the snapshots and the trace, zero or empty if disabled
+        size_t archive = 0, stagnation = 0, interval = 1;
+        double tolerance = 1e-4;
+        std::string checkpoint, trace;
+
+    //  the worker processes, the cache, the surrogate and the local search, zero if disabled, the local search runs every memetic
+    //  generations and sends the polls of all its searches as one batch, which the default batch operator of an objective
+    //  evaluates one by one, so the searches only run in parallel through the workers or an objective of its own batch operator
+        size_t workers = 0, cache = 0, surrogate = 0, memetic = 0, searches = 0, budget = 0;
+        double timeout = 0, quantum = 0;
+        std::string scratch, prototype;
+
+    //  the species of the coevolution, the threads run the species, or evaluate the initial population of a thread safe objective
+        size_t iteration = 1, group = 100, threads = 0;
+        std::string grouping;
+        std::vector<double> weights;
+
+    public:
+        const double* upper() const
+        {
+            return bounds_.data();
+        }
+
+        const double* lower() const
+        {
+            return bounds_.data() + scale;
+        }
+
+        const double* integer() const
+        {
+            return bounds_.data() + 2 * scale;
+        }
+
+    //  the options named in needed are required besides the problem, the others fall back to their defaults if missing,
+    //  a missing, mistyped or inconsistent option throws std::invalid_argument
+        static std::shared_ptr<const Settings> compile(const math::Optimizor::Configuration& configuration, const std::vector<std::string>& needed = {})
+        {
+            for (const auto& name : needed)
+            {
+                if (!configuration.contains(name)) { throw std::invalid_argument("the option " + name + " is missing"); }
+            }
+
+            auto settings = std::make_shared<Settings>();
+            auto& s = *settings;
+
+            s.objective = configuration.objective.get();
+            if (!s.objective) { throw std::invalid_argument("the objective is missing"); }
+
+            s.scale = required<size_t>(configuration, "scale");
+            s.dimension = required<size_t>(configuration, "dimension");
+            s.constraint = optional<size_t>(configuration, "constraint", 0);
+            s.population = required<size_t>(configuration, "population");
+
+            if (!s.scale || !s.dimension || !s.population) { throw std::invalid_argument("the scale, dimension and population must be positive"); }
+
+            auto&& upper = required<std::vector<double>>(configuration, "upper");
+            auto&& lower = required<std::vector<double>>(configuration, "lower");
+            auto&& integer = optional<std::vector<double>>(configuration, "integer", std::vector<double>(s.scale, 0.0));
+
+            if (upper.size() != s.scale || lower.size() != s.scale || integer.size() != s.scale)
+            {
+                throw std::invalid_argument("the bounds must hold a value per decision");
+            }
+
+            for (size_t i = 0; i < s.scale; ++i)
+            {
+                if (!(lower[i] <= upper[i])) { throw std::invalid_argument("the lower bound exceeds the upper one at " + std::to_string(i)); }
+            }
+
+            s.bounds_.reserve(3 * s.scale);
+            s.bounds_.insert(s.bounds_.end(), upper.begin(), upper.end());
+            s.bounds_.insert(s.bounds_.end(), lower.begin(), lower.end());
+            s.bounds_.insert(s.bounds_.end(), integer.begin(), integer.end());
+
+            s.initials = optional<std::vector<std::vector<double>>>(configuration, "initial", {});
+            for (const auto& initial : s.initials)
+            {
+                if (initial.size() != s.scale) { throw std::invalid_argument("the initial decisions must hold a value per decision"); }
+            }
+
+            s.initialization = optional<std::string>(configuration, "initialization", "uniform");
+            if (s.initialization != "uniform" && s.initialization != "latin" && s.initialization != "sobol")
+            {
+                throw std::invalid_argument("the initialization " + s.initialization + " is unknown");
+            }
+            s.screening = optional<size_t>(configuration, "screening", 0);
+            s.seed = configuration.contains("seed") ? required<size_t>(configuration, "seed") : std::random_device{}();
+
+            s.maximum = optional<size_t>(configuration, "maximum", 0);
+            s.division = optional<size_t>(configuration, "division", 0);
+            s.cross = optional<double>(configuration, "cross", 0.0);
+            s.mutation = optional<double>(configuration, "mutation", 0.0);
+
+        //  a single fraction for the whole run, or one per generation
+            if (configuration.contains("fraction"))
+            {
+                auto fractions = std::get_if<std::vector<double>>(&configuration["fraction"]);
+                s.fractions = fractions ? *fractions : std::vector<double>{ required<double>(configuration, "fraction") };
+                s.fractions = s.fractions.empty() ? std::vector<double>{ 0.2 } : s.fractions;
+            }
+
+            s.archive = optional<size_t>(configuration, "archive", 0);
+            s.stagnation = optional<size_t>(configuration, "stagnation", 0);
+            s.tolerance = optional<double>(configuration, "tolerance", 1e-4);
+            s.interval = std::max<size_t>(optional<size_t>(configuration, "interval", 1), 1);
+            s.checkpoint = optional<std::string>(configuration, "checkpoint", "");
+            s.trace = optional<std::string>(configuration, "trace", "");
+
+            s.workers = optional<size_t>(configuration, "workers", 0);
+            s.timeout = optional<double>(configuration, "timeout", 0.0);
+            s.scratch = optional<std::string>(configuration, "scratch", "");
+            s.prototype = optional<std::string>(configuration, "prototype", "");
+            s.cache = optional<size_t>(configuration, "cache", 0);
+            s.quantum = optional<double>(configuration, "quantum", 0.0);
+            s.surrogate = optional<size_t>(configuration, "surrogate", 0);
+            s.memetic = optional<size_t>(configuration, "memetic", 0);
+            s.searches = optional<size_t>(configuration, "searches", 0);
+            s.budget = optional<size_t>(configuration, "budget", 0);
+
+            s.iteration = std::max<size_t>(optional<size_t>(configuration, "iteration", 1), 1);
+            s.group = optional<size_t>(configuration, "group", 0);
+            s.group = s.group ? s.group : 100;
+            s.threads = optional<size_t>(configuration, "threads", 0);
+            s.grouping = optional<std::string>(configuration, "grouping", "");
+            s.weights = optional<std::vector<double>>(configuration, "weights", {});
+
+            if (!s.weights.empty() && s.weights.size() != s.dimension) { throw std::invalid_argument("the weights must hold a value per objective"); }
+
+            return settings;
+        }
+    };
+}
+#endif //! _math_optimization_evolutionary_settings_
@@ -0,0 +1,48 @@
+#include <vector>
+
+#include "../optimizor.h"
+
+#ifndef _math_optimization_evolutionary_sparse_
+#define _math_optimization_evolutionary_sparse_
+namespace Evolutionary
+{
+//  an objective reading the decisions as the indices and values of the active genes only, all the others are zero,
+//  the sparse algorithms call it instead of building the dense masked vectors, the dense call is still needed by the cache and the pool
+    class Sparse : public math::Optimizor::Objective
+    {
+    public:
+        using math::Optimizor::Objective::operator ();
+
+        virtual void operator () (size_t length, const size_t* indices, const double* values, double* objectives, double* voilations) = 0;
+
+        virtual ~Sparse() {}
+    };
+
+//  a sparse objective keeping a state per individual, like the sums over the active genes, so the objectives of a child
+//  follow from the state of its parent and the genes whose values differ, an inactive gene counting as zero,
+//  at the cost of the changes instead of the active genes, the rounding of the updates is left to the objective
+    class Incremental : public Sparse
+    {
+    public:
+        using Sparse::operator ();
+
+    //  the number of values of a state
+        virtual size_t states() const = 0;
+
+    //  the state and the objectives of the active genes from scratch
+        virtual void initialize(size_t length, const size_t* indices, const double* values, double* state, double* objectives, double* voilations) = 0;
+
+    //  the state of the parent updated in place by the genes changed from the values before to the values after
+        virtual void update(size_t length, const size_t* indices, const double* befores, const double* afters,
+            double* state, double* objectives, double* voilations) = 0;
+
+        virtual void operator () (size_t length, const size_t* indices, const double* values, double* objectives, double* voilations)
+        {
+            std::vector<double> state(states());
+            initialize(length, indices, values, state.data(), objectives, voilations);
+        }
+
+        virtual ~Incremental() {}
+    };
+}
+#endif //! _math_optimization_evolutionary_sparse_
@@ -0,0 +1,164 @@
+#include "sparseEA.h"
+
+void Evaluator::mask(const Individual& individual, double* row) const
+{
+    std::fill(row, row + scale_, 0.0);
+    individual.masks.visit([&individual, row](size_t i) { row[i] = individual.decisions[i]; });
+}
+
+//  only the genes active in the child or its parent may differ, those whose values are unchanged are left out
+void Evaluator::update(Individual& individual, const Individual& parent)
+{
+    indices_.clear();
+    befores_.clear();
+    values_.clear();
+
+    Evolutionary::Bitset::visit(individual.masks.bits(), parent.masks.bits(), std::bit_or<uint64_t>(), [this, &individual, &parent](size_t i)
+        {
+            double before = parent.masks.test(i) ? parent.decisions[i] : 0.0, after = individual.masks.test(i) ? individual.decisions[i] : 0.0;
+            if (before == after) { return; }
+
+            indices_.push_back(i);
+            befores_.push_back(before);
+            values_.push_back(after);
+        });
+
+    individual.state.assign(parent.state.begin(), parent.state.end());
+    incremental_->update(indices_.size(), indices_.data(), befores_.data(), values_.data(), individual.state.data(), individual.objectives, individual.voilations);
+}
+
+//  the sparse objective gets the active genes only, the incremental one the changes from a parent already holding a state,
+//  the dense one gets the masked rows by batches of a bounded memory
+void Evaluator::evaluate(const std::vector<Individual*>& individuals, const std::vector<const Individual*>& parents)
+{
+    if (sparse_)
+    {
+        for (size_t k = 0; k < individuals.size(); ++k)
+        {
+            auto individual = individuals[k];
+            auto parent = k < parents.size() ? parents[k] : nullptr;
+
+            if (incremental_ && parent && parent->state.size() == incremental_->states())
+            {
+                update(*individual, *parent);
+                continue;
+            }
+
+            indices_.clear();
+            values_.clear();
+
+            individual->masks.visit([this, individual](size_t i)
+                {
+                    indices_.push_back(i);
+                    values_.push_back(individual->decisions[i]);
+                });
+
+            if (incremental_)
+            {
+                individual->state.resize(incremental_->states());
+                incremental_->initialize(indices_.size(), indices_.data(), values_.data(), individual->state.data(), individual->objectives, individual->voilations);
+                continue;
+            }
+
+            (*sparse_)(indices_.size(), indices_.data(), values_.data(), individual->objectives, individual->voilations);
+        }
+
+        evaluations_ += individuals.size();
+        return;
+    }
+
+    size_t batch = std::max<size_t>((size_t(1) << 22) / scale_, 1);
+
+    for (size_t begin = 0; begin < individuals.size(); begin += batch)
+    {
+        size_t size = std::min(batch, individuals.size() - begin);
+
+        masked_.resize(size * scale_);
+        decisions_.resize(size);
+        objectives_.resize(size);
+        voilations_.resize(size);
+
+        for (size_t i = 0; i < size; ++i)
+        {
+            auto& individual = *individuals[begin + i];
+
+            mask(individual, &masked_[i * scale_]);
+            decisions_[i] = &masked_[i * scale_];
+            objectives_[i] = individual.objectives;
+            voilations_[i] = individual.voilations;
+        }
+
+        (*objective_)(size, decisions_.data(), objectives_.data(), voilations_.data());
+    }
+
+    evaluations_ += individuals.size();
+}
+
+//  the dense rows of a thread are zeroed again only where the previous batch wrote them
+void Evaluator::probe(const std::vector<std::vector<size_t>>& sets, const double* values, double* outcomes, size_t threads)
+{
+    size_t length = dimension_ + constraint_, parts = std::clamp<size_t>(threads, 1, std::max<size_t>(sets.size(), 1));
+    size_t part = (sets.size() + parts - 1) / parts, batch = std::max<size_t>((size_t(1) << 22) / scale_, 1);
+
+    auto task = [&, this](size_t k)
+        {
+            size_t first = std::min(k * part, sets.size()), last = std::min(first + part, sets.size());
+
+            std::vector<double> rows, actives;
+            std::vector<const double*> decisions;
+            std::vector<double*> objectives, voilations;
+
+            for (size_t i = first; sparse_ && i < last; ++i)
+            {
+                actives.resize(sets[i].size());
+                std::transform(sets[i].begin(), sets[i].end(), actives.begin(), [values](size_t j) { return values[j]; });
+                (*sparse_)(sets[i].size(), sets[i].data(), actives.data(), outcomes + i * length, outcomes + i * length + dimension_);
+            }
+
+            for (size_t begin = first; !sparse_ && begin < last; begin += batch)
+            {
+                size_t size = std::min(batch, last - begin);
+
+                rows.resize(size * scale_, 0.0);
+                decisions.resize(size);
+                objectives.resize(size);
+                voilations.resize(size);
+
+                for (size_t i = 0; i < size; ++i)
+                {
+                    double* row = &rows[i * scale_];
+                    for (auto j : sets[begin + i]) { row[j] = values[j]; }
+
+                    decisions[i] = row;
+                    objectives[i] = outcomes + (begin + i) * length;
+                    voilations[i] = objectives[i] + dimension_;
+                }
+
+                (*objective_)(size, decisions.data(), objectives.data(), voilations.data());
+
+                for (size_t i = 0; i < size; ++i)
+                {
+                    for (auto j : sets[begin + i]) { rows[i * scale_ + j] = 0.0; }
+                }
+            }
+        };
+
+    parts > 1 ? math::parallel(parts, parts, task) : task(0);
+    evaluations_ += sets.size();
+}
+
+math::Optimizor::Objective* Evaluator::objective() const
+{
+    return objective_;
+}
+
+size_t Evaluator::evaluations() const
+{
+    return evaluations_;
+}
+
+Evaluator::Evaluator(size_t scale, size_t dimension, size_t constraint, math::Optimizor::Objective* objective, bool sparse) :
+    scale_(scale), dimension_(dimension), constraint_(constraint), objective_(objective), sparse_(sparse ? dynamic_cast<Evolutionary::Sparse*>(objective) : nullptr),
+    incremental_(sparse ? dynamic_cast<Evolutionary::Incremental*>(objective) : nullptr), evaluations_(0)
+{
+}
@@ -1,20 +1,7 @@
 #include "sparseEA.h"
 
 Individual::Individual(size_t scale, size_t dimension, size_t constraint) :
-    data_(create(scale + dimension + constraint + scale)),
-    decisions(data_.get()),
-    objectives(decisions + scale),
-    voilations(objectives + dimension),
-    masks(voilations + constraint)
+    data_(math::allocate<double>(scale + dimension + constraint)),
+    decisions(data_.get()), objectives(data_.get() + scale), voilations(data_.get() + scale + dimension), masks(scale)
 {
-    std::fill(decisions, decisions + scale + dimension + constraint + scale, 0.0);
 }
-
-Individual::~Individual()
-{
-    data_.reset(nullptr);
-    decisions = nullptr;
-    objectives = nullptr;
-    voilations = nullptr;
-    masks = nullptr;
-}
\ No newline at end of file
@@ -1,17 +1,10 @@
 #include "sparseEA.h"
 
-void generate(size_t scale, double *decisions, double *upper, double *lower, double *integer)
+//  without a quantum, only the masked decisions with identical bits share the objectives
+std::unique_ptr<Evolutionary::Cache> cache(const Evolutionary::Settings& settings)
 {
-    auto temporary = create(scale);
-
-    math::sub(scale, upper, lower, temporary.get());
-    math::mul(scale, temporary.get(), decisions, decisions);
-    math::add(scale, decisions, &lower[0], decisions);
-
-    for (size_t i = 0; i < scale; ++i)
-    {
-        decisions[i] = integer[i] ? std::round(decisions[i]) : decisions[i];
-    }
+    return settings.cache ? std::make_unique<Evolutionary::Cache>(settings.objective, settings.scale, settings.dimension, settings.constraint,
+        settings.cache, settings.quantum) : nullptr;
 }
 
 Evolutionary::Selector<Individual>& Population::selector()
@@ -24,115 +17,223 @@ Evolutionary::Reproducor<Individual>& Population::reproducor()
     return *reproducor_;
 }
 
-Population::Population(math::Optimizor::Configuration& configuration) :
-    scale(std::get<size_t>(configuration["scale"])),
-    dimension(std::get<size_t>(configuration["dimension"])),
-    constraint(std::get<size_t>(configuration["constraint"])),
-    importances(new size_t[scale]),
-    selector_(std::make_unique<Reference>(configuration)), 
-    reproducor_(nullptr)
+const Evolutionary::Cache* Population::cache() const
+{
+    return cache_.get();
+}
+
+const Evaluator& Population::evaluator() const
 {
-    size_t population = std::get<size_t>(configuration["population"]);
+    return *evaluator_;
+}
 
-    std::vector<double> upper = std::get<std::vector<double>>(configuration["upper"]);
-    std::vector<double> lower = std::get<std::vector<double>>(configuration["lower"]);
-    std::vector<double> integer = std::get<std::vector<double>>(configuration["integer"]);
+//  the fronts of the probes of the sets of decisions, only the objectives of the probes are kept for the sort,
+//  a thread safe objective without a cache in front gets the probes split between the threads
+std::vector<size_t> Population::screen(const std::vector<std::vector<size_t>>& sets, const std::vector<double>& values)
+{
+    struct Probe
+    {
+        double *decisions, *objectives, *voilations;
+    };
 
-    std::vector<std::vector<double>> initials;
+    const size_t length = dimension + constraint;
 
-    try
+    std::vector<double> outcomes(sets.size() * length);
+    evaluator_->probe(sets, values.data(), outcomes.data(), cache_ ? 1 : settings_->threads);
+
+    std::vector<Probe> members(sets.size());
+
+    std::vector<std::pair<double, double>> keys(sets.size());
+
+    for (size_t i = 0; i < sets.size(); ++i)
     {
-        initials = std::get<std::vector<std::vector<double>>>(configuration["initial"]);
+        members[i] = { nullptr, &outcomes[i * length], &outcomes[i * length + dimension] };
+        keys[i] = { std::accumulate(members[i].voilations, members[i].voilations + constraint, 0.0),
+            std::accumulate(members[i].objectives, members[i].objectives + dimension, 0.0) };
     }
-    catch(...)
+
+//  a probe mostly dominates the ones of larger sums, so inserted by their sums the probes rarely push the layers down
+    std::vector<size_t> order(sets.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&keys](size_t lhs, size_t rhs) { return keys[lhs] < keys[rhs]; });
+
+    Evolutionary::Layers<Probe> layers(dimension, constraint);
+    for (auto i : order) { layers.insert(&members[i]); }
+
+    std::vector<size_t> fronts(sets.size());
+
+    size_t rank = 0;
+    for (const auto& layer : layers.fronts())
     {
+        for (const auto& probe : layer) { fronts[probe - members.data()] = rank; }
+        rank++;
     }
 
-    std::random_device seed;
-    std::mt19937_64 generator(seed());
-    std::uniform_real_distribution<double> uniform(0, 1);
+    return fronts;
+}
 
-    individuals.resize(scale);
-    std::generate(individuals.begin(), individuals.end(), [this]() { return new Individual(scale, dimension, constraint); });
+//  the importance of a decision is the front of the probe holding it alone with a random value, the lower the more important,
+//  with a screening, random groups of that many decisions are probed first and only the decisions of the best groups are probed alone,
+//  as many as there are groups, they rank ahead of the others which keep the front of their group, so about 2 * scale / screening
+//  evaluations are spent instead of scale
+void Population::score(std::mt19937_64& generator)
+{
+    size_t group = std::clamp<size_t>(settings_->screening, 1, scale);
+
+    std::vector<double> values(scale);
+    Evolutionary::sample(settings_->initialization, 1, scale, values.data(), settings_->upper(), settings_->lower(), settings_->integer(), generator);
+
+    std::vector<size_t> order(scale);
+    std::iota(order.begin(), order.end(), 0);
+    group > 1 ? std::shuffle(order.begin(), order.end(), generator) : void();
+
+    std::vector<std::vector<size_t>> groups((scale + group - 1) / group);
+    for (size_t i = 0; i < scale; ++i) { groups[i / group].push_back(order[i]); }
+
+    auto&& fronts = screen(groups, values);
 
-//  make sure that the population size is larger than the scale
-    auto temporary = create(scale);
-    for(auto individual = individuals.begin(); individual != std::next(individuals.begin(), scale); ++individual)
+    if (group == 1)
     {
-        auto masks = (*individual)->masks;
-        auto decisions = (*individual)->decisions;
-        auto objectives = (*individual)->objectives;
-        auto voilations = (*individual)->voilations;
+        for (size_t i = 0; i < scale; ++i) { importances[groups[i].front()] = fronts[i]; }
+        return;
+    }
 
-        masks[std::distance(individuals.begin(), individual)] = 1;
-        std::generate(decisions, decisions + scale, [&uniform, &generator]() { return uniform(generator); });
-        generate(scale, decisions, &upper[0], &lower[0], &integer[0]);
+    std::vector<size_t> sequence(groups.size());
+    std::iota(sequence.begin(), sequence.end(), 0);
+    std::stable_sort(sequence.begin(), sequence.end(), [&fronts](size_t lhs, size_t rhs) { return fronts[lhs] < fronts[rhs]; });
 
-        math::mul(scale, decisions, masks, temporary.get());
-        (*configuration.objective)(temporary.get(), objectives, voilations);
+    std::vector<std::vector<size_t>> singles;
+    for (auto g : sequence)
+    {
+        if (singles.size() + groups[g].size() > groups.size()) { break; }
+        for (auto decision : groups[g]) { singles.push_back({ decision }); }
     }
 
-    auto layers = selector_->sort(individuals);
-    for(auto layer = layers.begin(); layer != layers.end(); ++layer)
+    auto&& ranks = screen(singles, values);
+    size_t refined = ranks.empty() ? 0 : *std::max_element(ranks.begin(), ranks.end()) + 1;
+
+    for (size_t g = 0; g < groups.size(); ++g)
     {
-        for(const auto& individual : *layer)
-        {
-            for(size_t i = 0; i < scale; ++i)
-            {
-                if(individual->masks[i])
-                {
-                    importances[i] = std::distance(layers.begin(), layer);
-                }
-            }
-        }
+        for (auto decision : groups[g]) { importances[decision] = refined + fronts[g]; }
     }
-    reproducor_ = std::make_unique<Reproducor>(configuration, importances);
 
-    individuals.resize(population);
-    std::generate(std::next(individuals.begin(), scale), individuals.end(), [this]() { return new Individual(scale, dimension, constraint); });
-    auto initial = initials.begin();
-    for(auto individual = std::next(individuals.begin(), scale); individual != individuals.end(); ++individual)
+    for (size_t i = 0; i < singles.size(); ++i) { importances[singles[i].front()] = ranks[i]; }
+}
+
+Population::Population(std::shared_ptr<const Evolutionary::Settings> settings) :
+    settings_(std::move(settings)), cache_(::cache(*settings_)),
+    evaluator_(std::make_unique<Evaluator>(settings_->scale, settings_->dimension, settings_->constraint, cache_ ? cache_.get() : settings_->objective, !cache_)),
+    selector_(std::make_unique<Reference>(*settings_)), reproducor_(nullptr), telemetry_(nullptr),
+    scale(settings_->scale), dimension(settings_->dimension), constraint(settings_->constraint), importances(settings_->scale, 0)
+{
+    reproducor_ = std::make_unique<Reproducor>(*settings_, importances, evaluator_.get());
+
+    individuals.resize(settings_->population);
+    std::generate(individuals.begin(), individuals.end(), [this]() { return new Individual(scale, dimension, constraint); });
+}
+
+//  score the decisions, then draw the decisions of the whole population at once, the initial decisions given take the first rows,
+//  each mask gets a random number of decisions picked by binary tournaments on their importances
+void Population::evaluate()
+{
+    std::mt19937_64 generator(std::random_device{}());
+
+    score(generator);
+
+    std::vector<double> decisions(individuals.size() * scale);
+    Evolutionary::sample(settings_->initialization, individuals.size(), scale, decisions.data(),
+        settings_->upper(), settings_->lower(), settings_->integer(), generator);
+
+    for (size_t i = 0; i < std::min(settings_->initials.size(), individuals.size()); ++i)
     {
-        auto masks = (*individual)->masks;
-        auto decisions = (*individual)->decisions;
-        auto objectives = (*individual)->objectives;
-        auto voilations = (*individual)->voilations;
+        std::copy(settings_->initials[i].begin(), settings_->initials[i].end(), &decisions[i * scale]);
+    }
 
-    //  generate the decision variables
-        if(initial == initials.end())
-        {
-            std::generate(decisions, decisions + scale, [&uniform, &generator]() { return uniform(generator); });
-            generate(scale, decisions, &upper[0], &lower[0], &integer[0]);
-        }
-        else
-        {
-            math::copy(scale, &(*initial)[0], 1, decisions, 1);
-            initial++;
-        }
+    std::uniform_int_distribution<size_t> pick(0, scale - 1);
+
+    auto row = decisions.begin();
+    for (auto& individual : individuals)
+    {
+        std::copy(row, row + scale, individual->decisions);
+        row += scale;
 
-    //  generate the masks
-        size_t amount = std::uniform_int_distribution<>(0, scale - 1)(generator);
-        for(size_t i = 0; i < amount; ++i)
+        individual->masks.reset();
+        for (size_t amount = pick(generator); amount; --amount)
         {
-            size_t first = std::uniform_int_distribution<>(0, scale - 1)(generator);
-            size_t second = std::uniform_int_distribution<>(0, scale - 1)(generator);
-            
-            masks[importances[first] < importances[second] ? first : second] = 1;
+            size_t first = pick(generator), second = pick(generator);
+            individual->masks.set(importances[first] < importances[second] ? first : second);
         }
+    }
+
+    evaluator_->evaluate(std::vector<Individual*>(individuals.begin(), individuals.end()));
+}
+
+void Population::instrument(Evolutionary::Telemetry* telemetry)
+{
+    telemetry_ = telemetry;
+    selector_->instrument(telemetry);
+    reproducor_->instrument(telemetry);
+}
+
+//  the masks are saved as their words
+void Population::save(Evolutionary::Snapshot& snapshot) const
+{
+    size_t length = scale + dimension + constraint;
 
-        math::mul(scale, decisions, masks, temporary.get());
-        (*configuration.objective)(temporary.get(), objectives, voilations);
+    std::vector<double> values;
+    std::vector<uint64_t> masks;
+
+    for (const auto& individual : individuals)
+    {
+        values.insert(values.end(), individual->decisions, individual->decisions + length);
+        masks.insert(masks.end(), individual->masks.data(), individual->masks.data() + individual->masks.words());
     }
+
+    Evolutionary::store(snapshot, "population", values);
+    Evolutionary::store(snapshot, "masks", masks);
+    Evolutionary::store(snapshot, "importances", importances);
+
+    selector_->save(snapshot, individuals);
+    reproducor_->save(snapshot);
 }
 
-Population::~Population()
+//  return false if the snapshot does not match the configured population
+bool Population::restore(const Evolutionary::Snapshot& snapshot)
 {
-    delete[] importances;
-    importances = nullptr;
+    size_t length = scale + dimension + constraint;
+
+    auto&& values = Evolutionary::load<double>(snapshot, "population");
+    auto&& masks = Evolutionary::load<uint64_t>(snapshot, "masks");
+    auto&& ranks = Evolutionary::load<size_t>(snapshot, "importances");
+
+    size_t words = (*individuals.begin())->masks.words();
+
+    if (values.size() != individuals.size() * length || masks.size() != individuals.size() * words || ranks.size() != scale) { return false; }
+
+    auto value = values.begin();
+    auto mask = masks.begin();
 
+    for (auto& individual : individuals)
+    {
+        std::copy(value, value + length, individual->decisions);
+        individual->masks.assign(&*mask);
+        individual->state.clear();
+        value += length;
+        mask += words;
+    }
+
+    std::copy(ranks.begin(), ranks.end(), importances.begin());
+
+    selector_->restore(snapshot, individuals);
+    reproducor_->restore(snapshot);
+    return true;
+}
+
+Population::~Population()
+{
     for(auto& individual : individuals)
     {
         delete individual;
         individual = nullptr;
     }
-}
\ No newline at end of file
+}
@@ -2,115 +2,29 @@
 /**************************************************************************
  *  non dominated sort
  ***************************************************************/
-int dominate(size_t length, const double* lhs, const double* rhs)
-/*
- *  1 indicates lhs dominate rhs
- *  0 indicates non dominated
- * -1 indicates rhs domiantes lhs
- */
-{
-    size_t counts[3] = { 0, 0, 0 };
-
-    for (size_t i = 0; i < length; ++i)
-    {
-        counts[std::abs(lhs[i] - rhs[i]) < 1e-10 ? 1 : (lhs[i] > rhs[i] ? 0 : 2)]++;
-    }
-
-    return (counts[1] == length) ? 0 : ((!counts[0]) ? 1 : ((!counts[2]) ? -1 : 0));
-}
-
-int dominate(size_t dimension, size_t constraint, const Individual& lhs, const Individual& rhs)
-{
-//  compare the voilations of the constraints first
-//  by this way, voilations have higher priority
-    int status = dominate(constraint, lhs.voilations, rhs.voilations);
-//  compare the objectives if no constraints voilation of the two individuals
-    return status != 0 ? status : dominate(dimension, lhs.objectives, rhs.objectives);
-}
-
-std::pair<bool, std::list<Individual*>> sort(size_t dimension, size_t constraint, Individual* individual, std::list<Individual*>& current)
-{
-    auto results = std::make_pair<bool, std::list<Individual*>>(true, {});
-    auto& [status, dominated] = results;
-
-    for(auto member = current.begin(); member != current.end();)
-    {
-        auto indicator = dominate(dimension, constraint, **member, *individual);
-
-    //  theoretically, if a individual is dominated by an individual in the current layer,
-    //  the individuals dominated by this individual should not occur in this layer but the lower layers,
-    //  which means once the indicator equals to -1, the loop should be stopped.
-    //  however,  due to the equal judgement of the floating number
-    //  there are still the situations that an individual can be dominated by an individual and dominates individuals in a layer
-        status = status && (indicator != 1);
-        indicator == -1 ? dominated.push_back(*member) : void();
-        member = indicator == -1 ? current.erase(member) : std::next(member);
-    }
-
-    return results;
-}
-
-std::list<std::list<Individual*>> sort(size_t dimension, size_t constraint, const std::list<Individual*>& individuals)
-{
-    std::list<std::list<Individual*>> results = { {} };
-
-//  the non dominated sort is re-designed per bubble sort idea
-    for(const auto& individual : individuals)
-    {
-        std::list<Individual*> dominated(0);
-    //  bubble sorting loop
-        for (auto layer = results.begin(); layer != results.end(); ++layer)
-        {
-        //  status : dominating status, true if not dominated by any members in the current layer
-        //  lower : individuals dominated by the individual and moved out from the current layer
-            auto&& [status, lower] = sort(dimension, constraint, individual, *layer);
-
-        //  merge the dominated individuals to the dominated list
-            dominated.splice(dominated.end(), std::forward<std::list<Individual*>&&>(lower));
-
-            if ((!status) && std::next(layer) != results.end()) { continue; }
-
-            status ? layer->push_back(individual) : results.push_back({ individual });
-
-        //  determine the process for dominated individuals
-        //  if status is false, it means the individual has been appended to the end of results,
-        //  and the dominated individuals should be appended after the invididual
-        //  if status is true, it means the individual has been merged to the current layer,
-        //  only if there are no further layers need the individuals to be appended to the end of results,
-        //  or merge them to the next layer
-            bool append = (!status) || std::next(layer) == results.end();
-            append ? (dominated.empty() ? void() : results.push_back(dominated)) : std::next(layer)->splice(std::next(layer)->end(), dominated);
-
-        //  exit the loop
-            break;
-        }
-    }
-
-    return results;
-}
-
 std::list<std::list<Individual*>> Reference::sort(const std::list<Individual*>& population) const
 {
-//    size_t scale_, dimension_, constraint_;
-    return ::sort(dimension_, constraint_, population);
+//  only the individuals joined or overwritten since the last call are re-inserted
+    layers_.synchronize(population);
+    return layers_.fronts();
 }
 
 /**************************************************************************
  *  elite reserve selection
  ***************************************************************/
-using Association = std::list<std::tuple<Pointer, size_t, std::list<Individual*>>>;
+using Association = std::list<std::tuple<math::pointer<double>, size_t, std::list<Individual*>>>;
 
 double dot(size_t length, const double* left, const double* right)
 {
-    auto temporary = create(length);
-    math::mul(length, left, right, temporary.get());
+    auto temporary = math::allocate<double>(length);
+    math::mul(length, left, 1, right, 1, temporary.get(), 1);
 
     return std::accumulate(temporary.get(), temporary.get() + length, 0);
 }
 
 void doolittle(size_t dimension, double* matrix, double* vector)
 {
-    auto temporary =create(dimension * dimension);
+    auto temporary = math::allocate<double>(dimension * dimension);
 
     size_t row = dimension;
     size_t column = dimension;
@@ -178,21 +92,21 @@ void doolittle(size_t dimension, double* matrix, double* vector)
 //  the scalar function, asf function in the article
 double scale(size_t position, size_t dimension, const double * objective)
 {
-    auto weights = create(dimension);
+    auto weights = math::allocate<double>(dimension);
     weights[position] = 1;
 
-    math::div(dimension, objective, weights.get(), weights.get());
+    math::div(dimension, objective, 1, weights.get(), 1, weights.get(), 1);
     return *std::max_element(weights.get(), weights.get() + dimension);
 }
 
 //  compute the perpendicular distance between the objective of an individual and the reference point
 double distance(size_t length, const double * point, const double * objective)
 {
-    auto temporary =create(length);
+    auto temporary = math::allocate<double>(length);
     math::copy(length, point, 1, temporary.get(), 1);
 
     double fraction = -math::dot(length, point, 1, objective, 1) / math::dot(length, point, 1, point, 1);
-    math::xpby(length, objective, 1, fraction, temporary.get(), 1);
+    math::axpby(length, 1.0, objective, 1, fraction, temporary.get(), 1);
     return std::sqrt(math::dot(length, temporary.get(), 1, temporary.get(), 1));
 }
 
@@ -213,20 +127,20 @@ double* ideal(double* point, size_t scale, size_t dimension, const std::list<Ind
 
 double* interception(double* values, const double * ideal, size_t scale, size_t dimension, const std::list<Individual*>& individuals)
 {
-    auto cost = create(dimension), max = create(dimension),  matrix = create(dimension * dimension);
+    auto cost = math::allocate<double>(dimension), max = math::allocate<double>(dimension),  matrix = math::allocate<double>(dimension * dimension);
 
     std::vector<std::pair<double, double*>> nearest(dimension, { std::nan("0"), nullptr});
 
     for (auto& individual : individuals)
     {
-        math::sub(dimension, individual->objectives, ideal, cost.get());
+        math::sub(dimension, individual->objectives, 1, ideal, 1, cost.get(), 1);
 
         for (size_t axis = 0;  axis < dimension; ++axis)
         {
             max[axis] = std::max(cost[axis], max[axis]);
 
             double distance = ::scale(axis, dimension, cost.get());
-
+            
             if (std::isnan(nearest[axis].first) || (distance < nearest[axis].first))
             {
                 nearest[axis].first = distance;
@@ -253,8 +167,8 @@ double* interception(double* values, const double * ideal, size_t scale, size_t
 
 double* normalize(size_t dimension, double* objectives, const double* ideal, const double* interception)
 {
-    math::sub(dimension, objectives, ideal, objectives);
-    math::div(dimension, objectives, interception, objectives);
+    math::sub(dimension, objectives, 1, ideal, 1, objectives, 1);
+    math::div(dimension, objectives, 1, interception, 1, objectives, 1);
     return objectives;
 }
 
@@ -262,8 +176,8 @@ double* normalize(size_t dimension, double* objectives, const double* ideal, con
 void attach(size_t dimension, Individual* individual, const double *cost, Association &associations)
 {
     auto compare = [dimension, individual, cost](
-        const std::tuple<Pointer, size_t, std::list<Individual*>>& lhs,
-        const std::tuple<Pointer, size_t, std::list<Individual*>>& rhs)
+        const std::tuple<math::pointer<double>, size_t, std::list<Individual*>>& lhs,
+        const std::tuple<math::pointer<double>, size_t, std::list<Individual*>>& rhs)
         {
             return distance(dimension, std::get<0>(lhs).get(), cost) < distance(dimension, std::get<0>(rhs).get(), cost);
         };
@@ -275,8 +189,8 @@ void attach(size_t dimension, Individual* individual, const double *cost, Associ
 void associate(size_t dimension, Individual* individual, const double *cost, Association &associations)
 {
     auto compare = [dimension, individual, cost](
-        const std::tuple<Pointer, size_t, std::list<Individual*>> &lhs,
-        const std::tuple<Pointer, size_t, std::list<Individual*>>& rhs)
+        const std::tuple<math::pointer<double>, size_t, std::list<Individual*>> &lhs,
+        const std::tuple<math::pointer<double>, size_t, std::list<Individual*>>& rhs)
         {
             return distance(dimension, std::get<0>(lhs).get(), cost) < distance(dimension, std::get<0>(rhs).get(), cost);
         };
@@ -290,7 +204,7 @@ void Reference::dispense(size_t needed, std::list<Individual*>& elites, std::lis
     ideal(ideal_.get(), scale_, dimension_, elites);
     interception(interception_.get(), ideal_.get(), scale_, dimension_, elites);
 
-    auto cost = create(dimension_);
+    auto cost = math::allocate<double>(dimension_);
 
     for (const auto& elite : elites)
     {
@@ -340,7 +254,19 @@ void Reference::dispense(size_t needed, std::list<Individual*>& elites, std::lis
 
 std::pair<std::list<Individual*>, std::list<Individual*>> Reference::select(const std::list<Individual*>& population)
 {
-    auto layers = sort(population);
+    std::list<std::list<Individual*>> layers;
+
+    {
+        Evolutionary::Timer timer(telemetry_, Evolutionary::Phase::sort);
+        layers = sort(population);
+    }
+
+    if (telemetry_)
+    {
+        telemetry_->profile().front = layers.begin()->size();
+        telemetry_->profile().layers = layers.size();
+    }
+
     auto results = std::make_pair<>(std::move(*layers.begin()), std::list<Individual*>());
     auto& [elite, ordinary] = results;
 
@@ -357,6 +283,7 @@ std::pair<std::list<Individual*>, std::list<Individual*>> Reference::select(cons
     }
     else if(selection_ > elite.size())
     {
+        Evolutionary::Timer timer(telemetry_, Evolutionary::Phase::dispense);
         dispense(selection_ - elite.size(), elite, *layers.begin());
     }
 
@@ -368,6 +295,43 @@ std::pair<std::list<Individual*>, std::list<Individual*>> Reference::select(cons
 
     return results;
 }
+void Reference::instrument(Evolutionary::Telemetry* telemetry)
+{
+    telemetry_ = telemetry;
+}
+
+/**************************************************************************
+ *  snapshot of the layers and the order of the reference points
+ ***************************************************************/
+void Reference::save(Evolutionary::Snapshot& snapshot, const std::list<Individual*>& population) const
+{
+    layers_.save(snapshot, "reference", population);
+
+    std::vector<double> points;
+    for (const auto& [point, count, associated] : associations_)
+    {
+        points.insert(points.end(), point.get(), point.get() + dimension_);
+    }
+
+    Evolutionary::store(snapshot, "reference.points", points);
+}
+
+void Reference::restore(const Evolutionary::Snapshot& snapshot, const std::list<Individual*>& population)
+{
+    layers_.restore(snapshot, "reference", population);
+
+    auto&& points = Evolutionary::load<double>(snapshot, "reference.points");
+
+    if (points.size() != associations_.size() * dimension_) { return; }
+
+    auto point = points.begin();
+    for (auto& [pointer, count, associated] : associations_)
+    {
+        std::copy(point, point + dimension_, pointer.get());
+        point += dimension_;
+    }
+}
+
 /**************************************************************************
  *  reference plaint constructor
  ***************************************************************/
@@ -396,18 +360,19 @@ std::list<std::list<double>> permutation(size_t dimension, size_t division)
     return results;
 }
 
-Reference::Reference(const math::Optimizor::Configuration& configuration) :
-    scale_(std::get<size_t>(configuration["scale"])),
-    dimension_(std::get<size_t>(configuration["dimension"])),
-    constraint_(std::get<size_t>(configuration["constraint"])),
-    selection_(std::get<size_t>(configuration["population"]) / 2),
-    ideal_(create(dimension_)), interception_(create(dimension_))
+Reference::Reference(const Evolutionary::Settings& settings) :
+    scale_(settings.scale),
+    dimension_(settings.dimension),
+    constraint_(settings.constraint),
+    selection_(settings.population / 2),
+    ideal_(math::allocate<double>(dimension_)), interception_(math::allocate<double>(dimension_)),
+    layers_(dimension_, constraint_), telemetry_(nullptr)
 {
-    size_t division = std::get<size_t>(configuration["division"]);
+    size_t division = settings.division;
 
     for (const auto& point : permutation(dimension_, division))
     {
-        associations_.push_back(std::make_tuple<Pointer, size_t, std::list<Individual*>>(create(dimension_),  0, {}));
+        associations_.push_back(std::make_tuple<math::pointer<double>, size_t, std::list<Individual*>>(math::allocate<double>(dimension_),  0, {}));
         auto& [pointer, count, list] = *associations_.rbegin();
 
         std::copy(point.begin(), point.end(), pointer.get());
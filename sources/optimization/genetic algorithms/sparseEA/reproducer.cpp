@@ -1,155 +1,109 @@
 #include "sparseEA.h"
 
-void check(size_t scale, Individual& individual, const double* uppers, const double* lowers, const double* integers)
+//  round the active integer decisions and clip them to the bounds
+void Reproducor::check(Individual& individual)
 {
-    for(size_t i = 0;i < scale; ++i)
-    {
-        individual.decisions[i] = integers[i] ? std::round(individual.decisions[i]) : individual.decisions[i];
-        individual.decisions[i] = std::max(std::min(individual.decisions[i], uppers[i]), lowers[i]);
-    }
+    individual.masks.visit([this, &individual](size_t i)
+        {
+            double value = std::max(std::min(individual.decisions[i], upper_[i]), lower_[i]);
+            individual.decisions[i] = integer_[i] ? std::round(value) : value;
+        });
 }
 
-//  simulate binary crossover for the decision variables
-void cross(size_t scale, double exponent, std::mt19937_64& generator, std::array<const Individual*, 2> parents, std::array<Individual*, 2> children, const double * uppers, const double* lowers, const double* integers)
+//  a few random set positions are tried first, which mostly succeeds unless the masks nearly coincide,
+//  then the rank of the decision among the differing bits is drawn and located word by word
+size_t Reproducor::draw(const Evolutionary::Mask& from, const Evolutionary::Mask& other)
 {
-    const auto &father = *parents[0], &mother = *parents[1];
-    auto &son = *children[0], &daughter = * children[1];
+    if (!from.count()) { return scale_; }
 
-    auto randoms = create(scale);
-    std::generate(randoms.get(), randoms.get() + scale, [&generator](){ return std::uniform_real_distribution<>(0.0, 1.0)(generator); });
-
-    auto temporary = create(scale);
-
-    for(auto r = randoms.get(); r < randoms.get() + scale; ++r)
+    std::uniform_int_distribution<size_t> pick(0, from.count() - 1);
+    for (size_t attempt = 0; attempt < attempts_; ++attempt)
     {
-        *r = (*r < 0.5) ? 2.0 * *r : 0.5 / (1.0 - *r);
+        size_t index = from.active(pick(generator_));
+        if (!other.test(index)) { return index; }
     }
 
-    double probability = 1 / (exponent + 1);
-    math::powI(scale, randoms.get(), 1, &probability, 0, randoms.get(), 1);
-
-    math::sub(scale, father.decisions, mother.decisions, temporary.get());
-    math::mul(scale, randoms.get(), temporary.get(), temporary.get());
-
-    math::add(scale, father.decisions, mother.decisions, son.decisions);
-    math::sub(scale, son.decisions, temporary.get(), son.decisions);
-    math::scal(scale, 0.5, son.decisions, 1);
+    auto difference = [](uint64_t lhs, uint64_t rhs) { return lhs & ~rhs; };
+    size_t count = Evolutionary::Bitset::count(from.bits(), other.bits(), difference);
+    if (!count) { return scale_; }
 
-    math::add(scale, father.decisions, mother.decisions, daughter.decisions);
-    math::add(scale, daughter.decisions, temporary.get(), daughter.decisions);
-    math::scal(scale, 0.5, daughter.decisions, 1);
-
-    check(scale, son, uppers, lowers, integers);
-    check(scale, daughter, uppers, lowers, integers);
+    return Evolutionary::Bitset::select(from.bits(), other.bits(), difference, std::uniform_int_distribution<size_t>(0, count - 1)(generator_));
 }
-//  polynomial mutation for decision variables
-void mutate(size_t scale, double exponent, std::mt19937_64& generator, Individual& individual, const double* uppers, const double* lowers, const double* integers)
+
+size_t Reproducor::tournament(size_t first, size_t second, bool important) const
 {
-    auto randoms = create(scale);
-    std::generate(randoms.get(), randoms.get() + scale, [&generator]() { return std::uniform_real_distribution<>(0.0, 1.0)(generator); });
+    return (importances_[first] < importances_[second]) == important ? first : second;
+}
 
-    for (size_t i = 0; i < scale; ++i)
+//  the mask of a child starts as the one of its first parent, then either a less important decision set by the first parent only is dropped,
+//  or a more important one set by the second parent only is added, the decisions are crossed by simulated binary crossover
+void Reproducor::cross(const Individual& father, const Individual& mother, Individual& son, Individual& daughter)
+{
+    for (auto [child, first, second] : { std::make_tuple(&son, &father, &mother), std::make_tuple(&daughter, &mother, &father) })
     {
-        double weight = ((randoms[i] < 0.5) ? (uppers[i] - individual.decisions[i]) : (individual.decisions[i] - lowers[i])) / (uppers[i] - lowers[i]);
+        child->masks.assign(first->masks);
 
-        double base = std::min(randoms[i], 1 - randoms[i]);
-        base = std::pow(2 * base + (1 - 2 * base) * std::pow(weight, exponent + 1), 1.0 / (exponent + 1.0));
+        bool add = uniform_(generator_) < 0.5;
+        const auto& from = add ? second->masks : first->masks;
+        const auto& other = add ? first->masks : second->masks;
 
-        individual.decisions[i] += randoms[i] <  0.5 ? base - 1 : 1 - base;
+        size_t lhs = draw(from, other), rhs = draw(from, other);
+        lhs < scale_ ? child->masks.set(tournament(lhs, rhs, add), add) : void();
     }
 
-    check(scale, individual, uppers, lowers, integers);
-}
-
-void flip(size_t scale, double random, std::mt19937_64& generator, double * individual, const double* masks, const size_t*importances)
-{
-    std::vector<size_t> selections(0);
-
-    size_t count = 0;
-    for (size_t i = 0; i < scale; ++i)
-    {
-        count += (masks[i] == 0);
-    }
+//  the inactive decisions do not count, so only the ones active in a parent are crossed
+    Evolutionary::Bitset::visit(father.masks.bits(), mother.masks.bits(), std::bit_or<uint64_t>(), [this, &father, &mother, &son, &daughter](size_t i)
+        {
+            double random = uniform_(generator_), beta = std::pow(random < 0.5 ? 2.0 * random : 0.5 / (1.0 - random), 1.0 / (cross_ + 1.0));
+            double sum = father.decisions[i] + mother.decisions[i], difference = beta * (father.decisions[i] - mother.decisions[i]);
 
-    while(selections.size() != scale - count)
-    {
-        size_t selection = std::uniform_int_distribution<>(0, scale - 1)(generator);
-        masks[selection] ? selections.push_back(selection) : void();
-    }
+            son.decisions[i] = 0.5 * (sum - difference);
+            daughter.decisions[i] = 0.5 * (sum + difference);
+        });
 
-    switch (selections.size())
-    {
-    case 0:
-    {
-        return;
-    }
-    case 1:
-    {
-        individual[selections[0]] = 1 - individual[selections[0]];
-        return;
-    }
-    default:
-    {
-        size_t selection = (random > 0.5) - (importances[selections[0]] < importances[selections[1]]);
-        individual[selection] = 1 - individual[selection];
-        return;
-    }
-    }
+    check(son);
+    check(daughter);
 }
 
-void cross(size_t scale, std::mt19937_64& generator, std::array<const Individual*, 2> parents, std::array<Individual*, 2> children, const size_t* importances)
+//  either a less important decision set is dropped or a more important one unset is added, both drawn without a scan of the mask,
+//  the decisions by polynomial mutation
+void Reproducor::mutate(Individual& individual)
 {
-    double one = 1;
-    auto masks = create(scale);
+    bool add = uniform_(generator_) < 0.5;
+    size_t count = add ? scale_ - individual.masks.count() : individual.masks.count();
 
-    for(auto& child : children)
+    if (count)
     {
-        math::copy(scale, parents[0]->masks, 1, child->masks, 1);
+        std::uniform_int_distribution<size_t> pick(0, count - 1);
+        auto draw = [this, &individual, &pick, add]()
+            { return add ? individual.masks.inactive(generator_) : individual.masks.active(pick(generator_)); };
 
-        double random = std::uniform_real_distribution<>(0.0, 1.0)(generator);
-        math::subI(scale, &one, 0, parents[random < 0.5]->masks, 1, masks.get(), 1);
-        math::addI(scale, parents[random > 0.5]->masks, 1, masks.get(), 1, masks.get(), 1);
-
-        flip(scale, random < 0.5, generator, child->masks, masks.get(), importances);
+        size_t first = draw(), second = draw();
+        individual.masks.set(tournament(first, second, add), add);
     }
-}
 
-void mutate(size_t scale, std::mt19937_64& generator, Individual& individual, const size_t* importances)
-{
-    auto masks = create(scale);
-    double one = 1.0, random = std::uniform_real_distribution<>(0.0, 1.0)(generator);
-    random < 0.5 ? math::copy<double>(scale, individual.masks, 1, masks.get(), 1) : math::subI(scale, &one, 0, individual.masks, 1, masks.get(), 1);
-    flip(scale, random < 0.5, generator, individual.masks, masks.get(), importances);
-}
+//  only the active decisions are mutated
+    individual.masks.visit([this, &individual](size_t i)
+        {
+            double random = uniform_(generator_), range = upper_[i] - lower_[i];
+            double weight = range > 0 ? ((random < 0.5) ? (upper_[i] - individual.decisions[i]) : (individual.decisions[i] - lower_[i])) / range : 0.0;
 
-//  simulated binary crossover
-void Reproducor::cross(const Individual& father, const Individual& mother, Individual& son, Individual& daughter)
-{
-//  cross the masks
-    ::cross(scale_, generator_, { &father, &mother },  { &son, &daughter }, importances_);
-//  cross the decisions
-    ::cross(scale_, cross_, generator_, { &father, &mother }, { &son, &daughter }, upper_.get(), lower_.get(), integer_.get());
-}
+            double base = std::min(random, 1 - random);
+            base = std::pow(2 * base + (1 - 2 * base) * std::pow(weight, mutation_ + 1), 1.0 / (mutation_ + 1.0));
 
-void Reproducor::mutate(Individual& individual)
-{
-//  mutate the masks
-    ::mutate(scale_, generator_, individual, importances_);
-//  mutate the decision variables
-    ::mutate(scale_, mutation_, generator_, individual, upper_.get(), lower_.get(), integer_.get());
-}
+            individual.decisions[i] += random < 0.5 ? base - 1 : 1 - base;
+        });
 
-void Reproducor::check(Individual& individual)
-{
-    assert((void("not implemented!"), true));
+    check(individual);
 }
 
 std::list<Individual*> Reproducor::reproduce(std::pair<std::list<Individual*>, std::list<Individual*>>&& population)
 {
-    auto temporary = create(scale_);
     auto& [elites, ordinaries] = population;
 
     std::list<Individual*> offsprings = {};
+    std::vector<Individual*> children;
+    std::vector<const Individual*> parents;
 
 //  by this way, elites will not be more than ordinaries
     if (elites.size() % 2)
@@ -158,44 +112,57 @@ std::list<Individual*> Reproducor::reproduce(std::pair<std::list<Individual*>, s
         elites.pop_back();
     }
 
-    ordinaries.reverse();
-    for(auto iter = elites.begin(); iter != elites.end() && !ordinaries.empty(); iter = std::next(iter, 2))
     {
-        cross(**iter, **std::next(iter), **ordinaries.begin(), **std::next(ordinaries.begin()));
+        Evolutionary::Timer timer(telemetry_, Evolutionary::Phase::variation);
 
-        for (size_t i = 0; i < 2;  ++i)
+        ordinaries.reverse();
+        for(auto iter = elites.begin(); iter != elites.end() && ordinaries.size() > 1; iter = std::next(iter, 2))
         {
-            auto& child = **std::next(ordinaries.begin(), i);
-            std::uniform_real_distribution<>(0.0, 1.0)(generator_) > threshold_ ? mutate(child) : void();
+            cross(**iter, **std::next(iter), **ordinaries.begin(), **std::next(ordinaries.begin()));
+
+            for (size_t i = 0; i < 2;  ++i)
+            {
+                auto& child = **std::next(ordinaries.begin(), i);
+                uniform_(generator_) > threshold_ ? mutate(child) : void();
+                children.push_back(&child);
+                parents.push_back(i ? *std::next(iter) : *iter);
+            }
 
-            math::mul(scale_, child.decisions, child.masks, temporary.get());
-            (*function_)(temporary.get(), child.objectives, child.voilations);
+            offsprings.splice(offsprings.end(), ordinaries, ordinaries.begin(), std::next(ordinaries.begin(), 2));
         }
+    }
 
-        offsprings.splice(offsprings.end(), ordinaries, ordinaries.begin(), std::next(ordinaries.begin(), 2));
+    {
+        Evolutionary::Timer timer(telemetry_, Evolutionary::Phase::evaluation);
+        evaluator_->evaluate(children, parents);
     }
 
+    if (telemetry_) { telemetry_->profile().evaluations += children.size(); }
+
     elites.splice(elites.end(), offsprings);
     elites.splice(elites.end(), ordinaries);
     return elites;
 }
 
-Reproducor::Reproducor(math::Optimizor::Configuration& configuration, size_t *importances) :
-    scale_(std::get<size_t>(configuration["scale"])), dimension_(std::get<size_t>(configuration["dimension"])),
-    cross_(std::get<double>(configuration["cross"])), mutation_(std::get<double>(configuration["mutation"])), threshold_(0.8),
-    upper_(create(scale_)), lower_(create(scale_)), integer_(create(scale_)),
-    function_(configuration.objective.get()), generator_(std::random_device()()), importances_(importances)
+void Reproducor::instrument(Evolutionary::Telemetry* telemetry)
 {
-    for(auto& [name, pointer] :
-        std::map<std::string, double*>{ { "upper", upper_.get() }, { "lower", lower_.get() }, { "integer", integer_.get() } })
-    {
-        const auto& value = std::get<std::vector<double>>(configuration[name]);
-        std::copy(value.begin(), value.end(), pointer);
-    }
+    telemetry_ = telemetry;
 }
 
-Reproducor::~Reproducor()
+void Reproducor::save(Evolutionary::Snapshot& snapshot) const
 {
-    importances_ = nullptr;
-    function_ = nullptr;
-}
\ No newline at end of file
+    Evolutionary::serialize(snapshot, "reproducor", generator_, uniform_);
+}
+
+void Reproducor::restore(const Evolutionary::Snapshot& snapshot)
+{
+    Evolutionary::deserialize(snapshot, "reproducor", generator_, uniform_);
+}
+
+Reproducor::Reproducor(const Evolutionary::Settings& settings, const std::vector<size_t>& importances, Evaluator* evaluator) :
+    scale_(settings.scale), dimension_(settings.dimension), constraint_(settings.constraint),
+    cross_(settings.cross), mutation_(settings.mutation), threshold_(0.8),
+    upper_(settings.upper()), lower_(settings.lower()), integer_(settings.integer()),
+    importances_(importances), evaluator_(evaluator), telemetry_(nullptr), generator_(std::random_device()()), uniform_(0, 1)
+{
+}
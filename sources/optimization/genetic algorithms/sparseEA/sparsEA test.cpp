@@ -1,6 +1,8 @@
 #include <iostream>
 #include <fstream>
-#include "sparseea.h"
+#include <atomic>
+#include <numeric>
+#include "sparseEA.h"
 
 class Objective : public math::Optimizor::Objective
 {
@@ -8,11 +10,11 @@ private:
 	size_t decisions_ = 2;
 
 public:
-	virtual void operator() (const double * decisions, double * objectives, double * voilation)
+	virtual void operator() (const double * decisions, double * objectives, double *)
 	{
 		objectives[0] = 0;
 
-		for (long i = 0; i < decisions_; ++i)
+		for (size_t i = 0; i < decisions_; ++i)
 		{
 			objectives[0] += pow(decisions[i] - 1 / sqrt(decisions_), 2);
 		}
@@ -21,7 +23,7 @@ public:
 
 		objectives[1] = 0;
 
-		for (long i = 0; i < decisions_; ++i)
+		for (size_t i = 0; i < decisions_; ++i)
 		{
 			objectives[1] += pow(decisions[i] + 1 / sqrt(decisions_), 2);
 		}
@@ -31,28 +33,240 @@ public:
 	}
 };
 
-int main()
+//	the same objectives kept as the sums of the squared distances to the two optima, updated from the state of the parent
+class Incremental : public Evolutionary::Incremental
+{
+private:
+	size_t decisions_ = 2;
+
+	void finish(const double* state, double* objectives)
+	{
+		objectives[0] = 1 - exp(-state[0]);
+		objectives[1] = 1 - exp(-state[1]);
+	}
+
+public:
+	virtual void operator() (const double * decisions, double * objectives, double * voilation)
+	{
+		::Objective()(decisions, objectives, voilation);
+	}
+
+	virtual size_t states() const
+	{
+		return 2;
+	}
+
+//	the inactive decisions are zero, each at a squared distance of 1 / decisions from both optima
+	virtual void initialize(size_t length, const size_t*, const double* values, double* state, double* objectives, double*)
+	{
+		state[0] = state[1] = 1.0;
+
+		for (size_t i = 0; i < length; ++i)
+		{
+			state[0] += pow(values[i] - 1 / sqrt(decisions_), 2) - 1 / double(decisions_);
+			state[1] += pow(values[i] + 1 / sqrt(decisions_), 2) - 1 / double(decisions_);
+		}
+
+		finish(state, objectives);
+	}
+
+	virtual void update(size_t length, const size_t*, const double* befores, const double* afters, double* state, double* objectives, double*)
+	{
+		for (size_t i = 0; i < length; ++i)
+		{
+			state[0] += pow(afters[i] - 1 / sqrt(decisions_), 2) - pow(befores[i] - 1 / sqrt(decisions_), 2);
+			state[1] += pow(afters[i] + 1 / sqrt(decisions_), 2) - pow(befores[i] + 1 / sqrt(decisions_), 2);
+		}
+
+		finish(state, objectives);
+	}
+};
+
+//	the same objectives from the active genes only, for any number of decisions
+class Sparse : public Evolutionary::Sparse
+{
+private:
+	size_t decisions_;
+
+public:
+	virtual void operator() (const double * decisions, double * objectives, double * voilation)
+	{
+		std::vector<size_t> indices(decisions_);
+		std::iota(indices.begin(), indices.end(), 0);
+
+		(*this)(decisions_, indices.data(), decisions, objectives, voilation);
+	}
+
+	virtual void operator() (size_t length, const size_t*, const double* values, double* objectives, double*)
+	{
+		double distances[2] = { 1.0, 1.0 };
+
+		for (size_t i = 0; i < length; ++i)
+		{
+			distances[0] += pow(values[i] - 1 / sqrt(decisions_), 2) - 1 / double(decisions_);
+			distances[1] += pow(values[i] + 1 / sqrt(decisions_), 2) - 1 / double(decisions_);
+		}
+
+		objectives[0] = 1 - exp(-distances[0]);
+		objectives[1] = 1 - exp(-distances[1]);
+	}
+
+public:
+	Sparse(size_t decisions) : decisions_(decisions)
+	{
+	}
+};
+
+//	the bits past the size of a set are masked in the combinations, the sets span two words and a part of a third here
+bool bitset()
+{
+	Evolutionary::Bitset lhs(150), rhs(150);
+	for (size_t i = 0; i < 150; i += 3) { lhs.set(i); }
+	for (size_t i = 0; i < 150; i += 5) { rhs.set(i); }
+
+	auto neither = [](uint64_t lhs, uint64_t rhs) { return ~lhs & ~rhs; };
+
+	size_t count = 0, last = 0;
+	Evolutionary::Bitset::visit(lhs, rhs, neither, [&count, &last](size_t index) { count++; last = index; });
+
+	return lhs.count() == 50 && rhs.count() == 30 && count == 80 && last == 149 &&
+		Evolutionary::Bitset::count(lhs, rhs, neither) == 80 &&
+		Evolutionary::Bitset::select(lhs, rhs, neither, 79) == 149 && Evolutionary::Bitset::select(lhs, rhs, neither, 80) == 150;
+}
+
+//	a few planted decisions lower both objectives by far once they are not zero, the others raise them a little, the evaluations counted
+class Planted : public math::Optimizor::Objective
+{
+private:
+	size_t decisions_;
+
+public:
+	std::vector<size_t> actives = { 7, 123, 256, 399 };
+	std::atomic<size_t> evaluations = 0;
+
+	virtual void operator() (const double * decisions, double * objectives, double *)
+	{
+		evaluations++;
+		objectives[0] = objectives[1] = 2;
+
+		for (size_t i = 0; i < decisions_; ++i)
+		{
+			bool active = std::find(actives.begin(), actives.end(), i) != actives.end();
+			objectives[0] += active ? (decisions[i] != 0 ? -100.0 : 0.0) : decisions[i] * decisions[i];
+			objectives[1] += active ? (decisions[i] != 0 ? -100.0 : 0.0) : std::abs(decisions[i]);
+		}
+	}
+
+public:
+	Planted(size_t decisions) : decisions_(decisions)
+	{
+	}
+};
+
+//	with a screening of 8, the 400 decisions are probed by 50 groups and at most 50 of them alone, instead of 400, and the planted
+//	decisions, whose groups lead the fronts, rank ahead of all the others
+bool screening()
+{
+	const size_t scale = 400, screening = 8, population = 10;
+
+	math::Optimizor::Configuration configuration;
+	auto objective = std::make_unique<Planted>(scale);
+	auto planted = objective.get();
+	configuration.objective = std::move(objective);
+
+	configuration["scale"] = scale;
+	configuration["dimension"] = size_t(2);
+	configuration["upper"] = std::vector<double>(scale, 1.0);
+	configuration["lower"] = std::vector<double>(scale, -1.0);
+	configuration["cross"] = 0.8;
+	configuration["mutation"] = 0.8;
+	configuration["maximum"] = size_t(1);
+	configuration["division"] = size_t(10);
+	configuration["population"] = population;
+	configuration["screening"] = screening;
+
+	Population members(Evolutionary::Settings::compile(configuration, { "cross", "mutation", "division", "maximum" }));
+	members.evaluate();
+
+	size_t probes = planted->evaluations - population, groups = scale / screening;
+	if (probes <= groups || probes > 2 * groups) { return false; }
+
+	size_t worst = 0, best = SIZE_MAX;
+	for (size_t i = 0; i < scale; ++i)
+	{
+		bool active = std::find(planted->actives.begin(), planted->actives.end(), i) != planted->actives.end();
+		active ? void(worst = std::max(worst, members.importances[i])) : void(best = std::min(best, members.importances[i]));
+	}
+
+	return worst < best;
+}
+
+//	a run of the optimizer on the decisions within [-1, 1]
+math::Optimizor::Result& run(math::Optimizor& optimizer, std::unique_ptr<math::Optimizor::Objective> objective, size_t scale, size_t population, size_t maximum)
 {
 	std::unique_ptr<math::Optimizor::Configuration> config = std::make_unique<math::Optimizor::Configuration>();
-	config->objective = std::make_unique<Objective>();
+	config->objective = std::move(objective);
 
-	(*config)["scale"] = size_t(2);
+	(*config)["scale"] = scale;
 	(*config)["dimension"] = size_t(2);
 	(*config)["constraint"] = size_t(0);
 
-	(*config)["upper"] = std::vector<double>{ 1.0, 1.0 };
-	(*config)["lower"] = std::vector<double>{ -1.0, -1.0 };
-	(*config)["integer"] = std::vector<double>{ 0.0, 0.0 };
+	(*config)["upper"] = std::vector<double>(scale, 1.0);
+	(*config)["lower"] = std::vector<double>(scale, -1.0);
+	(*config)["integer"] = std::vector<double>(scale, 0.0);
 
 	(*config)["cross"] = 0.8;
 	(*config)["mutation"] = 0.8;
-	(*config)["maximum"] = size_t(100);
+	(*config)["maximum"] = maximum;
 	(*config)["division"] = size_t(10);
-	(*config)["population"] = size_t(1000);
+	(*config)["population"] = population;
+
+	return optimizer.optimize(*config);
+}
+
+//	the objectives of the results against those of their masked decisions evaluated as a dense row
+bool check(math::Optimizor::Result& result, math::Optimizor::Objective& objective, size_t scale)
+{
+	auto results = result.results();
+	double objectives[2];
+
+	for (const auto& row : results)
+	{
+		objective(row.get(), objectives, nullptr);
+		if (std::abs(objectives[0] - row[scale]) > 1e-9 || std::abs(objectives[1] - row[scale + 1]) > 1e-9) { return false; }
+	}
+
+	return !results.empty();
+}
+
+int main()
+{
+	register_sparseEA();
+
+	if (!bitset()) { std::cout << "the bits past the size of a set were combined" << std::endl; return 1; }
+	if (!screening()) { std::cout << "the screening spent another number of probes or missed the planted decisions" << std::endl; return 1; }
+
+	std::unique_ptr<math::Optimizor> optimizer = math::Registry::instance().create("sparseEA");
+	if (!optimizer) { return 1; }
+
+//	the dense rows of a plain objective
+	run(*optimizer, std::make_unique<Objective>(), 2, 1000, 100).write("results.txt", 0);
+
+//	the objectives updated over the generations from the states of the parents, against a dense evaluation of the final front
+	Objective objective;
+	if (!check(run(*optimizer, std::make_unique<Incremental>(), 2, 1000, 100), objective, 2))
+	{
+		std::cout << "the incremental evaluations drifted from the dense ones" << std::endl;
+		return 1;
+	}
+
+//	the masks span more than a word, the last one partly
+	Sparse sparse(100);
+	if (!check(run(*optimizer, std::make_unique<Sparse>(100), 100, 100, 50), sparse, 100))
+	{
+		std::cout << "the sparse evaluations differ from the dense ones" << std::endl;
+		return 1;
+	}
 
-	std::unique_ptr<math::Optimizor> optimizer = std::make_unique<SparseEA>();
-	auto& results = optimizer->optimize(*config);
-	results.write("results.txt");
-	std::cout << "hello" << std::endl;
 	return 0;
 };
@@ -1,14 +1,13 @@
 #include "sparseEA.h"
 
-extern "C" __declspec(dllexport) void* __cdecl construct()
+#ifdef STATIC_OPTIMIZOR
+REGISTER_OPTIMIZOR(sparseEA, []() -> void* { return static_cast<math::Optimizor*>(new SparseEA()); })
+#else
+extern "C" EXPORT void* construct()
 {
-	return new SparseEA();
-}
-
-Pointer create(size_t length)
-{
-	return Pointer(math::allocate<double>(length), math::free<double>);
+	return static_cast<math::Optimizor*>(new SparseEA());
 }
+#endif
 
 void SparseEA::evolve(size_t generation)
 {
@@ -16,48 +15,204 @@ void SparseEA::evolve(size_t generation)
 	auto& selector = population_->selector();
 	auto& reproducor = population_->reproducor();
 
+	auto telemetry = telemetry_.empty() ? nullptr : &telemetry_;
+	auto hits = [this]() { return population_->cache() ? population_->cache()->hits() : 0; };
+
 	for (size_t i = 0; i < generation; ++i)
 	{
-		std::cout << "executing the " << i << " th generation" << std::endl;
+		telemetry ? telemetry->begin(generation_ + 1, hits()) : void();
+
 		individuals = reproducor.reproduce(selector.select(individuals));
+
+		{
+			::Evolutionary::Timer timer(telemetry, ::Evolutionary::Phase::archive);
+			archive(individuals);
+		}
+
+		bool status = false;
+
+		{
+			::Evolutionary::Timer timer(telemetry, ::Evolutionary::Phase::monitor);
+			status = converged(individuals);
+		}
+
+		generation_++;
+
+	//	the snapshot is taken once the generation is complete, the last one is always kept
+		if (checkpoint_ && (generation_ % interval_ == 0 || status))
+		{
+			::Evolutionary::Timer timer(telemetry, ::Evolutionary::Phase::checkpoint);
+			save(checkpoint_->buffer());
+			checkpoint_->commit();
+		}
+
+		telemetry ? telemetry->end(hits()) : void();
+
+		if (status) { break; }
 	}
 }
 
-void SparseEA::write(const char* filepath)
+void SparseEA::save(::Evolutionary::Snapshot& snapshot) const
 {
-	std::ofstream file(filepath);
+	::Evolutionary::serialize(snapshot, "generation", generation_);
+	population_->save(snapshot);
 
-	auto& individuals = population_->individuals;
-	auto& selector = population_->selector();
+	archive_ ? archive_->save(snapshot, "archive") : void();
+	monitor_ ? monitor_->save(snapshot, "monitor") : void();
+}
+
+bool SparseEA::restore(const ::Evolutionary::Snapshot& snapshot)
+{
+	if (!population_->restore(snapshot)) { return false; }
 
-	auto&& layers = selector.sort(individuals);
+	::Evolutionary::deserialize(snapshot, "generation", generation_);
+
+	archive_ ? archive_->restore(snapshot, "archive") : void();
+	monitor_ ? monitor_->restore(snapshot, "monitor") : void();
+	return true;
+}
+
+//	the archive keeps the masked decisions
+void SparseEA::archive(const std::list<Individual*>& individuals)
+{
+	if (!archive_) { return; }
+
+	std::vector<double> masked(population_->scale);
+
+	for (const auto& individual : individuals)
+	{
+		population_->evaluator().mask(*individual, masked.data());
+		archive_->insert(masked.data(), individual->objectives, individual->voilations);
+	}
+
+	archive_->prune();
+}
+
+bool SparseEA::converged(const std::list<Individual*>& individuals)
+{
+	if (!monitor_) { return false; }
+
+	auto&& layers = population_->selector().sort(individuals);
+
+	std::list<const double*> front;
 	for (const auto& individual : *layers.begin())
-		//	for (const auto& individual : individuals_)
 	{
-		for (size_t i = 0; i < population_->scale; ++i)
-		{
-			file << individual->decisions[i] * individual->masks[i]<< "\t";
-		}
+		front.push_back(individual->objectives);
+	}
 
-		for (size_t i = 0; i < population_->dimension; ++i)
-		{
-			file << individual->objectives[i] << "\t";
-		}
+	return monitor_->update(front);
+}
+
+void SparseEA::write(const char* filepath, char mode)
+{
+	results();
 
-		for (size_t i = 0; i < population_->constraint; ++i)
+	std::vector<::Evolutionary::Row> rows;
+	for (const auto& elite : elites_)
+	{
+		auto decisions = elite.get(), objectives = decisions + population_->scale, voilations = objectives + population_->dimension;
+		rows.push_back({ decisions, objectives, voilations });
+	}
+
+	bool status = ::Evolutionary::Writer(population_->scale, population_->dimension, population_->constraint).write(filepath, mode, rows);
+	if (!status) { throw std::runtime_error(std::string("the results could not be written to ") + filepath); }
+}
+
+//	the decisions of the first front are copied out masked, with their objectives and voilations
+std::list<std::shared_ptr<const double[]>> SparseEA::results()
+{
+	elites_.clear();
+
+	if (archive_)
+	{
+	//	the aliasing pointers keep the archived members alive
+		for (const auto& member : archive_->members())
 		{
-			file << individual->voilations[i] << "\t";
+			elites_.emplace_back(std::shared_ptr<const double[]>(member, member.get()));
 		}
 
-		file << std::endl;
+		return elites_;
+	}
+
+	size_t scale = population_->scale, length = scale + population_->dimension + population_->constraint;
+	auto&& layers = population_->selector().sort(population_->individuals);
+
+	for (const auto& individual : *layers.begin())
+	{
+		auto values = std::shared_ptr<double[]>(new double[length]);
+
+		population_->evaluator().mask(*individual, values.get());
+		std::copy(individual->objectives, individual->objectives + length - scale, values.get() + scale);
+		elites_.emplace_back(std::move(values));
 	}
 
-	file.close();
+	return elites_;
+}
+
+//	the options of the selection and the variation are needed besides the problem
+std::shared_ptr<const ::Evolutionary::Settings> compile(const math::Optimizor::Configuration& configuration)
+{
+	return ::Evolutionary::Settings::compile(configuration, { "cross", "mutation", "division", "maximum" });
+}
+
+void SparseEA::configure(std::shared_ptr<const ::Evolutionary::Settings> settings)
+{
+	if (!settings->division) { throw std::invalid_argument("the option division must be positive"); }
+
+	population_ = std::make_unique<Population>(settings);
+
+	archive_ = settings->archive ? std::make_unique<::Evolutionary::Archive>(settings->scale, settings->dimension, settings->constraint, settings->archive) : nullptr;
+
+//	the run stops once the indicators improve less than the tolerance for the given generations
+	monitor_ = settings->stagnation ? std::make_unique<::Evolutionary::Monitor>(settings->dimension, settings->division,
+		settings->stagnation, settings->tolerance) : nullptr;
+
+//	a snapshot is written every interval generations if the path is given
+	checkpoint_ = settings->checkpoint.empty() ? nullptr : std::make_unique<::Evolutionary::Checkpoint>(settings->checkpoint);
+	interval_ = settings->interval;
+	generation_ = 0;
+
+//	the profiles of the generations are traced as json lines if the path is given
+	telemetry_.trace(settings->trace);
+	population_->instrument(telemetry_.empty() ? nullptr : &telemetry_);
 }
 
 math::Optimizor::Result& SparseEA::optimize(math::Optimizor::Configuration& configuration)
 {
-	population_ = std::make_unique<Population>(configuration);
-	evolve(std::get<size_t>(configuration["maximum"]));
+	return optimize(compile(configuration));
+}
+
+math::Optimizor::Result& SparseEA::optimize(std::shared_ptr<const ::Evolutionary::Settings> settings)
+{
+	configure(settings);
+
+	population_->evaluate();
+	archive(population_->individuals);
+
+	evolve(settings->maximum);
+
+	checkpoint_ ? void(checkpoint_->flush()) : void();
+	return *this;
+}
+
+math::Optimizor::Result& SparseEA::resume(const char* path, math::Optimizor::Configuration& configuration)
+{
+	return resume(path, compile(configuration));
+}
+
+math::Optimizor::Result& SparseEA::resume(const char* path, std::shared_ptr<const ::Evolutionary::Settings> settings)
+{
+	configure(settings);
+
+//	a missing or mismatched snapshot starts a new run
+	if (!restore(::Evolutionary::Checkpoint::read(path)))
+	{
+		population_->evaluate();
+		archive(population_->individuals);
+	}
+
+	evolve(settings->maximum > generation_ ? settings->maximum - generation_ : 0);
+
+	checkpoint_ ? void(checkpoint_->flush()) : void();
 	return *this;
-}
\ No newline at end of file
+}
@@ -16,8 +16,15 @@
 #include <utility>
 #include <vector>
 
-#include "../../../basic/math.h"
+#include "../../../math.h"
+#include "../../registry.h"
+#include "../../parallel.h"
 #include "../evolutionary.h"
+#include "../layers.h"
+#include "../cache.h"
+#include "../sampling.h"
+#include "../mask.h"
+#include "../sparse.h"
 
 /*
  *  article information :
@@ -27,29 +34,72 @@
 
 #ifndef _math_optimization_evolutionary_sparseEA_
 #define _math_optimization_evolutionary_sparseEA_
-using Pointer = std::unique_ptr<double[], decltype(&math::free<double>)>;
-Pointer create(size_t length);
-
+//	the decisions are dense, the masks packed bits along with their set positions, a decision is active only if its mask is set
 class Individual
 {
 private:
-	Pointer data_;
+	math::pointer<double> data_;
+
 public:
-	double *decisions, *objectives, *voilations, *masks;
+	double *decisions, *objectives, *voilations;
+	Evolutionary::Mask masks;
+//	the state of an incremental objective, empty until the individual is evaluated through one
+	std::vector<double> state;
 
 public:
 	Individual(size_t scale, size_t dimension, size_t constraint);
-	~Individual();
+};
+
+//	evaluates the individuals as one batch of masked decisions, or gene by gene through a sparse objective,
+//	or from the state of their parents through an incremental one, the buffers are kept between the calls
+class Evaluator
+{
+private:
+	size_t scale_, dimension_, constraint_;
+	math::Optimizor::Objective *objective_;
+	Evolutionary::Sparse *sparse_;
+	Evolutionary::Incremental *incremental_;
+
+	std::vector<double> masked_, values_, befores_;
+	std::vector<size_t> indices_;
+	std::vector<const double*> decisions_;
+	std::vector<double*> objectives_, voilations_;
+	size_t evaluations_;
+
+private:
+	void update(Individual& individual, const Individual& parent);
+
+public:
+//	the parents, if given, are the ones of the individuals at the same positions, null for none
+	void evaluate(const std::vector<Individual*>& individuals, const std::vector<const Individual*>& parents = {});
+
+//	the objectives then the voilations of each set of decisions active alone at their values, one row per set,
+//	the sets are split between the threads, each with its own buffers, so only a thread safe objective may take more than one
+	void probe(const std::vector<std::vector<size_t>>& sets, const double* values, double* outcomes, size_t threads);
+
+//	the masked decisions of the individual into the dense row
+	void mask(const Individual& individual, double* row) const;
+
+	math::Optimizor::Objective* objective() const;
+	size_t evaluations() const;
+
+public:
+//	the sparse path is taken if the objective is sparse and nothing, like a cache, stands in front of it
+	Evaluator(size_t scale, size_t dimension, size_t constraint, math::Optimizor::Objective* objective, bool sparse);
 };
 
 class Reference : public Evolutionary::Selector<Individual>
 {
 private:
-	size_t dimension_, scale_, constraint_, selection_;
-	Pointer ideal_, interception_;
+	size_t scale_, dimension_, constraint_, selection_;
+	math::pointer<double> ideal_, interception_;
 
 //	simplified reference plain
-	std::list<std::tuple<Pointer, size_t, std::list<Individual*>>> associations_;
+	std::list<std::tuple<math::pointer<double>, size_t, std::list<Individual*>>> associations_;
+
+//	non dominated layers kept across the generations
+	mutable Evolutionary::Layers<Individual> layers_;
+	Evolutionary::Telemetry* telemetry_;
 
 private:
 	void dispense(size_t needed, std::list<Individual*>& elites, std::list<Individual*>& cirticals);
@@ -59,67 +109,135 @@ public:
 	virtual std::pair<std::list<Individual*>, std::list<Individual*>> select(const std::list<Individual*>& population);
 
 public:
-	Reference(const math::Optimizor::Configuration& configuration);
+	void instrument(Evolutionary::Telemetry* telemetry);
+	void save(Evolutionary::Snapshot& snapshot, const std::list<Individual*>& population) const;
+	void restore(const Evolutionary::Snapshot& snapshot, const std::list<Individual*>& population);
+
+public:
+	Reference(const Evolutionary::Settings& settings);
 	virtual ~Reference() {}
 };
 
 class Reproducor : public Evolutionary::Reproducor<Individual>
 {
 private:
-	size_t scale_, dimension_, *importances_;
+	size_t scale_, dimension_, constraint_;
 	double cross_, mutation_, threshold_;
-	Pointer upper_, lower_, integer_;
-	math::Optimizor::Objective *function_;
+//	the bounds shared by the settings, and the ranks of the decisions, the lower the more important
+	const double *upper_, *lower_, *integer_;
+	const std::vector<size_t>& importances_;
+	Evaluator *evaluator_;
+	Evolutionary::Telemetry* telemetry_;
+
+//	the random positions tried before the exact selection over the words
+	static constexpr size_t attempts_ = 4;
 
 private:
 	std::mt19937_64 generator_;
+	std::uniform_real_distribution<double> uniform_;
 
 private:
 	virtual void check(Individual& individuals);
 	virtual void cross(const Individual& father, const Individual& mother, Individual& son, Individual& daughter);
 	virtual void mutate(Individual& individua);
 
+//	a random decision set in the mask but not in the other, the scale if there is none
+	size_t draw(const Evolutionary::Mask& from, const Evolutionary::Mask& other);
+//	binary tournament between the two decisions, the more important one or the less
+	size_t tournament(size_t first, size_t second, bool important) const;
+
 private:
 	virtual std::list<Individual*> reproduce(std::pair<std::list<Individual*>, std::list<Individual*>>&& population);
 
 public:
-	Reproducor(math::Optimizor::Configuration& configuration, size_t *importances);
-	virtual ~Reproducor();
+	void instrument(Evolutionary::Telemetry* telemetry);
+	void save(Evolutionary::Snapshot& snapshot) const;
+	void restore(const Evolutionary::Snapshot& snapshot);
+
+public:
+	Reproducor(const Evolutionary::Settings& settings, const std::vector<size_t>& importances, Evaluator* evaluator);
+	virtual ~Reproducor() {}
 };
 
 class Population : public Evolutionary::Population<Individual>
 {
 private:
+//	the compiled configuration, whose bounds the components share
+	std::shared_ptr<const Evolutionary::Settings> settings_;
+//	evaluation cache in front of the objective, null if disabled
+	std::unique_ptr<Evolutionary::Cache> cache_;
+	std::unique_ptr<Evaluator> evaluator_;
 	std::unique_ptr<Reference> selector_;
 	std::unique_ptr<Reproducor> reproducor_;
+	Evolutionary::Telemetry* telemetry_;
+
+private:
+	std::vector<size_t> screen(const std::vector<std::vector<size_t>>& sets, const std::vector<double>& values);
+	void score(std::mt19937_64& generator);
 
 public:
 	virtual Evolutionary::Selector<Individual>& selector();
 	virtual Evolutionary::Reproducor<Individual>& reproducor();
+	const Evolutionary::Cache* cache() const;
+	const Evaluator& evaluator() const;
+
+//	evaluate the initial individuals, which is skipped when the population is restored from a snapshot
+	void evaluate();
+
+//	hand the telemetry to the selector and the reproducor, null to disable it
+	void instrument(Evolutionary::Telemetry* telemetry);
+
+	void save(Evolutionary::Snapshot& snapshot) const;
+	bool restore(const Evolutionary::Snapshot& snapshot);
 
 public:
-	size_t scale, dimension, constraint, *importances;
+	size_t scale, dimension, constraint;
+	std::vector<size_t> importances;
 	std::list<Individual*> individuals;
 
 public:
-	Population(math::Optimizor::Configuration& configuration);
+	Population(std::shared_ptr<const Evolutionary::Settings> settings);
 	virtual ~Population();
 };
 
-
 class SparseEA : public Evolutionary::Evolutionary
 {
 private:
 	std::unique_ptr<Population> population_;
+	std::list<std::shared_ptr<const double[]>> elites_;
+	size_t interval_;
+
+private:
+	void configure(std::shared_ptr<const ::Evolutionary::Settings> settings);
+	void archive(const std::list<Individual*>& individuals);
+	bool converged(const std::list<Individual*>& individuals);
+
+	void save(::Evolutionary::Snapshot& snapshot) const;
+	bool restore(const ::Evolutionary::Snapshot& snapshot);
 
 protected:
-	virtual void write(const char* filepath);
+	virtual void write(const char* filepath, char mode);
+	virtual std::list<std::shared_ptr<const double[]>> results();
+
 	virtual void evolve(size_t generation);
 	virtual math::Optimizor::Result& optimize(math::Optimizor::Configuration& configuration);
 
 public:
+	virtual math::Optimizor::Result& optimize(std::shared_ptr<const ::Evolutionary::Settings> settings);
+	virtual math::Optimizor::Result& resume(const char* path, math::Optimizor::Configuration& configuration);
+	virtual math::Optimizor::Result& resume(const char* path, std::shared_ptr<const ::Evolutionary::Settings> settings);
 	virtual ~SparseEA() {}
 };
 
-extern "C" __declspec(dllexport) void* __cdecl construct();
-#endif //!_math_optimization_evolutionary_sparseEA_
\ No newline at end of file
+#ifdef _WINDOWS_
+	#define EXPORT __declspec(dllexport)
+#else
+	#define EXPORT __attribute__((visibility("default")))
+#endif
+
+#ifndef STATIC_OPTIMIZOR
+extern "C" EXPORT void* construct();
+#else
+bool register_sparseEA();
+#endif
+#endif //!_math_optimization_evolutionary_sparseEA_
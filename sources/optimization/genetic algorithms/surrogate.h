@@ -0,0 +1,203 @@
+#include <vector>
+#include <numeric>
+#include <algorithm>
+#include <cmath>
+
+#include "checkpoint.h"
+
+#ifndef _math_optimization_evolutionary_surrogate_
+#define _math_optimization_evolutionary_surrogate_
+namespace Evolutionary
+{
+//  kriging model of the objectives and voilations over the decisions normalized by the bounds,
+//  all the outputs share a gaussian kernel, so they share the cholesky factor of the covariance,
+//  which is extended by one row per sample instead of being factorized again
+    class Surrogate
+    {
+    private:
+        size_t scale_, dimension_, outputs_, capacity_;
+        double length_, nugget_;
+        std::vector<double> lower_, range_;
+
+    //  the samples in insertion order, the normalized decisions and the outputs
+        std::vector<double> inputs_, targets_;
+
+    //  rows of the lower triangular factor packed one after another
+        std::vector<double> factor_;
+        std::vector<double> means_, deviations_, weights_;
+        bool fitted_;
+
+    private:
+        double kernel(const double* lhs, const double* rhs) const
+        {
+            double distance = 0;
+            for (size_t i = 0; i < scale_; ++i) { distance += (lhs[i] - rhs[i]) * (lhs[i] - rhs[i]); }
+            return std::exp(-0.5 * distance / (length_ * length_));
+        }
+
+        const double* row(size_t index) const
+        {
+            return factor_.data() + index * (index + 1) / 2;
+        }
+
+    //  forward substitution of the factor, results = L^-1 * values
+        void forward(const double* values, double* results, size_t count) const
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                const double* line = row(i);
+                results[i] = (values[i] - std::inner_product(line, line + i, results, 0.0)) / line[i];
+            }
+        }
+
+    //  extend the factor by the last input
+        void append()
+        {
+            size_t count = inputs_.size() / scale_ - 1;
+            const double* input = &inputs_[count * scale_];
+
+            std::vector<double> covariances(count + 1);
+            for (size_t i = 0; i < count; ++i) { covariances[i] = kernel(input, &inputs_[i * scale_]); }
+
+            size_t offset = factor_.size();
+            factor_.resize(offset + count + 1);
+            forward(covariances.data(), &factor_[offset], count);
+
+            double diagonal = 1.0 + nugget_ - std::inner_product(&factor_[offset], &factor_[offset] + count, &factor_[offset], 0.0);
+            factor_[offset + count] = std::sqrt(std::max(diagonal, nugget_));
+        }
+
+    //  standardize the outputs and solve the weights, K * weights = targets, by the factor
+        void fit()
+        {
+            size_t count = inputs_.size() / scale_;
+            std::vector<double> values(count), solutions(count);
+
+            weights_.assign(count * outputs_, 0.0);
+            for (size_t o = 0; o < outputs_; ++o)
+            {
+                for (size_t i = 0; i < count; ++i) { values[i] = targets_[i * outputs_ + o]; }
+
+                means_[o] = std::accumulate(values.begin(), values.end(), 0.0) / count;
+                double variance = std::accumulate(values.begin(), values.end(), 0.0, [this, o](double sum, double value)
+                    { return sum + (value - means_[o]) * (value - means_[o]); }) / count;
+                deviations_[o] = variance > 0 ? std::sqrt(variance) : 1.0;
+
+                std::transform(values.begin(), values.end(), values.begin(), [this, o](double value) { return (value - means_[o]) / deviations_[o]; });
+
+                forward(values.data(), solutions.data(), count);
+
+            //  backward substitution by the transpose of the factor
+                double* weights = &weights_[o * count];
+                for (size_t i = count; i-- > 0;)
+                {
+                    double sum = solutions[i];
+                    for (size_t j = i + 1; j < count; ++j) { sum -= row(j)[i] * weights[j]; }
+                    weights[i] = sum / row(i)[i];
+                }
+            }
+
+            fitted_ = true;
+        }
+
+    public:
+        void insert(const double* decisions, const double* objectives, const double* voilations)
+        {
+        //  the oldest quarter is dropped once the capacity is reached, and the factor is rebuilt from the left samples
+            if (inputs_.size() / scale_ >= capacity_)
+            {
+                size_t dropped = std::max<size_t>(capacity_ / 4, 1);
+                inputs_.erase(inputs_.begin(), inputs_.begin() + dropped * scale_);
+                targets_.erase(targets_.begin(), targets_.begin() + dropped * outputs_);
+
+                std::vector<double> inputs;
+                inputs.swap(inputs_);
+                factor_.clear();
+
+                for (size_t i = 0; i < inputs.size(); i += scale_)
+                {
+                    inputs_.insert(inputs_.end(), inputs.begin() + i, inputs.begin() + i + scale_);
+                    append();
+                }
+            }
+
+            for (size_t i = 0; i < scale_; ++i)
+            {
+                inputs_.push_back(range_[i] > 0 ? (decisions[i] - lower_[i]) / range_[i] : 0.0);
+            }
+
+            targets_.insert(targets_.end(), objectives, objectives + dimension_);
+            targets_.insert(targets_.end(), voilations, voilations + outputs_ - dimension_);
+
+            append();
+            fitted_ = false;
+        }
+
+    //  predict the outputs and their standard deviations, return the standardized deviation shared by the outputs
+        double predict(const double* decisions, double* means, double* deviations)
+        {
+            size_t count = inputs_.size() / scale_;
+
+            if (!fitted_) { fit(); }
+
+            std::vector<double> input(scale_), covariances(count), solutions(count);
+            for (size_t i = 0; i < scale_; ++i)
+            {
+                input[i] = range_[i] > 0 ? (decisions[i] - lower_[i]) / range_[i] : 0.0;
+            }
+
+            for (size_t i = 0; i < count; ++i) { covariances[i] = kernel(input.data(), &inputs_[i * scale_]); }
+
+            forward(covariances.data(), solutions.data(), count);
+            double variance = std::max(1.0 + nugget_ - std::inner_product(solutions.begin(), solutions.end(), solutions.begin(), 0.0), 0.0);
+
+            for (size_t o = 0; o < outputs_; ++o)
+            {
+                means[o] = means_[o] + deviations_[o] * std::inner_product(covariances.begin(), covariances.end(), &weights_[o * count], 0.0);
+                deviations[o] = deviations_[o] * std::sqrt(variance);
+            }
+
+            return std::sqrt(variance);
+        }
+
+        size_t size() const
+        {
+            return inputs_.size() / scale_;
+        }
+
+    //  the model is a function of the samples alone, so the factor is rebuilt from them on restoring
+        void save(Snapshot& snapshot, const std::string& name) const
+        {
+            store(snapshot, name + ".inputs", inputs_);
+            store(snapshot, name + ".targets", targets_);
+        }
+
+        void restore(const Snapshot& snapshot, const std::string& name)
+        {
+            auto&& inputs = load<double>(snapshot, name + ".inputs");
+            targets_ = load<double>(snapshot, name + ".targets");
+
+            inputs_.clear();
+            factor_.clear();
+
+            for (size_t i = 0; i + scale_ <= inputs.size(); i += scale_)
+            {
+                inputs_.insert(inputs_.end(), inputs.begin() + i, inputs.begin() + i + scale_);
+                append();
+            }
+
+            fitted_ = false;
+        }
+
+    public:
+        Surrogate(size_t scale, size_t dimension, size_t constraint, size_t capacity, const double* upper, const double* lower) :
+            scale_(scale), dimension_(dimension), outputs_(dimension + constraint), capacity_(std::max<size_t>(capacity, 2)),
+            length_(0.5 * std::sqrt(double(scale))), nugget_(1e-8),
+            lower_(lower, lower + scale), range_(scale),
+            means_(outputs_), deviations_(outputs_), fitted_(false)
+        {
+            std::transform(upper, upper + scale, lower, range_.begin(), std::minus<double>());
+        }
+    };
+}
+#endif //! _math_optimization_evolutionary_surrogate_
@@ -0,0 +1,174 @@
+#include <list>
+#include <array>
+#include <string>
+#include <memory>
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+
+#include "../../math.h"
+
+#ifndef _math_optimization_evolutionary_telemetry_
+#define _math_optimization_evolutionary_telemetry_
+namespace Evolutionary
+{
+    enum class Phase : size_t
+    {
+        sort, dispense, variation, evaluation, archive, monitor, checkpoint, local
+    };
+
+//  measurements of one generation, the times are in seconds, the cpu time is of the whole process
+    struct Profile
+    {
+        static constexpr size_t phases = 8;
+        static constexpr const char* names[phases] = { "sort", "dispense", "variation", "evaluation", "archive", "monitor", "checkpoint", "local" };
+
+        size_t generation, evaluations, hits, front, layers, allocations;
+        std::array<double, phases> walls, cpus;
+    };
+
+    class Observer
+    {
+    public:
+        virtual void observe(const Profile& profile) = 0;
+        virtual ~Observer() {}
+    };
+
+//  one json object per generation and line, flushed at once so the trace survives a crash
+    class Trace : public Observer
+    {
+    private:
+        FILE* file_;
+
+    public:
+        virtual void observe(const Profile& profile)
+        {
+            if (!file_) { return; }
+
+            std::fprintf(file_, "{\"generation\":%zu,\"evaluations\":%zu,\"hits\":%zu,\"front\":%zu,\"layers\":%zu,\"allocations\":%zu",
+                profile.generation, profile.evaluations, profile.hits, profile.front, profile.layers, profile.allocations);
+
+            for (const auto& [name, values] : { std::make_pair("wall", &profile.walls), std::make_pair("cpu", &profile.cpus) })
+            {
+                std::fprintf(file_, ",\"%s\":{", name);
+                for (size_t i = 0; i < Profile::phases; ++i)
+                {
+                    std::fprintf(file_, "%s\"%s\":%.9g", i ? "," : "", Profile::names[i], (*values)[i]);
+                }
+                std::fputc('}', file_);
+            }
+
+            std::fputs("}\n", file_);
+            std::fflush(file_);
+        }
+
+    public:
+        Trace(const std::string& path) : file_(std::fopen(path.c_str(), "w")) {}
+
+        virtual ~Trace()
+        {
+            file_ ? void(std::fclose(file_)) : void();
+        }
+    };
+
+//  collects the profile of the current generation and hands it to the observers once the generation ends,
+//  the instrumented code holds a null pointer when nothing observes, so the timers cost a branch
+    class Telemetry
+    {
+    private:
+        Profile profile_;
+        size_t allocations_, hits_;
+        bool recording_;
+
+        std::list<std::shared_ptr<Observer>> observers_;
+        std::unique_ptr<Trace> trace_;
+
+    public:
+        void attach(std::shared_ptr<Observer> observer)
+        {
+            observers_.push_back(observer);
+        }
+
+    //  the trace of the configuration replaces the one of the previous run
+        void trace(const std::string& path)
+        {
+            trace_ = path.empty() ? nullptr : std::make_unique<Trace>(path);
+        }
+
+        bool empty() const
+        {
+            return observers_.empty() && !trace_;
+        }
+
+        Profile& profile()
+        {
+            return profile_;
+        }
+
+    //  the allocations are counted between the beginning and the end of a generation only, the arrays of math::allocate always,
+    //  the other heap blocks in the builds with COUNT_ALLOCATIONS, which count in the global operator new
+        void begin(size_t generation, size_t hits)
+        {
+            recording_ ? void() : void(math::recorders()++);
+            recording_ = true;
+
+            profile_ = Profile{ generation, 0, 0, 0, 0, 0, {}, {} };
+            allocations_ = math::allocations();
+            hits_ = hits;
+        }
+
+        void end(size_t hits)
+        {
+            profile_.allocations = math::allocations() - allocations_;
+            profile_.hits = hits - hits_;
+
+            recording_ ? void(math::recorders()--) : void();
+            recording_ = false;
+
+            for (auto& observer : observers_) { observer->observe(profile_); }
+            trace_ ? trace_->observe(profile_) : void();
+        }
+
+        void add(Phase phase, double wall, double cpu)
+        {
+            profile_.walls[size_t(phase)] += wall;
+            profile_.cpus[size_t(phase)] += cpu;
+        }
+
+    public:
+        Telemetry() : profile_{}, allocations_(0), hits_(0), recording_(false) {}
+
+        ~Telemetry()
+        {
+            recording_ ? void(math::recorders()--) : void();
+        }
+    };
+
+//  accumulates the wall and cpu time of its scope into the phase
+    class Timer
+    {
+    private:
+        Telemetry* telemetry_;
+        Phase phase_;
+        std::chrono::steady_clock::time_point wall_;
+        std::clock_t cpu_;
+
+    public:
+        Timer(Telemetry* telemetry, Phase phase) : telemetry_(telemetry), phase_(phase), wall_(), cpu_(0)
+        {
+            if (!telemetry_) { return; }
+
+            wall_ = std::chrono::steady_clock::now();
+            cpu_ = std::clock();
+        }
+
+        ~Timer()
+        {
+            if (!telemetry_) { return; }
+
+            double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - wall_).count();
+            telemetry_->add(phase_, wall, double(std::clock() - cpu_) / CLOCKS_PER_SEC);
+        }
+    };
+}
+#endif //! _math_optimization_evolutionary_telemetry_
@@ -0,0 +1,202 @@
+#include <bit>
+#include <vector>
+#include <string>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <charconv>
+#include <algorithm>
+
+#ifndef _WINDOWS_
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#endif
+
+#ifndef _math_optimization_evolutionary_writer_
+#define _math_optimization_evolutionary_writer_
+namespace Evolutionary
+{
+//  a solution to be written, the decisions, objectives and voilations
+    struct Row
+    {
+        const double *decisions, *objectives, *voilations;
+    };
+
+//  writer of the results in the modes of Result::write,
+//  't' or 0, text separated by tabs, one solution per line, formatted by std::to_chars into a large buffer,
+//  'b', binary columns, a header of the magic and the sizes followed by one little endian block per column,
+//  'm', the same binary columns written through a memory map of the file, by streams where it is not available
+    class Writer
+    {
+    private:
+        static constexpr char magic_[8] = { 'E', 'V', 'O', 'L', 'C', 'O', 'L', 'S' };
+
+    //  the columns are transposed by tiles, so each row is read by whole cache lines
+        static constexpr size_t tile_ = 8;
+
+        size_t scale_, dimension_, constraint_;
+
+    private:
+        double value(const Row& row, size_t column) const
+        {
+            return column < scale_ ? row.decisions[column] :
+                (column < scale_ + dimension_ ? row.objectives[column - scale_] : row.voilations[column - scale_ - dimension_]);
+        }
+
+        static double little(double value)
+        {
+            if constexpr (std::endian::native == std::endian::big)
+            {
+                auto bits = std::bit_cast<uint64_t>(value);
+                bits = __builtin_bswap64(bits);
+                return std::bit_cast<double>(bits);
+            }
+
+            return value;
+        }
+
+        std::vector<uint64_t> header(size_t rows) const
+        {
+            std::vector<uint64_t> results = { rows, scale_, dimension_, constraint_ };
+
+            if constexpr (std::endian::native == std::endian::big)
+            {
+                std::transform(results.begin(), results.end(), results.begin(), [](uint64_t value) { return __builtin_bswap64(value); });
+            }
+
+            return results;
+        }
+
+    //  transpose the columns [begin, end) into the destination, column after column
+        void transpose(const std::vector<Row>& rows, size_t begin, size_t end, double* destination) const
+        {
+            for (size_t r = 0; r < rows.size(); ++r)
+            {
+                for (size_t c = begin; c < end; ++c)
+                {
+                    destination[(c - begin) * rows.size() + r] = little(value(rows[r], c));
+                }
+            }
+        }
+
+        bool text(const char* path, const std::vector<Row>& rows) const
+        {
+            FILE* file = std::fopen(path, "wb");
+
+            if (!file) { return false; }
+
+        //  the buffer is flushed by large blocks only, a value takes 25 characters at most
+            const size_t block = size_t(1) << 24;
+            std::vector<char> buffer(block + 64);
+            char* cursor = buffer.data();
+            bool status = true;
+
+            size_t columns = scale_ + dimension_ + constraint_;
+            for (const auto& row : rows)
+            {
+                for (size_t c = 0; c < columns; ++c)
+                {
+                    cursor = std::to_chars(cursor, buffer.data() + buffer.size(), value(row, c)).ptr;
+                    *cursor++ = '\t';
+
+                    if (size_t(cursor - buffer.data()) >= block)
+                    {
+                        status = status && std::fwrite(buffer.data(), 1, cursor - buffer.data(), file) == size_t(cursor - buffer.data());
+                        cursor = buffer.data();
+                    }
+                }
+
+                *cursor++ = '\n';
+            }
+
+            status = status && std::fwrite(buffer.data(), 1, cursor - buffer.data(), file) == size_t(cursor - buffer.data());
+            return std::fclose(file) == 0 && status;
+        }
+
+        bool binary(const char* path, const std::vector<Row>& rows) const
+        {
+            FILE* file = std::fopen(path, "wb");
+
+            if (!file) { return false; }
+
+            auto&& header = this->header(rows.size());
+            bool status = std::fwrite(magic_, 1, sizeof(magic_), file) == sizeof(magic_);
+            status = status && std::fwrite(header.data(), sizeof(uint64_t), header.size(), file) == header.size();
+
+            size_t columns = scale_ + dimension_ + constraint_;
+            std::vector<double> buffer(tile_ * rows.size());
+
+            for (size_t begin = 0; begin < columns && status; begin += tile_)
+            {
+                size_t end = std::min(begin + tile_, columns);
+                transpose(rows, begin, end, buffer.data());
+
+                size_t count = (end - begin) * rows.size();
+                status = std::fwrite(buffer.data(), sizeof(double), count, file) == count;
+            }
+
+            return std::fclose(file) == 0 && status;
+        }
+
+        bool mapped(const char* path, const std::vector<Row>& rows) const
+        {
+        #ifdef _WINDOWS_
+            return binary(path, rows);
+        #else
+            size_t columns = scale_ + dimension_ + constraint_;
+            size_t offset = sizeof(magic_) + 4 * sizeof(uint64_t);
+            size_t length = offset + columns * rows.size() * sizeof(double);
+
+            int file = ::open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+
+            if (file < 0) { return false; }
+
+            if (::ftruncate(file, length) != 0)
+            {
+                ::close(file);
+                return false;
+            }
+
+            void* address = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+            ::close(file);
+
+            if (address == MAP_FAILED) { return binary(path, rows); }
+
+            auto bytes = static_cast<char*>(address);
+            auto&& header = this->header(rows.size());
+
+            std::memcpy(bytes, magic_, sizeof(magic_));
+            std::memcpy(bytes + sizeof(magic_), header.data(), header.size() * sizeof(uint64_t));
+
+        //  the offset keeps the blocks aligned to the doubles, as the header is made of 8 byte words
+            auto blocks = reinterpret_cast<double*>(bytes + offset);
+            for (size_t begin = 0; begin < columns; begin += tile_)
+            {
+                transpose(rows, begin, std::min(begin + tile_, columns), blocks + begin * rows.size());
+            }
+
+            return ::munmap(address, length) == 0;
+        #endif
+        }
+
+    public:
+    //  return false if the file could not be written
+        bool write(const char* path, char mode, const std::vector<Row>& rows) const
+        {
+            switch (mode)
+            {
+            case 'b':
+                return binary(path, rows);
+            case 'm':
+                return mapped(path, rows);
+            default:
+                return text(path, rows);
+            }
+        }
+
+    public:
+        Writer(size_t scale, size_t dimension, size_t constraint) : scale_(scale), dimension_(dimension), constraint_(constraint) {}
+    };
+}
+#endif //! _math_optimization_evolutionary_writer_
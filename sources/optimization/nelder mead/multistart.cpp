@@ -0,0 +1,156 @@
+#include <random>
+#include <optional>
+#include <exception>
+
+#include "multistart.h"
+#include "../genetic algorithms/sampling.h"
+
+#ifdef STATIC_OPTIMIZOR
+REGISTER_OPTIMIZOR(multistart, []() -> void* { return static_cast<math::Optimizor*>(new Multistart()); })
+#else
+extern "C" EXPORT void* create()
+{
+	return static_cast<math::Optimizor*>(new Multistart());
+}
+#endif
+
+namespace
+{
+//	the objective shared by the local runs, which have to own one each, the evaluations are counted on the way
+	class Forward : public math::Optimizor::Objective
+	{
+	private:
+		math::Optimizor::Objective* objective_;
+		std::atomic<size_t>& evaluations_;
+
+	public:
+		virtual void operator () (const double* decisions, double* objectives, double* voilations)
+		{
+			(*objective_)(decisions, objectives, voilations);
+			evaluations_++;
+		}
+
+		virtual void operator () (size_t count, const double* const* decisions, double* const* objectives, double* const* voilations)
+		{
+			(*objective_)(count, decisions, objectives, voilations);
+			evaluations_ += count;
+		}
+
+	public:
+		Forward(math::Optimizor::Objective* objective, std::atomic<size_t>& evaluations) : objective_(objective), evaluations_(evaluations)
+		{
+		}
+	};
+}
+
+size_t Multistart::evaluations() const
+{
+	return evaluations_;
+}
+
+void Multistart::write(const char* path, char mode)
+{
+	std::vector<Evolutionary::Row> rows;
+	for (const auto& optimum : optima_) { rows.push_back({ optimum.get(), optimum.get() + scale_, optimum.get() + scale_ + 1 }); }
+
+	bool status = Evolutionary::Writer(scale_, 1, constraint_).write(path, mode, rows);
+	if (!status) { throw std::runtime_error(std::string("the results could not be written to ") + path); }
+}
+
+std::list<std::shared_ptr<const double[]>> Multistart::results()
+{
+	return optima_;
+}
+
+math::Optimizor::Result& Multistart::optimize(math::Optimizor::Configuration& configuration)
+{
+	auto objective = configuration.objective.get();
+	if (!objective) { throw std::invalid_argument("the objective is missing"); }
+
+	scale_ = configuration.get<size_t>("scale", 0);
+	if (!scale_) { throw std::invalid_argument("the option scale is missing"); }
+
+	constraint_ = configuration.get<size_t>("constraint", 0);
+	starts_ = configuration.get<size_t>("starts", 16);
+	size_t threads = configuration.get<size_t>("threads", 0);
+	double distance = configuration.get<double>("distance", 1e-3);
+
+	upper_ = configuration.get<std::vector<double>>("upper", {});
+	lower_ = configuration.get<std::vector<double>>("lower", {});
+	if (upper_.size() != scale_ || lower_.size() != scale_) { throw std::invalid_argument("the starts are drawn within bounds holding a value per decision"); }
+
+	auto design = configuration.get<std::string>("initialization", "sobol");
+	if (design != "uniform" && design != "latin" && design != "sobol") { throw std::invalid_argument("the initialization " + design + " is unknown"); }
+
+//	nelder mead is linked in, any other local optimizer comes from the registry
+	auto local = configuration.get<std::string>("local", "neldermead");
+	auto create = [&local]() { return local == "neldermead" ? std::unique_ptr<math::Optimizor>(new NelderMead()) : math::Registry::instance().create(local); };
+	if (!create()) { throw std::invalid_argument("the local optimizer " + local + " is unknown"); }
+
+	std::mt19937_64 generator(configuration.get<size_t>("seed", std::random_device{}()));
+	std::vector<double> starts(starts_ * scale_), integer(scale_, 0.0);
+	Evolutionary::sample(design, starts_, scale_, starts.data(), upper_.data(), lower_.data(), integer.data(), generator);
+
+//	every run on a thread of the team with its own optimizer and configuration, the errors are raised once all are done
+	std::vector<std::list<std::shared_ptr<const double[]>>> found(starts_);
+	std::vector<std::exception_ptr> errors(starts_);
+	evaluations_ = 0;
+
+	math::parallel(starts_, threads, [&](size_t s)
+		{
+			try
+			{
+				auto optimizer = create();
+
+				math::Optimizor::Configuration run;
+				run.assign(configuration);
+				run["initial"] = std::vector<double>(starts.begin() + s * scale_, starts.begin() + (s + 1) * scale_);
+				run["threads"] = size_t(1);
+				run.objective = std::make_unique<Forward>(objective, evaluations_);
+
+				found[s] = optimizer->optimize(run).results();
+			}
+			catch (...)
+			{
+				errors[s] = std::current_exception();
+			}
+		});
+
+	for (auto& error : errors) { error ? std::rethrow_exception(error) : void(); }
+
+//	the optima by increasing penalized values, each kept unless a better one kept lies within the distance
+	auto value = [this](const std::shared_ptr<const double[]>& row)
+		{
+			double result = row[scale_];
+			for (size_t j = 0; j < constraint_; ++j) { result += std::max(row[scale_ + 1 + j], 0.0); }
+			return result;
+		};
+
+	std::vector<std::shared_ptr<const double[]>> candidates;
+	for (auto& results : found) { candidates.insert(candidates.end(), results.begin(), results.end()); }
+	std::stable_sort(candidates.begin(), candidates.end(), [&value](const auto& lhs, const auto& rhs) { return value(lhs) < value(rhs); });
+
+	optima_.clear();
+
+	for (const auto& candidate : candidates)
+	{
+		bool duplicate = std::any_of(optima_.begin(), optima_.end(), [this, &candidate, distance](const std::shared_ptr<const double[]>& optimum)
+			{
+				for (size_t i = 0; i < scale_; ++i)
+				{
+					double width = upper_[i] - lower_[i];
+					if (std::abs(candidate[i] - optimum[i]) > distance * (width > 0 ? width : 1.0)) { return false; }
+				}
+
+				return true;
+			});
+
+		duplicate ? void() : optima_.push_back(candidate);
+	}
+
+	return *this;
+}
+
+Multistart::Multistart() : scale_(0), constraint_(0), starts_(0), evaluations_(0)
+{
+}
@@ -0,0 +1,36 @@
+#include <list>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "nelder mead.h"
+
+#ifndef _MATH_OPTIMIZATION_MULTISTART_
+#define _MATH_OPTIMIZATION_MULTISTART_
+//	local searches from the points of a sobol sequence, a latin hypercube or a uniform draw over the bounds, run at once on a team of threads,
+//	each by its own local optimizer, nelder mead unless another one of the registry is named, with the options of the configuration,
+//	the optima are kept by increasing values, one that lies within the distance of a better one, relative to the bounds, is dropped
+class Multistart : public math::Optimizor, public math::Optimizor::Result
+{
+private:
+	size_t scale_, constraint_, starts_;
+	std::vector<double> upper_, lower_;
+
+	std::atomic<size_t> evaluations_;
+	std::list<std::shared_ptr<const double[]>> optima_;
+
+public:
+	size_t evaluations() const;
+
+public:
+	virtual void write(const char* path, char mode);
+	virtual std::list<std::shared_ptr<const double[]>> results();
+
+	virtual math::Optimizor::Result& optimize(math::Optimizor::Configuration& configuration);
+
+public:
+	Multistart();
+	virtual ~Multistart() {}
+};
+#endif //!_MATH_OPTIMIZATION_MULTISTART_
@@ -0,0 +1,84 @@
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "multistart.h"
+#include "../functions.h"
+
+//	nelder mead benchmark [threads] [delay], the evaluations and the wall clock of the serial method, as parallel 0, with threads, also
+//	of the worst vertices moved at once up to the number of threads, then the multi-start runs over the local minima of a rastrigin function,
+//	serial and on the threads, with an objective taking the delay in microseconds, it fails if a parallel run ends farther than the tolerance
+//	from the serial value
+int main(int argc, char** argv)
+{
+	size_t threads = argc > 1 ? std::stoul(argv[1]) : 1, delay = argc > 2 ? std::stoul(argv[2]) : 0;
+	const double tolerance = 1e-6;
+	int status = 0;
+
+	std::printf("%-12s %4s %8s %12s %8s %16s %12s\n", "problem", "n", "parallel", "evaluations", "iters", "value", "seconds");
+
+	for (auto& problem : Functions::problems(6))
+	{
+		double serial = 0;
+
+		for (size_t parallel = 0; parallel <= std::min(threads, problem.scale - 1); parallel = std::max<size_t>(2 * parallel, 1))
+		{
+			if (parallel && threads == 1) { break; }
+
+			auto configuration = std::make_unique<math::Optimizor::Configuration>();
+			configuration->objective = std::make_unique<Functions::Function>(problem.function, delay);
+
+			(*configuration)["scale"] = problem.scale;
+			(*configuration)["initial"] = problem.initial;
+			(*configuration)["maximum"] = size_t(100000);
+			(*configuration)["parallel"] = std::max<size_t>(parallel, 1);
+			(*configuration)["threads"] = parallel ? threads : 1;
+
+			NelderMead neldermead;
+			auto begin = std::chrono::steady_clock::now();
+			auto result = *neldermead.optimize(*configuration).results().begin();
+			double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+			double value = result[problem.scale];
+			std::printf("%-12s %4zu %8zu %12zu %8zu %16.6e %12.6f\n", problem.name.c_str(), problem.scale, parallel, neldermead.evaluations(), neldermead.iterations(), value, elapsed);
+
+			parallel ? void() : void(serial = value);
+
+			if (parallel && std::abs(value - serial) > tolerance * (1 + std::abs(serial)))
+			{
+				std::fprintf(stderr, "%s %zu: the parallel %zu run ends at %e, the serial run at %e\n", problem.name.c_str(), problem.scale, parallel, value, serial);
+				status = 1;
+			}
+		}
+	}
+
+	std::printf("\n%-12s %8s %8s %12s %8s %16s %12s\n", "design", "threads", "starts", "evaluations", "optima", "best", "seconds");
+
+	for (std::string design : { "sobol", "latin", "uniform" })
+	{
+		for (size_t team : { size_t(1), threads })
+		{
+			auto configuration = std::make_unique<math::Optimizor::Configuration>();
+			configuration->objective = std::make_unique<Functions::Function>(Functions::rastrigin(2), delay);
+
+			(*configuration)["scale"] = size_t(2);
+			(*configuration)["upper"] = std::vector<double>{ 5.12, 5.12 };
+			(*configuration)["lower"] = std::vector<double>{ -5.12, -5.12 };
+			(*configuration)["starts"] = size_t(64);
+			(*configuration)["threads"] = team;
+			(*configuration)["initialization"] = design;
+			(*configuration)["seed"] = size_t(1);
+
+			Multistart multistart;
+			auto begin = std::chrono::steady_clock::now();
+			auto optima = multistart.optimize(*configuration).results();
+			double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+			std::printf("%-12s %8zu %8d %12zu %8zu %16.6e %12.6f\n", design.c_str(), team, 64, multistart.evaluations(), optima.size(), (*optima.begin())[2], elapsed);
+
+			if (threads == 1) { break; }
+		}
+	}
+
+	return status;
+}
@@ -0,0 +1,81 @@
+#include <cmath>
+#include <iostream>
+#include "multistart.h"
+#include "../functions.h"
+
+int main()
+{
+	auto config = std::make_unique<math::Optimizor::Configuration>();
+	config->objective = std::make_unique<Functions::Function>(Functions::rosenbrock(2));
+
+	(*config)["scale"] = size_t(2);
+	(*config)["initial"] = std::vector<double>{ -1.2, 1.0 };
+
+	NelderMead neldermead;
+	auto result = *neldermead.optimize(*config).results().begin();
+	std::cout << "rosenbrock " << result[0] << " " << result[1] << " in " << neldermead.evaluations() << " evaluations" << std::endl;
+
+	if (std::abs(result[0] - 1) > 1e-4 || std::abs(result[1] - 1) > 1e-4) { return 1; }
+
+//	the two worst vertices reflected at once, split between two threads, on the rosenbrock function of four decisions
+	config->objective = std::make_unique<Functions::Function>(Functions::rosenbrock(4));
+	(*config)["scale"] = size_t(4);
+	(*config)["initial"] = std::vector<double>{ -1.2, 1.0, -1.2, 1.0 };
+	(*config)["parallel"] = size_t(2);
+	(*config)["threads"] = size_t(2);
+
+	result = *neldermead.optimize(*config).results().begin();
+	std::cout << "parallel " << result[0] << " " << result[1] << " " << result[2] << " " << result[3] << " in " << neldermead.evaluations() << " evaluations" << std::endl;
+
+	for (size_t i = 0; i < 4; ++i)
+	{
+		if (std::abs(result[i] - 1) > 1e-4) { return 1; }
+	}
+
+//	the minimum of the sphere centered at 2 lies on the upper bound 1
+	config->objective = std::make_unique<Functions::Function>(Functions::sphere(3, 2.0));
+	(*config)["scale"] = size_t(3);
+	(*config)["upper"] = std::vector<double>{ 1.0, 1.0, 1.0 };
+	(*config)["lower"] = std::vector<double>{ -1.0, -1.0, -1.0 };
+	(*config)["initial"] = std::vector<double>{ 0.0, -0.5, 0.5 };
+
+	result = *neldermead.optimize(*config).results().begin();
+	std::cout << "bounded " << result[0] << " " << result[1] << " " << result[2] << " in " << neldermead.evaluations() << " evaluations" << std::endl;
+
+	for (size_t i = 0; i < 3; ++i)
+	{
+		if (std::abs(result[i] - 1) > 1e-6) { return 1; }
+	}
+
+//	the runs from the starts of a sobol sequence meet every minimum, each kept once
+	config = std::make_unique<math::Optimizor::Configuration>();
+//	four minima of value zero within [-5, 5]
+	config->objective = std::make_unique<Functions::Function>(Functions::himmelblau);
+
+	(*config)["scale"] = size_t(2);
+	(*config)["upper"] = std::vector<double>{ 5.0, 5.0 };
+	(*config)["lower"] = std::vector<double>{ -5.0, -5.0 };
+	(*config)["starts"] = size_t(32);
+	(*config)["seed"] = size_t(1);
+
+	Multistart multistart;
+	auto optima = multistart.optimize(*config).results();
+	std::cout << "multistart " << optima.size() << " optima in " << multistart.evaluations() << " evaluations" << std::endl;
+
+	size_t minima = 0;
+	for (const auto& optimum : optima)
+	{
+		std::cout << "  " << optimum[0] << " " << optimum[1] << " " << optimum[2] << std::endl;
+		minima += optimum[2] < 1e-8;
+	}
+
+	if (minima != 4) { return 1; }
+
+//	the starts of a latin hypercube reach the global minimum too
+	(*config)["initialization"] = std::string("latin");
+
+	optima = multistart.optimize(*config).results();
+	if (optima.empty() || (*optima.begin())[2] > 1e-8) { return 1; }
+
+	return 0;
+}
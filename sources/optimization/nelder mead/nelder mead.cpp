@@ -0,0 +1,273 @@
+#include "nelder mead.h"
+
+#ifdef STATIC_OPTIMIZOR
+REGISTER_OPTIMIZOR(neldermead, []() -> void* { return static_cast<math::Optimizor*>(new NelderMead()); })
+#else
+extern "C" EXPORT void* create()
+{
+	return static_cast<math::Optimizor*>(new NelderMead());
+}
+#endif
+
+void NelderMead::evaluate(size_t count, const double* rows, double* values)
+{
+	objectives_.resize(count);
+	penalties_.resize(count * constraint_);
+	decisions_.resize(count);
+	outputs_.resize(count);
+	constraints_.resize(count);
+
+	for (size_t k = 0; k < count; ++k)
+	{
+		decisions_[k] = rows + k * scale_;
+		outputs_[k] = &objectives_[k];
+		constraints_[k] = penalties_.data() + k * constraint_;
+	}
+
+	size_t parts = std::clamp<size_t>(threads_, 1, count), part = (count + parts - 1) / parts;
+	auto task = [this, count, part](size_t p)
+		{
+			size_t first = std::min(p * part, count), size = std::min(part, count - first);
+			size ? (*objective_)(size, decisions_.data() + first, outputs_.data() + first, constraints_.data() + first) : void();
+		};
+
+	parts > 1 ? math::parallel(parts, parts, task) : task(0);
+
+	for (size_t k = 0; k < count; ++k)
+	{
+		values[k] = objectives_[k];
+		for (size_t j = 0; j < constraint_; ++j) { values[k] += std::max(penalties_[k * constraint_ + j], 0.0); }
+	}
+
+	evaluations_ += count;
+}
+
+//	the first simplex steps from the point along every axis by a share of the bounds or of the decision,
+//	backwards if the step would leave the box
+void NelderMead::simplex(const double* point, double step)
+{
+	for (size_t k = 0; k <= scale_; ++k)
+	{
+		std::copy(point, point + scale_, vertices_.begin() + k * scale_);
+		if (!k) { continue; }
+
+		size_t i = k - 1;
+		double edge = step * (upper_.empty() ? std::max(std::abs(point[i]), 1.0) : upper_[i] - lower_[i]);
+		vertices_[k * scale_ + i] += !upper_.empty() && point[i] + edge > upper_[i] ? -edge : edge;
+	}
+
+	evaluate(scale_ + 1, vertices_.data(), values_.data());
+}
+
+void NelderMead::move(const double* vertex, double coefficient, double* point) const
+{
+	for (size_t i = 0; i < scale_; ++i)
+	{
+		double value = centroid_[i] + coefficient * (vertex[i] - centroid_[i]);
+		point[i] = upper_.empty() ? value : std::clamp(value, lower_[i], upper_[i]);
+	}
+}
+
+//	the values agree within the tolerance and the vertices lie within the precision of the best one
+bool NelderMead::converged() const
+{
+	double best = values_[order_.front()], worst = values_[order_.back()];
+	if (worst - best > tolerance_ * (std::abs(best) + std::abs(worst)) + 1e-25) { return false; }
+
+	const double* origin = &vertices_[order_.front() * scale_];
+
+	for (size_t k = 0; k <= scale_; ++k)
+	{
+		for (size_t i = 0; i < scale_; ++i)
+		{
+			if (std::abs(vertices_[k * scale_ + i] - origin[i]) > precision_ * (1 + std::abs(origin[i]))) { return false; }
+		}
+	}
+
+	return true;
+}
+
+size_t NelderMead::evaluations() const
+{
+	return evaluations_;
+}
+
+size_t NelderMead::iterations() const
+{
+	return iterations_;
+}
+
+void NelderMead::write(const char* path, char mode)
+{
+	if (!result_) { return; }
+
+	std::vector<Evolutionary::Row> rows = { { result_.get(), result_.get() + scale_, result_.get() + scale_ + 1 } };
+	bool status = Evolutionary::Writer(scale_, 1, constraint_).write(path, mode, rows);
+	if (!status) { throw std::runtime_error(std::string("the results could not be written to ") + path); }
+}
+
+std::list<std::shared_ptr<const double[]>> NelderMead::results()
+{
+	return result_ ? std::list<std::shared_ptr<const double[]>>{ result_ } : std::list<std::shared_ptr<const double[]>>{};
+}
+
+math::Optimizor::Result& NelderMead::optimize(math::Optimizor::Configuration& configuration)
+{
+	objective_ = configuration.objective.get();
+	if (!objective_) { throw std::invalid_argument("the objective is missing"); }
+
+	scale_ = configuration.get<size_t>("scale", 0);
+	if (!scale_) { throw std::invalid_argument("the option scale is missing"); }
+
+	constraint_ = configuration.get<size_t>("constraint", 0);
+	maximum_ = configuration.get<size_t>("maximum", 10000);
+	tolerance_ = configuration.get<double>("tolerance", 1e-10);
+	precision_ = configuration.get<double>("precision", 1e-8);
+	threads_ = configuration.get<size_t>("threads", 0);
+//	two vertices are kept at least, reflected through a single one the simplex degenerates
+	parallel_ = std::clamp<size_t>(configuration.get<size_t>("parallel", 1), 1, std::max<size_t>(scale_ - 1, 1));
+
+	double step = configuration.get<double>("step", 0.05);
+	if (!(step > 0)) { throw std::invalid_argument("the step must be positive"); }
+
+	upper_ = configuration.get<std::vector<double>>("upper", {});
+	lower_ = configuration.get<std::vector<double>>("lower", {});
+	if (upper_.size() != lower_.size() || (!upper_.empty() && upper_.size() != scale_))
+	{
+		throw std::invalid_argument("the bounds must hold a value per decision");
+	}
+
+	auto initial = configuration.initial(scale_, upper_, lower_);
+
+	vertices_.resize((scale_ + 1) * scale_);
+	values_.resize(scale_ + 1);
+	centroid_.resize(scale_);
+	order_.resize(scale_ + 1);
+
+	evaluations_ = 0;
+	simplex(initial.data(), step);
+
+//	the coefficients of the reflection, the expansion, the contractions and the shrink, the classic ones on two decisions or less
+	double n = std::max<double>(double(scale_), 2.0);
+	const double reflection = 1, expansion = 1 + 2 / n, contraction = 0.75 - 1 / (2 * n), shrink = 1 - 1 / n;
+
+	enum Step { reflect, expand, outside, inside, none };
+	std::vector<size_t> slots(parallel_);
+
+	candidates_.resize(4 * parallel_ * scale_);
+	scores_.resize(4 * parallel_);
+	trials_.resize(std::max(scale_, parallel_) * scale_);
+	trialed_.resize(std::max(scale_, parallel_));
+
+	size_t degree = parallel_;
+
+	for (iterations_ = 0; iterations_ < maximum_;)
+	{
+		std::iota(order_.begin(), order_.end(), 0);
+		std::stable_sort(order_.begin(), order_.end(), [this](size_t lhs, size_t rhs) { return values_[lhs] < values_[rhs]; });
+
+	//	a simplex that collapses while the worst vertices still move at once starts again around its best vertex with the single worst one moved
+		if (converged())
+		{
+			if (degree == 1) { break; }
+
+			degree = 1;
+			std::vector<double> origin(&vertices_[order_.front() * scale_], &vertices_[order_.front() * scale_] + scale_);
+			simplex(origin.data(), step);
+			continue;
+		}
+
+		iterations_++;
+
+	//	the worst vertices move through the centroid of the ones kept, the candidates of a step are rows k of its block of parallel rows
+		size_t kept = scale_ + 1 - degree;
+
+		std::fill(centroid_.begin(), centroid_.end(), 0.0);
+		for (size_t r = 0; r < kept; ++r)
+		{
+			for (size_t i = 0; i < scale_; ++i) { centroid_[i] += vertices_[order_[r] * scale_ + i] / kept; }
+		}
+
+		const double coefficients[] = { -reflection, -reflection * expansion, -reflection * contraction, contraction };
+		for (size_t k = 0; k < degree; ++k)
+		{
+			for (size_t s = reflect; s <= inside; ++s) { move(&vertices_[order_[kept + k] * scale_], coefficients[s], &candidates_[(s * degree + k) * scale_]); }
+		}
+
+	//	with a thread per candidate, the reflections, expansions and both contractions are evaluated as one batch, otherwise the reflections
+	//	are evaluated first, then only the expansions or contractions they call for
+		bool speculative = threads_ >= 4 * degree;
+		evaluate(speculative ? 4 * degree : degree, candidates_.data(), scores_.data());
+
+	//	a reflection better than the best expands, one better than the worst kept stays, the others contract outside or inside
+		double best = values_[order_[0]], last = values_[order_[kept - 1]];
+		auto next = [&](size_t k)
+			{
+				double value = scores_[k];
+				return value < best ? expand : value < last ? none : value < values_[order_[kept + k]] ? outside : inside;
+			};
+
+		if (!speculative)
+		{
+			size_t count = 0;
+			for (size_t k = 0; k < degree; ++k)
+			{
+				size_t s = next(k);
+				slots[k] = count;
+				s == none ? void() : (void)std::copy_n(&candidates_[(s * degree + k) * scale_], scale_, &trials_[count++ * scale_]);
+			}
+
+			count ? evaluate(count, trials_.data(), trialed_.data()) : void();
+			for (size_t k = 0; k < degree; ++k) { next(k) == none ? void() : (void)(scores_[next(k) * degree + k] = trialed_[slots[k]]); }
+		}
+
+		bool improved = false, advanced = false;
+
+		for (size_t k = 0; k < degree; ++k)
+		{
+			size_t vertex = order_[kept + k], s = next(k);
+			double reflected = scores_[k], value = s == none ? reflected : scores_[s * degree + k];
+
+			size_t taken = s == none ? reflect : s == expand ? (value < reflected ? expand : reflect)
+				: s == outside ? (value <= reflected ? outside : none) : (value < values_[vertex] ? inside : none);
+			if (taken == none) { continue; }
+
+			std::copy_n(&candidates_[(taken * degree + k) * scale_], scale_, &vertices_[vertex * scale_]);
+			values_[vertex] = scores_[taken * degree + k];
+			improved = true;
+			advanced = advanced || values_[vertex] < best;
+		}
+
+	//	once the worst vertices moved at once no longer improve on the best one, they would lead the simplex astray from the path
+	//	of the serial method, which takes over from there with the single worst vertex moved
+		degree = advanced ? degree : 1;
+		if (improved) { continue; }
+
+	//	none of the worst vertices moved, the simplex shrinks towards the best one
+		const double* origin = &vertices_[order_[0] * scale_];
+		std::copy(origin, origin + scale_, centroid_.begin());
+
+		for (size_t r = 1; r <= scale_; ++r) { move(&vertices_[order_[r] * scale_], shrink, &trials_[(r - 1) * scale_]); }
+		evaluate(scale_, trials_.data(), trialed_.data());
+
+		for (size_t r = 1; r <= scale_; ++r)
+		{
+			std::copy(&trials_[(r - 1) * scale_], &trials_[r * scale_], &vertices_[order_[r] * scale_]);
+			values_[order_[r]] = trialed_[r - 1];
+		}
+	}
+
+	const double* best = &vertices_[*std::min_element(order_.begin(), order_.end(), [this](size_t lhs, size_t rhs) { return values_[lhs] < values_[rhs]; }) * scale_];
+
+	result_ = std::shared_ptr<double[]>(new double[scale_ + 1 + constraint_]);
+	std::copy(best, best + scale_, result_.get());
+	(*objective_)(result_.get(), result_.get() + scale_, result_.get() + scale_ + 1);
+	evaluations_++;
+
+	return *this;
+}
+
+NelderMead::NelderMead() :
+	scale_(0), constraint_(0), maximum_(0), iterations_(0), evaluations_(0), threads_(0), parallel_(1), tolerance_(0), precision_(0), objective_(nullptr)
+{
+}
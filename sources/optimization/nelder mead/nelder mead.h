@@ -0,0 +1,87 @@
+#include <list>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+#include <limits>
+#include <numeric>
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+
+#include "../optimizor.h"
+#include "../registry.h"
+#include "../parallel.h"
+#include "../genetic algorithms/writer.h"
+
+#ifndef _MATH_OPTIMIZATION_NELDER_MEAD_
+#define _MATH_OPTIMIZATION_NELDER_MEAD_
+//	the simplex method of Nelder and Mead, the worst vertex is reflected through the centroid of the others, then expanded or contracted,
+//	and the simplex shrinks towards the best vertex once nothing improves, the coefficients of Gao and Han adapt to the scale,
+//	with a parallel degree above one, the worst vertices are reflected at once through the centroid of the others after Lee and Wiswall,
+//	until a step no longer improves on the best vertex, then the single worst vertex moves as in the serial method,
+//	with four threads per moved vertex, its reflection, expansion and both contractions are evaluated as one batch split between the threads,
+//	with fewer, the reflections, then the expansions or contractions, then a shrink, are each evaluated as one batch,
+//	with bounds the vertices are projected into the box, the voilations of the constraints are added to the objective as penalties
+class NelderMead : public math::Optimizor, public math::Optimizor::Result
+{
+private:
+	size_t scale_, constraint_, maximum_, iterations_, evaluations_, threads_, parallel_;
+	double tolerance_, precision_;
+	math::Optimizor::Objective* objective_;
+
+//	empty if unbounded
+	std::vector<double> upper_, lower_;
+
+//	the vertices row by row and their values, the order of the vertices by increasing values, and the centroid of the best ones
+	std::vector<double> vertices_, values_, centroid_;
+	std::vector<size_t> order_;
+
+//	the reflections, expansions and contractions of the worst vertices row by row and their values, the trial points
+//	of a batch row by row and their values, and the buffers of the batch operator of the objective
+	std::vector<double> candidates_, scores_, trials_, trialed_;
+	std::vector<double> objectives_, penalties_;
+	std::vector<const double*> decisions_;
+	std::vector<double*> outputs_, constraints_;
+
+	std::shared_ptr<double[]> result_;
+
+private:
+//	the values of count rows, split between the threads
+	void evaluate(size_t count, const double* rows, double* values);
+
+//	a new simplex around the point, its vertices evaluated
+	void simplex(const double* point, double step);
+
+//	the point centroid + coefficient * (vertex - centroid), within the bounds
+	void move(const double* vertex, double coefficient, double* point) const;
+
+	bool converged() const;
+
+public:
+	size_t evaluations() const;
+	size_t iterations() const;
+
+public:
+	virtual void write(const char* path, char mode);
+	virtual std::list<std::shared_ptr<const double[]>> results();
+
+	virtual math::Optimizor::Result& optimize(math::Optimizor::Configuration& configuration);
+
+public:
+	NelderMead();
+	virtual ~NelderMead() {}
+};
+
+#ifdef _WINDOWS_
+	#define EXPORT __declspec(dllexport)
+#else
+	#define EXPORT __attribute__((visibility("default")))
+#endif
+
+#ifndef STATIC_OPTIMIZOR
+extern "C" EXPORT void* create();
+#else
+bool register_neldermead();
+#endif
+#endif //!_MATH_OPTIMIZATION_NELDER_MEAD_
@@ -1,7 +1,12 @@
 #include <map>
+#include <list>
 #include <string>
+#include <vector>
 #include <variant>
 #include <memory>
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
 
 #ifndef _MATH_OPTIMIZATION_OPTIMIZOR_
 #define _MATH_OPTIMIZATION_OPTIMIZOR_
@@ -23,6 +28,13 @@ namespace math
 	{
 	public:
 		virtual void operator () (const double* decisions, double* objectives, double* voilations) = 0;
+
+	//	evaluate a batch of decisions, one by one unless the model can run them together
+		virtual void operator () (size_t count, const double* const* decisions, double* const* objectives, double* const* voilations)
+		{
+			for (size_t i = 0; i < count; ++i) { (*this)(decisions[i], objectives[i], voilations[i]); }
+		}
+
 		virtual ~Objective() {};
 	};
 
@@ -38,9 +50,14 @@ namespace math
 	class Optimizor::Configuration
 	{
 	private:
-		std::map<std::string, std::variant<size_t, double, std::vector<double>, std::vector<std::vector<double>>>> dictionary;
+		std::map<std::string, std::variant<size_t, double, std::vector<double>, std::vector<std::vector<double>>, std::string>> dictionary;
 
 	public:
+		bool contains(const std::string& name) const
+		{
+			return dictionary.contains(name);
+		}
+
 		const auto& operator [] (const std::string& name) const
 		{
 			return dictionary.find(name)->second;
@@ -51,6 +68,46 @@ namespace math
 			return dictionary[name];
 		}
 
+	//	the option if given, of the type asked or an integer for a real, the fallback otherwise
+		template<typename T>
+		T get(const std::string& name, const T& fallback) const
+		{
+			auto iter = dictionary.find(name);
+			if (iter == dictionary.end()) { return fallback; }
+
+			if (auto result = std::get_if<T>(&iter->second)) { return *result; }
+
+			if constexpr (std::is_same_v<T, double>)
+			{
+				if (auto result = std::get_if<size_t>(&iter->second)) { return double(*result); }
+			}
+
+			throw std::invalid_argument("the option " + name + " has the wrong type");
+		}
+
+	//	the initial decisions of a local search within the bounds, empty if unbounded, the center of the bounds or the origin
+	//	without an initial point
+		std::vector<double> initial(size_t scale, const std::vector<double>& upper, const std::vector<double>& lower) const
+		{
+			auto decisions = get<std::vector<double>>("initial", {});
+			if (decisions.empty())
+			{
+				decisions.resize(scale, 0.0);
+				for (size_t i = 0; i < upper.size(); ++i) { decisions[i] = 0.5 * (upper[i] + lower[i]); }
+			}
+
+			if (decisions.size() != scale) { throw std::invalid_argument("the initial decisions must hold a value per decision"); }
+			for (size_t i = 0; i < upper.size(); ++i) { decisions[i] = std::clamp(decisions[i], lower[i], upper[i]); }
+
+			return decisions;
+		}
+
+	//	the options of the other configuration, the objective stays as it is
+		void assign(const Configuration& other)
+		{
+			dictionary = other.dictionary;
+		}
+
 	public:
 		std::unique_ptr<Objective> objective;
 	};
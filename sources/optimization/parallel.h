@@ -0,0 +1,34 @@
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+
+#ifndef _MATH_OPTIMIZATION_PARALLEL_
+#define _MATH_OPTIMIZATION_PARALLEL_
+namespace math
+{
+//	the number of threads to use, all the hardware ones when zero is asked
+	inline size_t threads(size_t requested)
+	{
+		return requested ? requested : std::max<size_t>(std::thread::hardware_concurrency(), 1);
+	}
+
+//	run the task for the indices [0, count) on a team of threads, the indices are handed out one at a time,
+//	so the tasks of uneven length still balance, the calling thread takes part and the call returns once all are done
+	template<typename F>
+	void parallel(size_t count, size_t threads, F&& task)
+	{
+		std::atomic<size_t> next(0);
+		auto work = [&next, &task, count]()
+			{
+				for (size_t index = next++; index < count; index = next++) { task(index); }
+			};
+
+		std::vector<std::thread> team;
+		for (size_t i = 1; i < std::min(math::threads(threads), count); ++i) { team.emplace_back(work); }
+
+		work();
+		for (auto& thread : team) { thread.join(); }
+	}
+}
+#endif //!_MATH_OPTIMIZATION_PARALLEL_
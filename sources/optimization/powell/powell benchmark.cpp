@@ -0,0 +1,61 @@
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "powell.h"
+#include "../functions.h"
+
+//	powell benchmark [threads] [delay], the evaluations spent by the parabolic and the golden section line searches to reach the same tolerance,
+//	with threads, also by the batches of steps and by the searches along all the directions at once, with the wall clock per iteration
+//	of an objective taking the delay in microseconds, it fails if a parallel mode ends farther than the tolerance from the serial value
+int main(int argc, char** argv)
+{
+	size_t threads = argc > 1 ? std::stoul(argv[1]) : 1, delay = argc > 2 ? std::stoul(argv[2]) : 0;
+	const double tolerance = 1e-6;
+	int status = 0;
+
+	std::vector<std::pair<std::string, std::string>> modes = { { "brent", "" }, { "golden", "" } };
+	if (threads > 1) { modes.insert(modes.end(), { { "brent", "probes" }, { "brent", "directions" } }); }
+
+	std::printf("%-12s %4s %12s %12s %8s %16s %12s\n", "problem", "n", "search", "evaluations", "iters", "value", "s/iter");
+
+	for (auto& problem : Functions::problems(10))
+	{
+		double serial = 0;
+
+		for (auto& [search, parallel] : modes)
+		{
+			auto configuration = std::make_unique<math::Optimizor::Configuration>();
+			configuration->objective = std::make_unique<Functions::Function>(problem.function, delay);
+
+			(*configuration)["scale"] = problem.scale;
+			(*configuration)["initial"] = problem.initial;
+			(*configuration)["search"] = search;
+
+			if (!parallel.empty())
+			{
+				(*configuration)["threads"] = threads;
+				(*configuration)["parallel"] = parallel;
+			}
+
+			Powell powell;
+			auto begin = std::chrono::steady_clock::now();
+			auto result = *powell.optimize(*configuration).results().begin();
+			double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+			std::printf("%-12s %4zu %12s %12zu %8zu %16.6e %12.6f\n", problem.name.c_str(), problem.scale, (parallel.empty() ? search : parallel).c_str(),
+				powell.evaluations(), powell.iterations(), result[problem.scale], elapsed / std::max<size_t>(powell.iterations(), 1));
+
+			double value = result[problem.scale];
+			search == "brent" && parallel.empty() ? void(serial = value) : void();
+
+			if (!parallel.empty() && std::abs(value - serial) > tolerance * (1 + std::abs(serial)))
+			{
+				std::fprintf(stderr, "%s %zu: the %s mode ends at %e, the serial run at %e\n", problem.name.c_str(), problem.scale, parallel.c_str(), value, serial);
+				status = 1;
+			}
+		}
+	}
+
+	return status;
+}
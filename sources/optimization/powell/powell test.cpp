@@ -0,0 +1,37 @@
+#include <cmath>
+#include <iostream>
+#include "powell.h"
+#include "../functions.h"
+
+int main()
+{
+	auto config = std::make_unique<math::Optimizor::Configuration>();
+	config->objective = std::make_unique<Functions::Function>(Functions::rosenbrock(2));
+
+	(*config)["scale"] = size_t(2);
+	(*config)["initial"] = std::vector<double>{ -1.2, 1.0 };
+
+	Powell powell;
+	auto result = *powell.optimize(*config).results().begin();
+	std::cout << "rosenbrock " << result[0] << " " << result[1] << " in " << powell.evaluations() << " evaluations" << std::endl;
+
+	if (std::abs(result[0] - 1) > 1e-3 || std::abs(result[1] - 1) > 1e-3) { return 1; }
+
+//	the minimum of the sphere centered at 2 lies on the upper bound 1
+	config->objective = std::make_unique<Functions::Function>(Functions::sphere(3, 2.0));
+	(*config)["scale"] = size_t(3);
+	(*config)["upper"] = std::vector<double>{ 1.0, 1.0, 1.0 };
+	(*config)["lower"] = std::vector<double>{ -1.0, -1.0, -1.0 };
+	(*config)["initial"] = std::vector<double>{ 0.0, -0.5, 0.5 };
+
+	result = *powell.optimize(*config).results().begin();
+	std::cout << "bounded " << result[0] << " " << result[1] << " " << result[2] << " in " << powell.evaluations() << " evaluations" << std::endl;
+
+	for (size_t i = 0; i < 3; ++i)
+	{
+		if (std::abs(result[i] - 1) > 1e-6) { return 1; }
+	}
+
+	powell.write("results.txt", 0);
+	return 0;
+}
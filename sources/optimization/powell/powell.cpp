@@ -1,118 +1,528 @@
-#include "Matrix.h"
+#include "powell.h"
 
-Powell::Powell(Function* function, const long& decisions, float * initial) :
-	function(function), size(decisions), decision(new float[size]), directions(std::vector<float *>(size, new float *[size]))
+#ifdef STATIC_OPTIMIZOR
+REGISTER_OPTIMIZOR(powell, []() -> void* { return static_cast<math::Optimizor*>(new Powell()); })
+#else
+extern "C" EXPORT void* create()
 {
-	memcpy(decision, initial, size * sizeof(float));
+	return static_cast<math::Optimizor*>(new Powell());
+}
+#endif
+
+double Powell::evaluate(Line& line, const double* decisions)
+{
+	double objective = 0;
+	(*objective_)(decisions, &objective, line.voilations.data());
+	line.evaluations++;
+
+	for (auto voilation : line.voilations) { objective += std::max(voilation, 0.0); }
+	return objective;
+}
+
+//	the point is clipped to the bounds against the rounding of the steps
+double Powell::evaluate(Line& line, const double* origin, const double* direction, double step)
+{
+	for (size_t i = 0; i < scale_; ++i)
+	{
+		double value = origin[i] + step * direction[i];
+		line.trial[i] = upper_.empty() ? value : std::clamp(value, lower_[i], upper_[i]);
+	}
+
+	return evaluate(line, line.trial.data());
+}
+
+//	the points are evaluated through the batch interface, split between the threads if there are several
+void Powell::evaluate(Line& line, const double* origin, const double* direction, size_t count, const double* steps, double* values)
+{
+	line.rows.resize(count * scale_);
+	line.objectives.resize(count);
+	line.penalties.resize(count * constraint_);
+	line.decisions.resize(count);
+	line.outputs.resize(count);
+	line.constraints.resize(count);
+
+	for (size_t k = 0; k < count; ++k)
+	{
+		double* row = &line.rows[k * scale_];
+		for (size_t i = 0; i < scale_; ++i)
+		{
+			double value = origin[i] + steps[k] * direction[i];
+			row[i] = upper_.empty() ? value : std::clamp(value, lower_[i], upper_[i]);
+		}
+
+		line.decisions[k] = row;
+		line.outputs[k] = &line.objectives[k];
+		line.constraints[k] = line.penalties.data() + k * constraint_;
+	}
+
+	size_t parts = std::clamp<size_t>(threads_, 1, count), part = (count + parts - 1) / parts;
+	auto task = [this, &line, count, part](size_t p)
+		{
+			size_t first = std::min(p * part, count), size = std::min(part, count - first);
+			size ? (*objective_)(size, line.decisions.data() + first, line.outputs.data() + first, line.constraints.data() + first) : void();
+		};
 
-	for(long i = 0; i < size; ++i)
+	parts > 1 ? math::parallel(parts, parts, task) : task(0);
+
+	for (size_t k = 0; k < count; ++k)
 	{
-		directions[i] = 1.0f;
+		values[k] = line.objectives[k];
+		for (size_t j = 0; j < constraint_; ++j) { values[k] += std::max(line.penalties[k * constraint_ + j], 0.0); }
 	}
+
+	line.evaluations += count;
 }
 
-/*
-* One dimesion search
-* return the optimal step of the search direction
-* NOTICE: this method is only suitable for single peak functions
-*/
-double Powell::Search(Function* function, double* X0, double* direction)
+std::pair<double, double> Powell::range(const double* origin, const double* direction) const
 {
-	//to settle the intial search interval
-	float left = 0, step = 1, right = 1, l = 0, r = 0;
-	float* X_temp = new float [size] { 0 };
+	double low = -std::numeric_limits<double>::infinity(), high = std::numeric_limits<double>::infinity();
+
+	for (size_t i = 0; i < upper_.size(); ++i)
+	{
+		if (direction[i] == 0) { continue; }
 
-	memcpy(X_temp, direction, size * sizeof(float));
-	cblas_saxpby(size, 1, X0, 1, left, X_temp, 1);
-	function->function(X_temp, size, &l, 1);
+		double first = (upper_[i] - origin[i]) / direction[i], second = (lower_[i] - origin[i]) / direction[i];
+		low = std::max(low, std::min(first, second));
+		high = std::min(high, std::max(first, second));
+	}
 
-	memcpy(X_temp, direction, size * sizeof(float));
-	cblas_saxpby(size, 1, X0, 1, right, X_temp, 1);
-	function->function(X_temp, size, &r, 1);
+	return { std::min(low, 0.0), std::max(high, 0.0) };
+}
 
-	if (r != l)
+//	a parabola through the three best points so far, a golden section when it falls outside the bracket or moves too little
+double Powell::brent(Line& line, const double* origin, const double* direction, double a, double b, double c, double& value)
+{
+	double left = std::min(a, c), right = std::max(a, c);
+	double x = b, w = b, v = b, fx = value, fw = value, fv = value, step = 0, previous = 0;
+
+	for (size_t i = 0; i < 100; ++i)
 	{
-		bool status = r < l;
-		float side = status ? left : right;
+		double middle = 0.5 * (left + right), tolerance = precision_ * std::abs(x) + 1e-10;
+		if (std::abs(x - middle) <= 2 * tolerance - 0.5 * (right - left)) { break; }
 
-		while (status == (r < l))
+		bool parabolic = false;
+		if (std::abs(previous) > tolerance)
 		{
-			float temp = left;
+			double r = (x - w) * (fx - fv), q = (x - v) * (fx - fw), p = (x - v) * q - (x - w) * r;
+			q = 2 * (q - r);
+			p = q > 0 ? -p : p;
+			q = std::abs(q);
 
-			left = r < l ? right: left - step;
-			right = r < l ? right + step : temp;
+			double last = previous;
+			previous = step;
 
-			memcpy(X_temp, direction, size * sizeof(float));
-			cblas_saxpby(size, 1, X0, 1, left, X_temp, 1);
-			function->function(X_temp, size, &l, 1);
+			parabolic = std::abs(p) < std::abs(0.5 * q * last) && p > q * (left - x) && p < q * (right - x);
+			if (parabolic)
+			{
+				step = p / q;
+				step = (x + step - left < 2 * tolerance || right - x - step < 2 * tolerance) ? std::copysign(tolerance, middle - x) : step;
+			}
+		}
 
-			memcpy(X_temp, direction, size * sizeof(float));
-			cblas_saxpby(size, 1, X0, 1, right, X_temp, 1);
-			function->function(X_temp, size, &r, 1);
+		if (!parabolic)
+		{
+			previous = x >= middle ? left - x : right - x;
+			step = section_ * previous;
 		}
 
-		status ? left = side : right = side;
-	}
+		double u = std::abs(step) >= tolerance ? x + step : x + std::copysign(tolerance, step);
+		double fu = evaluate(line, origin, direction, u);
 
-	float left_temp = left + 0.382f * (right - left);
-	float right_temp = left + 0.618f * (right - left);
+		if (fu <= fx)
+		{
+			u >= x ? left = x : right = x;
+			v = w, fv = fw, w = x, fw = fx, x = u, fx = fu;
+			continue;
+		}
+
+		u < x ? left = u : right = u;
 
-	memcpy(X_temp, direction, size * sizeof(float));
-	cblas_saxpby(size, 1, X0, 1, left_temp, X_temp, 1);
-	function->function(X_temp, size, &l, 1);
+		if (fu <= fw || w == x)
+		{
+			v = w, fv = fw, w = u, fw = fu;
+		}
+		else if (fu <= fv || v == x || v == w)
+		{
+			v = u, fv = fu;
+		}
+	}
 
-	memcpy(X_temp, direction, size * sizeof(float));
-	cblas_saxpby(size, 1, X0, 1, right_temp, X_temp, 1);
-	function->function(X_temp, size, &r, 1);
+	value = fx;
+	return x;
+}
 
-	while ((right - left) > 1e-6f)
+//	the section shrinks by the golden ratio per evaluation, down to the same width as the parabolic search
+double Powell::golden(Line& line, const double* origin, const double* direction, double a, double b, double c, double& value)
+{
+	double x0 = a, x3 = c, x1 = b, x2 = b, f1 = value, f2 = value;
+
+	if (std::abs(c - b) > std::abs(b - a))
+	{
+		x2 = b + section_ * (c - b);
+		f2 = evaluate(line, origin, direction, x2);
+	}
+	else
 	{
-		bool status = l < r;
+		x1 = b - section_ * (b - a);
+		f1 = evaluate(line, origin, direction, x1);
+	}
 
-		status ? 
-			right = right_temp, right_temp = left_temp, left_temp = left + 0.382f * (right - left),r = l :
-			left = left_temp, left_temp = right_temp, right_temp = left + 0.618f * (right -left), l = r;
+	for (size_t i = 0; i < 200 && std::abs(x3 - x0) > 4 * (precision_ * 0.5 * std::abs(x1 + x2) + 1e-10); ++i)
+	{
+		if (f2 < f1)
+		{
+			x0 = x1, x1 = x2, x2 = x1 + section_ * (x3 - x1);
+			f1 = f2, f2 = evaluate(line, origin, direction, x2);
+			continue;
+		}
 
-		memcpy(X_temp, direction, size * sizeof(float));
-		cblas_saxpby(size, 1, X0, 1, status ? left_temp : right_temp, X_temp, 1);
-		function->function(X_temp, size, status ? &l : &r, 1);
+		x3 = x2, x2 = x1, x1 = x2 - section_ * (x2 - x0);
+		f2 = f1, f1 = evaluate(line, origin, direction, x1);
 	}
 
-	delete[] X_temp;
-	X_temp = nullptr;
-	return 0.5f * (left + right);
+	value = std::min(f1, f2);
+	return f1 < f2 ? x1 : x2;
 }
 
+//	the first batch spreads the steps both ways by the golden ratio from the unit step, the next ones push outwards while the best
+//	point lies at an end, then zoom into the bracket around the vertex of the parabola through the three points, by steps spaced
+//	by half the distance from the vertex to the best point down to the precision, so a quadratic needs about three batches,
+//	if the parabola fails or the bracket stops shrinking, the steps are spread evenly around the best point instead,
+//	the known steps are never evaluated again
+double Powell::batch(Line& line, const double* origin, const double* direction, double& value)
+{
+	auto [low, high] = range(origin, direction);
+	auto& points = line.points;
+	auto& steps = line.steps;
+
+	auto propose = [this, &points, &steps, low, high](double step)
+		{
+			step = std::clamp(step, low, high);
+			bool known = std::any_of(points.begin(), points.end(), [step](const std::pair<double, double>& point) { return point.first == step; });
+			(known || steps.size() >= threads_ || std::find(steps.begin(), steps.end(), step) != steps.end()) ? void() : steps.push_back(step);
+		};
+
+//	the ties go to the shorter steps, so a flat line is not followed outwards
+	auto better = [](const std::pair<double, double>& lhs, const std::pair<double, double>& rhs)
+		{ return lhs.second < rhs.second || (lhs.second == rhs.second && std::abs(lhs.first) < std::abs(rhs.first)); };
+
+	points.assign(1, { 0.0, value });
+	steps.clear();
+	for (size_t j = 0; j < threads_; ++j) { propose((j % 2 ? -1.0 : 1.0) * std::pow(golden_, double(j / 2))); }
+
+	double width = std::numeric_limits<double>::infinity();
+
+	for (size_t round = 0; round < rounds_ && !steps.empty(); ++round)
+	{
+		line.values.resize(steps.size());
+		evaluate(line, origin, direction, steps.size(), steps.data(), line.values.data());
+
+		for (size_t k = 0; k < steps.size(); ++k) { points.emplace_back(steps[k], line.values[k]); }
+		std::sort(points.begin(), points.end());
+		steps.clear();
+
+		size_t best = std::min_element(points.begin(), points.end(), better) - points.begin();
+
+		if (best == 0 || best + 1 == points.size())
+		{
+			double end = points[best].first;
+			if (points.size() == 1 || end == low || end == high) { break; }
+
+			double stride = end - points[best ? best - 1 : 1].first;
+			for (size_t j = 0; j < threads_; ++j) { propose(end + stride * std::pow(golden_, double(j + 1))); }
+			continue;
+		}
 
-//traditional powell
-void Powell::Optimize(const char* results)
+		points.erase(points.begin() + best + 2, points.end());
+		points.erase(points.begin(), points.begin() + best - 1);
+
+		auto [a, fa] = points[0];
+		auto [b, fb] = points[1];
+		auto [c, fc] = points[2];
+
+		double tolerance = precision_ * std::abs(b) + 1e-10;
+		if (c - a <= 4 * tolerance) { break; }
+
+		double numerator = (b - a) * (b - a) * (fb - fc) - (b - c) * (b - c) * (fb - fa), denominator = (b - a) * (fb - fc) - (b - c) * (fb - fa);
+		double vertex = denominator != 0 ? b - 0.5 * numerator / denominator : b;
+
+		bool parabolic = vertex > a && vertex < c && c - a < 0.9 * width;
+		double center = parabolic ? vertex : b, spacing = parabolic ? std::max(tolerance, 0.5 * std::abs(vertex - b)) : (c - a) / (threads_ + 1);
+		width = c - a;
+
+		auto within = [&propose, a, c](double step) { (step > a && step < c) ? propose(step) : void(); };
+
+		within(center);
+		for (size_t j = 1; j <= threads_; ++j)
+		{
+			within(center + j * spacing);
+			within(center - j * spacing);
+		}
+
+		for (size_t j = 1; j <= threads_; ++j) { within(a + (c - a) * j / (threads_ + 1)); }
+	}
+
+	auto best = std::min_element(points.begin(), points.end(), better);
+
+	value = best->second;
+	return best->first;
+}
+
+//	the bracket grows by the golden ratio from a unit step downhill, within the bounds, a minimum on a bound is taken as it is,
+//	if uphill both ways, or uphill with the other way closed by a bound, the step shrinks instead until it goes down
+double Powell::search(Line& line, const double* origin, const double* direction, double& value)
 {
-	long count = 0;
-	while()
+	auto [low, high] = range(origin, direction);
+	if (high <= low || std::all_of(direction, direction + scale_, [](double value) { return value == 0; })) { return 0; }
+
+	if (!directional_ && threads_ > 1) { return batch(line, origin, direction, value); }
+
+	auto clip = [low, high](double step) { return std::clamp(step, low, high); };
+
+	double a = 0, fa = value, b = high > 0 ? std::min(1.0, high) : std::max(-1.0, low), fb = evaluate(line, origin, direction, b);
+	double c = b, fc = fb;
+
+	if (fb > fa && (b > 0 ? low : high) != 0)
+	{
+		std::swap(a, b);
+		std::swap(fa, fb);
+	}
+
+	if (fb > fa)
 	{
-		for(auto& iter : directions)
+	//	a point on its bound, uphill inwards, is left after a single probe next to it
+		if (evaluate(line, origin, direction, std::copysign(precision_ + 1e-10, b)) >= fa) { return 0; }
+
+		for (size_t i = 0; i < expansions_ && fb >= fa; ++i)
 		{
-			float lamda = Search(function, decision, *iter);
-			cblas_saxpby(size, lambdas[i], directions[i], 1, 1, *iter, 1);
-			function->function(decision, size, &values[i], 1);
+			c = b, fc = fb;
+			b *= section_;
+			fb = evaluate(line, origin, direction, b);
 		}
 
-	//Update the directions: traditional Powell
-		delete[] *directions.begin();
-		directions.pop_front();
+		if (fb >= fa) { return 0; }
+	}
+	else
+	{
+		c = clip(b + golden_ * (b - a));
+		fc = c == b ? fb : evaluate(line, origin, direction, c);
+
+		for (size_t i = 0; i < expansions_ && fc < fb && c != b; ++i)
+		{
+			a = b, fa = fb, b = c, fb = fc;
+			c = clip(b + golden_ * (b - a));
+			fc = c == b ? fb : evaluate(line, origin, direction, c);
+		}
+	}
+
+	if (fc < fb)
+	{
+		value = fc;
+		return c;
+	}
+
+	value = fb;
+	return c == b ? b : (brent_ ? brent(line, origin, direction, a, b, c, value) : golden(line, origin, direction, a, b, c, value));
+}
+
+void Powell::move(const double* direction, double step)
+{
+	for (size_t i = 0; i < scale_; ++i)
+	{
+		double moved = decisions_[i] + step * direction[i];
+		decisions_[i] = upper_.empty() ? moved : std::clamp(moved, lower_[i], upper_[i]);
+	}
+}
+
+std::pair<size_t, double> Powell::sweep()
+{
+	double largest = 0;
+	size_t index = 0;
+
+	for (size_t k = 0; k < scale_; ++k)
+	{
+		double before = value_;
+		move(&directions_[k * scale_], search(lines_[0], decisions_.data(), &directions_[k * scale_], value_));
 
-		directions.push_back(new float [size]);
-		vsSub(size, decision, initial, *directions.rbegin());
+		index = before - value_ > largest ? k : index;
+		largest = std::max(largest, before - value_);
+	}
 
-		float lambda = Search(funtion, initial, *directions.rbegin());
-		count ++;
+	return { index, largest };
+}
 
-	//Sargen Powell
-		if(lambda < values[size] -  values[0])
+//	the steps of the searches from the same point add up to the minimum of a quadratic along conjugate directions,
+//	otherwise the combined point may be worse, then the line of the combined move is searched, or the best single step taken if better,
+//	and the searches run one after the other for as many iterations as there are directions, which makes them conjugate on a quadratic
+std::pair<size_t, double> Powell::combine()
+{
+	math::parallel(scale_, threads_, [this](size_t k)
 		{
+			values_[k] = value_;
+			steps_[k] = search(lines_[k], decisions_.data(), &directions_[k * scale_], values_[k]);
+		});
+
+	size_t index = std::min_element(values_.begin(), values_.end()) - values_.begin();
+	double largest = value_ - values_[index];
 
+	std::copy(decisions_.begin(), decisions_.end(), combination_.begin());
+	for (size_t k = 0; k < scale_; ++k)
+	{
+		for (size_t i = 0; i < scale_; ++i) { combination_[i] += steps_[k] * directions_[k * scale_ + i]; }
+	}
+
+	for (size_t i = 0; i < upper_.size(); ++i) { combination_[i] = std::clamp(combination_[i], lower_[i], upper_[i]); }
+
+	double combined = evaluate(lines_[0], combination_.data());
+
+	if (combined < values_[index])
+	{
+		std::copy(combination_.begin(), combination_.end(), decisions_.begin());
+		value_ = combined;
+		return { index, largest };
+	}
+
+	retry_ = iterations_ + scale_;
+	for (size_t i = 0; i < scale_; ++i) { combination_[i] -= decisions_[i]; }
+
+	double value = value_, step = search(lines_[0], decisions_.data(), combination_.data(), value);
+	value < values_[index] ? move(combination_.data(), step) : move(&directions_[index * scale_], steps_[index]);
+	value_ = std::min(value, values_[index]);
+
+	return { index, largest };
+}
+
+size_t Powell::evaluations() const
+{
+	return std::accumulate(lines_.begin(), lines_.end(), size_t(0), [](size_t sum, const Line& line) { return sum + line.evaluations; });
+}
+
+size_t Powell::iterations() const
+{
+	return iterations_;
+}
+
+//	the only result is the final point, with its objective and voilations
+void Powell::write(const char* path, char mode)
+{
+	if (!result_) { return; }
+
+	std::vector<Evolutionary::Row> rows = { { result_.get(), result_.get() + scale_, result_.get() + scale_ + 1 } };
+	bool status = Evolutionary::Writer(scale_, 1, constraint_).write(path, mode, rows);
+	if (!status) { throw std::runtime_error(std::string("the results could not be written to ") + path); }
+}
+
+std::list<std::shared_ptr<const double[]>> Powell::results()
+{
+	return result_ ? std::list<std::shared_ptr<const double[]>>{ result_ } : std::list<std::shared_ptr<const double[]>>{};
+}
+
+//	the iterations stop when one of them decreases the objective by less than the relative tolerance, or moves the decisions
+//	by less than the precision of the searches, or at the maximum,
+//	the searches stop when the bracket is narrower than the relative precision of the step,
+//	with threads, the objective must be thread safe
+math::Optimizor::Result& Powell::optimize(math::Optimizor::Configuration& configuration)
+{
+	objective_ = configuration.objective.get();
+	if (!objective_) { throw std::invalid_argument("the objective is missing"); }
+
+	scale_ = configuration.get<size_t>("scale", 0);
+	if (!scale_) { throw std::invalid_argument("the option scale is missing"); }
+
+	constraint_ = configuration.get<size_t>("constraint", 0);
+	maximum_ = configuration.get<size_t>("maximum", 1000);
+	tolerance_ = configuration.get<double>("tolerance", 1e-10);
+	precision_ = configuration.get<double>("precision", 1e-6);
+
+	auto method = configuration.get<std::string>("search", "brent");
+	if (method != "brent" && method != "golden") { throw std::invalid_argument("the search " + method + " is unknown"); }
+	brent_ = method == "brent";
+
+	threads_ = configuration.get<size_t>("threads", 0);
+	auto parallel = configuration.get<std::string>("parallel", "probes");
+	if (parallel != "probes" && parallel != "directions") { throw std::invalid_argument("the parallel mode " + parallel + " is unknown"); }
+	directional_ = parallel == "directions";
+
+	upper_ = configuration.get<std::vector<double>>("upper", {});
+	lower_ = configuration.get<std::vector<double>>("lower", {});
+	if (upper_.size() != lower_.size() || (!upper_.empty() && upper_.size() != scale_))
+	{
+		throw std::invalid_argument("the bounds must hold a value per decision");
+	}
+
+	decisions_ = configuration.initial(scale_, upper_, lower_);
+
+	directions_.assign(scale_ * scale_, 0.0);
+	for (size_t i = 0; i < scale_; ++i) { directions_[i * scale_ + i] = 1.0; }
+
+	origin_.resize(scale_);
+	extrapolation_.resize(scale_);
+	move_.resize(scale_);
+	combination_.resize(scale_);
+	steps_.resize(scale_);
+	values_.resize(scale_);
+
+//	a line per direction if their searches run at once
+	bool combined = directional_ && threads_ > 1;
+	lines_.assign(combined ? scale_ : 1, Line());
+	for (auto& line : lines_)
+	{
+		line.trial.resize(scale_);
+		line.voilations.resize(constraint_);
+	}
+
+	value_ = evaluate(lines_[0], decisions_.data());
+
+//	the first iteration sweeps, the steps combined along the axes from a far start can lead into another basin than the serial run
+	retry_ = 1;
+
+	for (iterations_ = 0; iterations_ < maximum_;)
+	{
+		iterations_++;
+
+		double start = value_;
+		std::copy(decisions_.begin(), decisions_.end(), origin_.begin());
+
+		auto [index, largest] = combined && iterations_ > retry_ ? combine() : sweep();
+
+		if (2 * (start - value_) <= tolerance_ * (std::abs(start) + std::abs(value_)) + 1e-25) { break; }
+
+	//	near a minimum at zero the relative decrease never gets small enough, so a move within the precision of the searches ends too
+		bool still = true;
+		for (size_t i = 0; i < scale_ && still; ++i) { still = std::abs(decisions_[i] - origin_[i]) <= precision_ * std::abs(origin_[i]) + 1e-10; }
+		if (still) { break; }
+
+		for (size_t i = 0; i < scale_; ++i)
+		{
+			double value = 2 * decisions_[i] - origin_[i];
+			extrapolation_[i] = upper_.empty() ? value : std::clamp(value, lower_[i], upper_[i]);
+			move_[i] = decisions_[i] - origin_[i];
 		}
 
+		double extrapolated = evaluate(lines_[0], extrapolation_.data());
+		if (extrapolated >= start) { continue; }
+
+	//	the move replaces the direction of the largest decrease only if it is not mostly that direction
+		double test = 2 * (start - 2 * value_ + extrapolated) * std::pow(start - value_ - largest, 2) - largest * std::pow(start - extrapolated, 2);
+		if (test >= 0) { continue; }
 
+		move(move_.data(), search(lines_[0], decisions_.data(), move_.data(), value_));
+
+		auto last = directions_.begin() + (scale_ - 1) * scale_;
+		std::copy(last, last + scale_, directions_.begin() + index * scale_);
+		std::copy(move_.begin(), move_.end(), last);
 	}
-}
\ No newline at end of file
+
+	result_ = std::shared_ptr<double[]>(new double[scale_ + 1 + constraint_]);
+	std::copy(decisions_.begin(), decisions_.end(), result_.get());
+	(*objective_)(decisions_.data(), result_.get() + scale_, result_.get() + scale_ + 1);
+	lines_[0].evaluations++;
+
+	return *this;
+}
+
+Powell::Powell() :
+	scale_(0), constraint_(0), maximum_(0), iterations_(0), threads_(0), retry_(0), tolerance_(0), precision_(0), brent_(true), directional_(false),
+	objective_(nullptr), value_(0)
+{
+}
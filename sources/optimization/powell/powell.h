@@ -1,26 +1,118 @@
+#include <list>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+#include <utility>
+#include <numeric>
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+
 #include "../optimizor.h"
-#include <mkl.h>
+#include "../registry.h"
+#include "../parallel.h"
+#include "../genetic algorithms/writer.h"
 
-#ifndef _POWELL_
-#define _POWELL_
-class Powell : public math::Optimizor
+#ifndef _MATH_OPTIMIZATION_POWELL_
+#define _MATH_OPTIMIZATION_POWELL_
+//	Powell's conjugate direction method, an iteration minimizes along every direction in turn, then along the overall move of the iteration,
+//	which replaces the direction of the largest decrease unless Powell's test finds it would spoil the conjugacy,
+//	the line searches bracket the minimum, then locate it by Brent's parabolic interpolations or by golden sections,
+//	with bounds the searches never leave the box, the voilations of the constraints are added to the objective as penalties,
+//	with threads, either every search evaluates batches of steps at once, or the searches along all the directions run at once
+//	from the same point, whose steps are then combined, which is exact if the directions are conjugate
+class Powell : public math::Optimizor, public math::Optimizor::Result
 {
 private:
-//this is used for the traditional Powell
-    double * decision_, * initial_;
-    std::list<double *> directions;
+//	the scratch of a line search, the searches running at once have one each
+	struct Line
+	{
+		std::vector<double> trial, voilations;
+
+	//	the points of a batch of steps, their objectives and voilations
+		std::vector<double> rows, objectives, penalties;
+		std::vector<const double*> decisions;
+		std::vector<double*> outputs, constraints;
+
+	//	the steps and values known along the line, by increasing steps
+		std::vector<std::pair<double, double>> points;
+		std::vector<double> steps, values;
+
+		size_t evaluations = 0;
+	};
+
+private:
+//	the golden ratio of the bracketing and the sections, the expansions of a bracket and the rounds of a batched search at most
+	static constexpr double golden_ = 1.618033988749895, section_ = 0.3819660112501051;
+	static constexpr size_t expansions_ = 64, rounds_ = 100;
+
+	size_t scale_, constraint_, maximum_, iterations_, threads_;
+//	the iteration from which the searches along the directions run at once again
+	size_t retry_;
+	double tolerance_, precision_;
+	bool brent_, directional_;
+	math::Optimizor::Objective* objective_;
+
+//	empty if unbounded
+	std::vector<double> upper_, lower_;
 
-    double * values;
+//	the current point, the directions row by row, and the scratch of the iterations, all allocated once per run
+	std::vector<double> decisions_, directions_, origin_, extrapolation_, move_, combination_, steps_, values_;
+	std::vector<Line> lines_;
+	double value_;
+
+	std::shared_ptr<double[]> result_;
 
 private:
-    double Search(Function* function, double * initial, double * direction);
+	double evaluate(Line& line, const double* decisions);
+	double evaluate(Line& line, const double* origin, const double* direction, double step);
+	void evaluate(Line& line, const double* origin, const double* direction, size_t count, const double* steps, double* values);
+
+//	the steps along the direction that keep the origin within the bounds
+	std::pair<double, double> range(const double* origin, const double* direction) const;
+
+//	the minimum of the line bracketed by the steps a < b < c or c < b < a, with the value at b
+	double brent(Line& line, const double* origin, const double* direction, double a, double b, double c, double& value);
+	double golden(Line& line, const double* origin, const double* direction, double a, double b, double c, double& value);
+
+//	the minimum of the line by batches of steps evaluated at once
+	double batch(Line& line, const double* origin, const double* direction, double& value);
+
+//	the step of the minimum along the direction from the origin, whose value comes in and the minimum goes out
+	double search(Line& line, const double* origin, const double* direction, double& value);
+	void move(const double* direction, double step);
+
+//	the searches along every direction of an iteration, one after the other, or at once before their steps are combined,
+//	return the direction of the largest decrease and the decrease
+	std::pair<size_t, double> sweep();
+	std::pair<size_t, double> combine();
 
 public:
-    Powell();
-    ~Powell();
+	size_t evaluations() const;
+	size_t iterations() const;
 
 public:
-//    Powell(Function* function, size_t decisions, double * initial);
-    virtual const Result& Optimize(Configuration& configuration);
+	virtual void write(const char* path, char mode);
+	virtual std::list<std::shared_ptr<const double[]>> results();
+
+	virtual math::Optimizor::Result& optimize(math::Optimizor::Configuration& configuration);
+
+public:
+	Powell();
+	virtual ~Powell() {}
 };
-#endif //! _POWELL_
\ No newline at end of file
+
+#ifdef _WINDOWS_
+	#define EXPORT __declspec(dllexport)
+#else
+	#define EXPORT __attribute__((visibility("default")))
+#endif
+
+#ifndef STATIC_OPTIMIZOR
+extern "C" EXPORT void* create();
+#else
+bool register_powell();
+#endif
+#endif //!_MATH_OPTIMIZATION_POWELL_
@@ -0,0 +1,182 @@
+#include <map>
+#include <mutex>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <atomic>
+#include <filesystem>
+#include <shared_mutex>
+
+#include "optimizor.h"
+
+#ifndef _WINDOWS_
+	#include <dlfcn.h>
+#endif
+
+#ifndef _MATH_OPTIMIZATION_REGISTRY_
+#define _MATH_OPTIMIZATION_REGISTRY_
+namespace math
+{
+//	the factories of the optimizers by name, registered statically by the static builds or discovered as shared libraries,
+//	a library is only opened on the first use of its name and stays open, its factory is cached so the later runs cost a lookup
+	class Registry
+	{
+	public:
+	//	the entry point of a plugin, it returns a new math::Optimizor
+		using Factory = void* (*)();
+
+	private:
+		struct Entry
+		{
+			std::string path;
+			std::atomic<Factory> factory = nullptr;
+			std::once_flag once;
+			void* handle = nullptr;
+		};
+
+	//	the names of the entry points, the later plugins export create, the older ones construct
+		static constexpr const char* symbols_[] = { "create", "construct" };
+
+		mutable std::shared_mutex mutex_;
+		std::map<std::string, std::unique_ptr<Entry>, std::less<>> entries_;
+
+	private:
+		Entry* entry(std::string_view name) const
+		{
+			std::shared_lock lock(mutex_);
+
+			auto iter = entries_.find(name);
+			return iter == entries_.end() ? nullptr : iter->second.get();
+		}
+
+		static void open(Entry& entry)
+		{
+#ifdef _WINDOWS_
+			auto handle = LoadLibraryA(entry.path.c_str());
+			for (auto symbol : symbols_)
+			{
+				auto factory = handle ? reinterpret_cast<Factory>(GetProcAddress(handle, symbol)) : nullptr;
+				if (factory) { entry.handle = handle; entry.factory = factory; return; }
+			}
+			handle ? void(FreeLibrary(handle)) : void();
+#else
+			auto handle = dlopen(entry.path.c_str(), RTLD_NOW | RTLD_LOCAL);
+			for (auto symbol : symbols_)
+			{
+				auto factory = handle ? reinterpret_cast<Factory>(dlsym(handle, symbol)) : nullptr;
+				if (factory) { entry.handle = handle; entry.factory = factory; return; }
+			}
+			handle ? void(dlclose(handle)) : void();
+#endif
+		}
+
+	//	the name of a plugin is the file name without the prefixes of the library and of the shared build, libdynamic_unsga.so is unsga
+		static std::string name(const std::filesystem::path& path)
+		{
+			std::string result = path.stem().string();
+
+			for (std::string prefix : { "lib", "dynamic_" })
+			{
+				result = result.starts_with(prefix) ? result.substr(prefix.size()) : result;
+			}
+
+			return result;
+		}
+
+	public:
+		static Registry& instance()
+		{
+			static Registry registry;
+			return registry;
+		}
+
+	//	register a factory linked into the program, it takes over a plugin of the same name, return false if the name is taken
+		bool add(const std::string& name, Factory factory)
+		{
+			std::unique_lock lock(mutex_);
+
+			auto& entry = entries_[name];
+			if (!entry) { entry = std::make_unique<Entry>(); }
+			if (entry->factory) { return false; }
+
+			entry->factory = factory;
+			return true;
+		}
+
+	//	record the shared libraries of the directory by name without opening them, the names already known are kept,
+	//	return the number of plugins recorded
+		size_t discover(const std::filesystem::path& directory)
+		{
+			std::error_code error;
+			size_t count = 0;
+
+			std::unique_lock lock(mutex_);
+
+			for (const auto& file : std::filesystem::directory_iterator(directory, error))
+			{
+				auto extension = file.path().extension();
+				if (!file.is_regular_file(error) || (extension != ".so" && extension != ".dll" && extension != ".dylib")) { continue; }
+
+				auto& entry = entries_[name(file.path())];
+				if (entry) { continue; }
+
+				entry = std::make_unique<Entry>();
+				entry->path = file.path().string();
+				count++;
+			}
+
+			return count;
+		}
+
+	//	the factory of the name, the plugin is opened at the first call, null if the name is unknown or the library has no entry point
+		Factory find(std::string_view name) const
+		{
+			auto entry = this->entry(name);
+
+			if (!entry) { return nullptr; }
+
+			auto factory = entry->factory.load(std::memory_order_acquire);
+			if (factory) { return factory; }
+
+			std::call_once(entry->once, [entry]() { open(*entry); });
+			return entry->factory.load(std::memory_order_acquire);
+		}
+
+		std::unique_ptr<Optimizor> create(std::string_view name) const
+		{
+			auto factory = find(name);
+			return std::unique_ptr<Optimizor>(factory ? static_cast<Optimizor*>(factory()) : nullptr);
+		}
+
+		std::vector<std::string> names() const
+		{
+			std::shared_lock lock(mutex_);
+
+			std::vector<std::string> result;
+			for (const auto& [name, entry] : entries_) { result.push_back(name); }
+			return result;
+		}
+
+	//	the optimizers made by the plugins have to be destroyed before
+		~Registry()
+		{
+			for (auto& [name, entry] : entries_)
+			{
+#ifdef _WINDOWS_
+				entry->handle ? void(FreeLibrary(static_cast<HMODULE>(entry->handle))) : void();
+#else
+				entry->handle ? void(dlclose(entry->handle)) : void();
+#endif
+			}
+		}
+	};
+}
+
+//	register the factory of a static build under the name when the program starts, without any library to open, in place of the
+//	create entry point of the plugins, so several optimizers link into one program without clashing entry points, a program
+//	linking the static library can call register_<name>() to pull the registration out of the archive
+#define REGISTER_OPTIMIZOR(name, factory) \
+	bool register_##name() { static const bool registered = ::math::Registry::instance().add(#name, factory); return registered; } \
+	static const bool registered_optimizor_ = register_##name();
+#endif //!_MATH_OPTIMIZATION_REGISTRY_
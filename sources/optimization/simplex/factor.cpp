@@ -0,0 +1,252 @@
+#include <cmath>
+#include <numeric>
+#include <algorithm>
+
+#include "factor.h"
+
+namespace math
+{
+	void Factor::reach(const std::vector<std::pair<size_t, double>>& entries)
+	{
+		++stamp_;
+		pattern_.clear();
+
+		for (auto& [row, value] : entries)
+		{
+			if (marks_[row] == stamp_) { continue; }
+
+			marks_[row] = stamp_;
+			stack_.assign(1, row);
+			children_.assign(1, ranks_[row] == none ? 0 : lstarts_[ranks_[row]]);
+
+		//	the rows go out once all the rows their L column reaches are out, so the reversed order is topological
+			while (!stack_.empty())
+			{
+				size_t top = stack_.back(), rank = ranks_[top], end = rank == none ? 0 : lstarts_[rank + 1];
+				size_t& next = children_.back();
+
+				while (next < end && marks_[lrows_[next]] == stamp_) { ++next; }
+
+				if (next < end)
+				{
+					size_t child = lrows_[next++];
+					marks_[child] = stamp_;
+					stack_.push_back(child);
+					children_.push_back(ranks_[child] == none ? 0 : lstarts_[ranks_[child]]);
+				}
+				else
+				{
+					pattern_.push_back(top);
+					stack_.pop_back();
+					children_.pop_back();
+				}
+			}
+		}
+
+		std::reverse(pattern_.begin(), pattern_.end());
+	}
+
+	std::vector<std::pair<size_t, size_t>> Factor::factorize(size_t size, const Column& column)
+	{
+		size_ = size;
+
+		lstarts_.assign(1, 0);
+		lrows_.clear();
+		lvalues_.clear();
+		ustarts_.assign(1, 0);
+		urows_.clear();
+		uvalues_.clear();
+		diagonal_.clear();
+		pivots_.clear();
+		positions_.clear();
+		ranks_.assign(size, none);
+
+		estarts_.assign(1, 0);
+		erows_.clear();
+		epositions_.clear();
+		evalues_.clear();
+		epivots_.clear();
+
+		work_.assign(size, 0.0);
+		solve_.assign(size, 0.0);
+		marks_.assign(size, 0);
+		counts_.assign(size, 0);
+		stamp_ = 0;
+
+	//	the entries of the columns and of the rows, the columns with the fewest entries are pivoted first
+		std::vector<size_t> lengths(size), order(size);
+
+		for (size_t p = 0; p < size; ++p)
+		{
+			column(p, entries_);
+			lengths[p] = entries_.size();
+			for (auto& [row, value] : entries_) { counts_[row]++; }
+		}
+
+		std::iota(order.begin(), order.end(), 0);
+		std::stable_sort(order.begin(), order.end(), [&lengths](size_t lhs, size_t rhs) { return lengths[lhs] < lengths[rhs]; });
+
+		std::vector<size_t> singulars;
+
+		for (auto position : order)
+		{
+			column(position, entries_);
+			reach(entries_);
+
+			for (auto& [row, value] : entries_) { work_[row] = value; }
+
+			for (auto row : pattern_)
+			{
+				size_t rank = ranks_[row];
+				double value = work_[row];
+
+				if (rank == none || value == 0) { continue; }
+				for (size_t e = lstarts_[rank]; e < lstarts_[rank + 1]; ++e) { work_[lrows_[e]] -= lvalues_[e] * value; }
+			}
+
+		//	the largest candidate first, then the one with the fewest entries in its row among those within the threshold of it
+			double largest = 0;
+			for (auto row : pattern_) { largest = ranks_[row] == none ? std::max(largest, std::abs(work_[row])) : largest; }
+
+			size_t pivot = none;
+
+			for (auto row : pattern_)
+			{
+				if (ranks_[row] != none || std::abs(work_[row]) < threshold_ * largest) { continue; }
+				pivot = pivot == none || counts_[row] < counts_[pivot] || (counts_[row] == counts_[pivot] && std::abs(work_[row]) > std::abs(work_[pivot])) ? row : pivot;
+			}
+
+			if (largest < singular_)
+			{
+				singulars.push_back(position);
+				for (auto row : pattern_) { work_[row] = 0; }
+				continue;
+			}
+
+			size_t rank = pivots_.size();
+			double diagonal = work_[pivot];
+
+			for (auto row : pattern_)
+			{
+				double value = work_[row];
+				work_[row] = 0;
+
+				if (row == pivot || std::abs(value) < drop_) { continue; }
+
+				if (ranks_[row] != none)
+				{
+					urows_.push_back(ranks_[row]);
+					uvalues_.push_back(value);
+				}
+				else
+				{
+					lrows_.push_back(row);
+					lvalues_.push_back(value / diagonal);
+				}
+			}
+
+			ranks_[pivot] = rank;
+			pivots_.push_back(pivot);
+			positions_.push_back(position);
+			diagonal_.push_back(diagonal);
+			lstarts_.push_back(lrows_.size());
+			ustarts_.push_back(urows_.size());
+		}
+
+	//	every singular column pairs with a row left without pivot
+		std::vector<std::pair<size_t, size_t>> replacements;
+
+		for (size_t row = 0, s = 0; row < size && s < singulars.size(); ++row)
+		{
+			ranks_[row] == none ? void(replacements.emplace_back(singulars[s++], row)) : void();
+		}
+
+		return replacements;
+	}
+
+	void Factor::ftran(double* values)
+	{
+		for (size_t t = 0; t < size_; ++t)
+		{
+			double value = values[pivots_[t]];
+			solve_[t] = value;
+
+			if (value == 0) { continue; }
+			for (size_t e = lstarts_[t]; e < lstarts_[t + 1]; ++e) { values[lrows_[e]] -= lvalues_[e] * value; }
+		}
+
+		for (size_t k = size_; k-- > 0;)
+		{
+			double value = solve_[k] / diagonal_[k];
+			solve_[k] = value;
+
+			if (value == 0) { continue; }
+			for (size_t e = ustarts_[k]; e < ustarts_[k + 1]; ++e) { solve_[urows_[e]] -= uvalues_[e] * value; }
+		}
+
+		for (size_t k = 0; k < size_; ++k) { values[positions_[k]] = solve_[k]; }
+
+		for (size_t u = 0; u < epositions_.size(); ++u)
+		{
+			size_t position = epositions_[u];
+			double value = values[position] / epivots_[u];
+			values[position] = value;
+
+			if (value == 0) { continue; }
+			for (size_t e = estarts_[u]; e < estarts_[u + 1]; ++e) { values[erows_[e]] -= evalues_[e] * value; }
+		}
+	}
+
+	void Factor::btran(double* values)
+	{
+		for (size_t u = epositions_.size(); u-- > 0;)
+		{
+			double value = values[epositions_[u]];
+			for (size_t e = estarts_[u]; e < estarts_[u + 1]; ++e) { value -= evalues_[e] * values[erows_[e]]; }
+			values[epositions_[u]] = value / epivots_[u];
+		}
+
+		for (size_t k = 0; k < size_; ++k)
+		{
+			double value = values[positions_[k]];
+			for (size_t e = ustarts_[k]; e < ustarts_[k + 1]; ++e) { value -= uvalues_[e] * solve_[urows_[e]]; }
+			solve_[k] = value / diagonal_[k];
+		}
+
+		for (size_t t = size_; t-- > 0;)
+		{
+			double value = solve_[t];
+			for (size_t e = lstarts_[t]; e < lstarts_[t + 1]; ++e) { value -= lvalues_[e] * values[lrows_[e]]; }
+			values[pivots_[t]] = value;
+		}
+	}
+
+	void Factor::update(size_t position, const double* solution)
+	{
+		for (size_t i = 0; i < size_; ++i)
+		{
+			if (i == position || std::abs(solution[i]) < drop_) { continue; }
+
+			erows_.push_back(i);
+			evalues_.push_back(solution[i]);
+		}
+
+		estarts_.push_back(erows_.size());
+		epositions_.push_back(position);
+		epivots_.push_back(solution[position]);
+	}
+
+	size_t Factor::updates() const
+	{
+		return epositions_.size();
+	}
+
+	size_t Factor::size() const
+	{
+		return size_;
+	}
+
+	Factor::Factor() : size_(0), stamp_(0)
+	{
+	}
+}
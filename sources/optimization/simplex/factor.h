@@ -0,0 +1,72 @@
+#include <limits>
+#include <vector>
+#include <utility>
+#include <cstddef>
+#include <functional>
+
+#ifndef _MATH_OPTIMIZATION_FACTOR_
+#define _MATH_OPTIMIZATION_FACTOR_
+namespace math
+{
+//	the sparse LU factors of a basis, left looking column by column after Gilbert and Peierls, each column solved against the
+//	factors so far through a depth first search of its reach, then pivoted on the entry within a threshold of the largest with the
+//	fewest entries in its row, the unit columns go first since they pivot without any fill,
+//	the changes of the basis are appended as eta columns of the product form until the next factorization
+	class Factor
+	{
+	public:
+	//	the rows and the values of a column of the basis at a position
+		using Column = std::function<void(size_t position, std::vector<std::pair<size_t, double>>& entries)>;
+
+		static constexpr size_t none = std::numeric_limits<size_t>::max();
+
+	private:
+	//	the fraction of the largest entry a pivot may have, and the magnitude under which a column is singular
+		static constexpr double threshold_ = 0.1, singular_ = 1e-11, drop_ = 1e-14;
+
+		size_t size_;
+
+	//	L by columns in pivot order, its unit diagonal left out, the rows are the ones of the basis
+		std::vector<size_t> lstarts_, lrows_;
+		std::vector<double> lvalues_;
+
+	//	U by columns in pivot order, the diagonal apart, the rows are the pivot orders
+		std::vector<size_t> ustarts_, urows_;
+		std::vector<double> uvalues_, diagonal_;
+
+	//	the row and the basis position of every pivot, and the pivot order of every row
+		std::vector<size_t> pivots_, positions_, ranks_;
+
+	//	the eta columns, their positions and their pivots
+		std::vector<size_t> estarts_, erows_, epositions_;
+		std::vector<double> evalues_, epivots_;
+
+	//	the scratch of the factorization and of the solves
+		std::vector<double> work_, solve_;
+		std::vector<size_t> stack_, children_, pattern_, marks_, counts_;
+		std::vector<std::pair<size_t, double>> entries_;
+		size_t stamp_;
+
+	private:
+	//	the nonzero rows reached from the column in topological order of the pivots
+		void reach(const std::vector<std::pair<size_t, double>>& entries);
+
+	public:
+	//	factorizes the basis, the positions whose columns are singular come back with the unpivoted rows they should take as unit columns
+		std::vector<std::pair<size_t, size_t>> factorize(size_t size, const Column& column);
+
+	//	solves B x = b in place, b by rows and x by positions, and B' y = c, c by positions and y by rows
+		void ftran(double* values);
+		void btran(double* values);
+
+	//	the column at the position is replaced by the one whose solution against the basis is given
+		void update(size_t position, const double* solution);
+
+		size_t updates() const;
+		size_t size() const;
+
+	public:
+		Factor();
+	};
+}
+#endif //!_MATH_OPTIMIZATION_FACTOR_
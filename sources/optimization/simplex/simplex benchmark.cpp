@@ -0,0 +1,131 @@
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+#include "simplex.h"
+
+using math::Simplex;
+
+//	a transportation problem with losses on random arcs by compressed sparse rows, every demand reaches a few supplies, which hold enough
+//	for all and spend between one and two units per unit delivered,
+//	the costs are either positive, so the logical basis is dual feasible, or of both signs with bounded demands, so it is not
+struct Transportation
+{
+	size_t rows, columns;
+	std::vector<size_t> offsets, indices;
+	std::vector<double> values, costs, lower, upper, rlower, rupper;
+
+	Transportation(size_t supplies, size_t demands, size_t arcs, bool profits, unsigned seed)
+	{
+		std::mt19937_64 generator(seed);
+		std::uniform_real_distribution<double> uniform(0.0, 1.0);
+		std::uniform_int_distribution<size_t> supply(0, supplies - 1);
+
+		rows = supplies + demands;
+		columns = demands * arcs;
+
+		std::vector<size_t> choices(columns);
+		std::vector<double> losses(columns);
+
+		for (size_t j = 0; j < columns; ++j)
+		{
+			choices[j] = supply(generator);
+			losses[j] = 1.0 + uniform(generator);
+			costs.push_back(profits ? uniform(generator) - 0.5 : 1.0 + uniform(generator));
+		}
+
+	//	the supply rows gather their arcs, the demand rows hold theirs in a run
+		offsets.assign(rows + 1, 0);
+		for (size_t j = 0; j < columns; ++j) { offsets[choices[j] + 1]++; }
+		for (size_t i = 0; i < supplies; ++i) { offsets[i + 1] += offsets[i]; }
+		for (size_t d = 0; d < demands; ++d) { offsets[supplies + d + 1] = offsets[supplies + d] + arcs; }
+
+		indices.resize(columns * 2);
+		values.assign(columns * 2, 1.0);
+
+		std::vector<size_t> next(offsets.begin(), offsets.begin() + supplies);
+		for (size_t j = 0; j < columns; ++j)
+		{
+			values[next[choices[j]]] = losses[j];
+			indices[next[choices[j]]++] = j;
+			indices[offsets[supplies + j / arcs] + j % arcs] = j;
+		}
+
+		lower.assign(columns, 0.0);
+		upper.assign(columns, Simplex::infinity);
+
+		rlower.assign(supplies, -Simplex::infinity);
+		rupper.assign(supplies, double(demands * 4) / supplies + 2);
+
+		for (size_t d = 0; d < demands; ++d)
+		{
+			rlower.push_back(1.0 + uniform(generator));
+			rupper.push_back(profits ? 4.0 : Simplex::infinity);
+		}
+	}
+};
+
+//	usage : simplex_benchmark [demands] [supplies] [arcs]
+int main(int argc, char* argv[])
+{
+	size_t demands = argc > 1 ? std::stoul(argv[1]) : 2000, supplies = argc > 2 ? std::stoul(argv[2]) : demands / 10, arcs = argc > 3 ? std::stoul(argv[3]) : 4;
+
+	const char* names[] = { "dantzig", "partial", "devex" };
+	const char* statuses[] = { "unsolved", "optimal", "infeasible", "unbounded", "limit" };
+
+	std::printf("%-10s %8s %8s %10s %10s %16s %10s %12s\n", "problem", "rows", "columns", "pricing", "status", "objective", "iters", "seconds");
+
+	for (bool profits : { false, true })
+	{
+		Transportation problem(supplies, demands, arcs, profits, 7);
+
+		auto load = [&problem](Simplex::Pricing pricing)
+			{
+				Simplex simplex(problem.rows, problem.columns, problem.offsets.data(), problem.indices.data(), problem.values.data());
+				simplex.costs(problem.costs.data());
+				simplex.bounds(problem.lower.data(), problem.upper.data());
+				simplex.ranges(problem.rlower.data(), problem.rupper.data());
+
+				Simplex::Options options;
+				options.pricing = pricing;
+				simplex.configure(options);
+				return simplex;
+			};
+
+		auto solve = [&](Simplex& simplex, const char* name)
+			{
+				auto start = std::chrono::steady_clock::now();
+				auto status = simplex.solve();
+				double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+				std::printf("%-10s %8zu %8zu %10s %10s %16.6f %10zu %12.3f\n", profits ? "profits" : "costs", problem.rows, problem.columns,
+					name, statuses[int(status)], simplex.objective(), simplex.iterations(), seconds);
+
+				return status == Simplex::Status::optimal;
+			};
+
+		for (auto pricing : { Simplex::Pricing::dantzig, Simplex::Pricing::partial, Simplex::Pricing::devex })
+		{
+			auto simplex = load(pricing);
+			if (!solve(simplex, names[int(pricing)])) { return 1; }
+		}
+
+	//	the demands then the costs move by up to a tenth, solved again from the last basis
+		std::mt19937_64 generator(11);
+		std::uniform_real_distribution<double> uniform(0.9, 1.1);
+
+		auto simplex = load(Simplex::Pricing::devex);
+		simplex.solve();
+
+		for (size_t i = supplies; i < problem.rows; ++i) { problem.rlower[i] *= uniform(generator); }
+		simplex.ranges(problem.rlower.data(), problem.rupper.data());
+		if (!solve(simplex, "ranges")) { return 1; }
+
+		for (auto& cost : problem.costs) { cost *= uniform(generator); }
+		simplex.costs(problem.costs.data());
+		if (!solve(simplex, "costs")) { return 1; }
+	}
+
+	return 0;
+}
@@ -0,0 +1,207 @@
+#include <cmath>
+#include <random>
+#include <vector>
+#include <iostream>
+#include "simplex.h"
+
+using math::Simplex;
+
+//	a problem by compressed sparse rows
+struct Problem
+{
+	size_t rows, columns;
+	std::vector<size_t> offsets, indices;
+	std::vector<double> values, costs, lower, upper, rlower, rupper;
+};
+
+Simplex load(const Problem& problem)
+{
+	Simplex simplex(problem.rows, problem.columns, problem.offsets.data(), problem.indices.data(), problem.values.data());
+	simplex.costs(problem.costs.data());
+	simplex.bounds(problem.lower.data(), problem.upper.data());
+	simplex.ranges(problem.rlower.data(), problem.rupper.data());
+	return simplex;
+}
+
+//	the solution is feasible and the duals certify its optimality, the reduced costs and the duals of the rows
+//	have the signs of the bounds their variables rest on
+bool optimal(const Problem& problem, const Simplex& simplex)
+{
+	const double tolerance = 1e-6;
+	const double *x = simplex.solution(), *y = simplex.duals();
+
+	auto check = [tolerance](double value, double lower, double upper, double reduced)
+		{
+			if (value < lower - tolerance || value > upper + tolerance) { return false; }
+			if (value > lower + tolerance && reduced > tolerance) { return false; }
+			return !(value < upper - tolerance && reduced < -tolerance);
+		};
+
+	std::vector<double> reduced(problem.costs);
+
+	for (size_t i = 0; i < problem.rows; ++i)
+	{
+		double activity = 0;
+
+		for (size_t e = problem.offsets[i]; e < problem.offsets[i + 1]; ++e)
+		{
+			activity += problem.values[e] * x[problem.indices[e]];
+			reduced[problem.indices[e]] -= problem.values[e] * y[i];
+		}
+
+		if (!check(activity, problem.rlower[i], problem.rupper[i], y[i])) { return false; }
+	}
+
+	for (size_t j = 0; j < problem.columns; ++j)
+	{
+		if (!check(x[j], problem.lower[j], problem.upper[j], reduced[j])) { return false; }
+	}
+
+	return true;
+}
+
+//	a transportation problem with losses on random arcs, every demand reaches a few supplies, which hold enough for all
+Problem transportation(size_t supplies, size_t demands, size_t arcs, bool profits, std::mt19937_64& generator)
+{
+	std::uniform_real_distribution<double> uniform(0.0, 1.0);
+	std::uniform_int_distribution<size_t> supply(0, supplies - 1);
+
+	Problem problem;
+	problem.rows = supplies + demands;
+	problem.columns = demands * arcs;
+
+	std::vector<std::vector<std::pair<size_t, double>>> rows(problem.rows);
+
+	for (size_t d = 0, j = 0; d < demands; ++d)
+	{
+		for (size_t a = 0; a < arcs; ++a, ++j)
+		{
+			rows[supply(generator)].emplace_back(j, 1.0 + uniform(generator));
+			rows[supplies + d].emplace_back(j, 1.0);
+			problem.costs.push_back(profits ? uniform(generator) - 0.5 : 1.0 + uniform(generator));
+		}
+	}
+
+	problem.offsets.push_back(0);
+
+	for (auto& row : rows)
+	{
+		for (auto [index, value] : row)
+		{
+			problem.indices.push_back(index);
+			problem.values.push_back(value);
+		}
+
+		problem.offsets.push_back(problem.indices.size());
+	}
+
+	problem.lower.assign(problem.columns, 0.0);
+	problem.upper.assign(problem.columns, Simplex::infinity);
+
+	for (size_t s = 0; s < supplies; ++s)
+	{
+		problem.rlower.push_back(-Simplex::infinity);
+		problem.rupper.push_back(double(demands * 4) / supplies + 2);
+	}
+
+	for (size_t d = 0; d < demands; ++d)
+	{
+		problem.rlower.push_back(1.0 + uniform(generator));
+		problem.rupper.push_back(profits ? 4.0 : Simplex::infinity);
+	}
+
+	return problem;
+}
+
+int main()
+{
+//	max 3x + 5y, x <= 4, 2y <= 12, 3x + 2y <= 18, solved by the primal simplex since the costs leave no dual feasible start
+	Problem wyndor{ 3, 2, { 0, 1, 2, 4 }, { 0, 1, 0, 1 }, { 1, 2, 3, 2 }, { -3, -5 }, { 0, 0 }, { Simplex::infinity, Simplex::infinity },
+		{ -Simplex::infinity, -Simplex::infinity, -Simplex::infinity }, { 4, 12, 18 } };
+
+	auto simplex = load(wyndor);
+	auto status = simplex.solve();
+	std::cout << "wyndor " << simplex.objective() << " at " << simplex.solution()[0] << " " << simplex.solution()[1] << " in " << simplex.iterations() << " iterations" << std::endl;
+
+	if (status != Simplex::Status::optimal || std::abs(simplex.objective() + 36) > 1e-9 || !optimal(wyndor, simplex)) { return 1; }
+
+//	min 2x + 3y, x + y >= 4, x + 3y >= 6, solved by the dual simplex from the logical basis
+	Problem diet{ 2, 2, { 0, 2, 4 }, { 0, 1, 0, 1 }, { 1, 1, 1, 3 }, { 2, 3 }, { 0, 0 }, { Simplex::infinity, Simplex::infinity },
+		{ 4, 6 }, { Simplex::infinity, Simplex::infinity } };
+
+	simplex = load(diet);
+	status = simplex.solve();
+	std::cout << "diet " << simplex.objective() << " at " << simplex.solution()[0] << " " << simplex.solution()[1] << " in " << simplex.iterations() << " iterations" << std::endl;
+
+	if (status != Simplex::Status::optimal || std::abs(simplex.objective() - 9) > 1e-9 || !optimal(diet, simplex)) { return 1; }
+
+//	x + y <= 1 and x + y >= 2
+	Problem infeasible{ 2, 2, { 0, 2, 4 }, { 0, 1, 0, 1 }, { 1, 1, 1, 1 }, { 1, 1 }, { 0, 0 }, { Simplex::infinity, Simplex::infinity },
+		{ -Simplex::infinity, 2 }, { 1, Simplex::infinity } };
+
+	if (load(infeasible).solve() != Simplex::Status::infeasible) { return 1; }
+
+	infeasible.costs = { -1, 1 };
+	if (load(infeasible).solve() != Simplex::Status::infeasible) { return 1; }
+
+//	min -x with x - y <= 1
+	Problem unbounded{ 1, 2, { 0, 2 }, { 0, 1 }, { 1, -1 }, { -1, 0 }, { 0, 0 }, { Simplex::infinity, Simplex::infinity },
+		{ -Simplex::infinity }, { 1 } };
+
+	if (load(unbounded).solve() != Simplex::Status::unbounded) { return 1; }
+
+//	the random problems through both methods and every pricing agree on the optimum
+	std::mt19937_64 generator(7);
+
+	for (bool profits : { false, true })
+	{
+		auto problem = transportation(40, 200, 4, profits, generator);
+		double reference = 0;
+
+		for (auto pricing : { Simplex::Pricing::dantzig, Simplex::Pricing::partial, Simplex::Pricing::devex })
+		{
+			Simplex::Options options;
+			options.pricing = pricing;
+			options.refactor = 20;
+
+			simplex = load(problem);
+			simplex.configure(options);
+			status = simplex.solve();
+
+			std::cout << (profits ? "profits " : "transportation ") << int(pricing) << " " << simplex.objective() << " in " << simplex.iterations() << " iterations" << std::endl;
+
+			if (status != Simplex::Status::optimal || !optimal(problem, simplex)) { return 1; }
+			if (pricing != Simplex::Pricing::dantzig && std::abs(simplex.objective() - reference) > 1e-6 * (1 + std::abs(reference))) { return 1; }
+
+			reference = simplex.objective();
+		}
+	}
+
+//	the right hand sides then the costs move a little, the warm solves from the last basis agree with cold ones in fewer pivots
+	auto problem = transportation(40, 200, 4, false, generator);
+	std::uniform_real_distribution<double> uniform(0.9, 1.1);
+
+	simplex = load(problem);
+	simplex.solve();
+
+	for (size_t round = 0; round < 6; ++round)
+	{
+		bool costs = round % 2;
+
+		for (size_t i = 40; i < problem.rows && !costs; ++i) { problem.rlower[i] *= uniform(generator); }
+		for (size_t j = 0; j < problem.columns && costs; ++j) { problem.costs[j] *= uniform(generator); }
+
+		costs ? simplex.costs(problem.costs.data()) : simplex.ranges(problem.rlower.data(), problem.rupper.data());
+		status = simplex.solve();
+
+		auto cold = load(problem);
+		cold.solve();
+
+		std::cout << (costs ? "costs " : "ranges ") << simplex.objective() << " warm in " << simplex.iterations() << " iterations, cold in " << cold.iterations() << std::endl;
+
+		if (status != Simplex::Status::optimal || !optimal(problem, simplex) || simplex.iterations() >= cold.iterations()) { return 1; }
+		if (std::abs(simplex.objective() - cold.objective()) > 1e-6 * (1 + std::abs(cold.objective()))) { return 1; }
+	}
+
+	return 0;
+}
\ No newline at end of file
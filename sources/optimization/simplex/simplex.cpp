@@ -1,90 +1,731 @@
-#include <mkl.h>
-#include <vector>
+#include <cmath>
+#include <algorithm>
 
-//typedef vector std::vector<double>;
+#include "simplex.h"
 
-//this is the max form
-//the length of the coeffficients is the decisions plus the slacks
-//so does the matrix
-double * Simplex(size_t length, const double * coefficients, const double * matrix, const double * value)
+namespace math
 {
-    size_t column = coefficients.size() + value.size() + 2;
-    vector table(column * value.size(), 0);
-
-    for(size_t c = 0; c < coefficients.size(); ++c)
-    {
-        cblas_scopy(value.size(), &matrix[c], coefficients.size(), &table[c], column);
-    }
-
-    for(size_t r = 0; r < value.size(); ++r)
-    {
-        table[r + coefficients.size() + r * column] = 1;
-    }
-
-    cblas_scopy(value.size(), &value[0], 1, &table[column - 2], column);
-    cblas_sscal(value.size(), 0, &table[column - 1], column);
-
-    std::vector<size_t> indicies(column - 2);
-    std::iota(indicies.begin(), indicies.end(), 0);
-
-    while(true)
-    {
-        std::pair<float, size_t> in {-INFINITY, 0};
-
-        for(size_t i = 0; i < coefficients.size(); ++i)
-        {
-            size_t index = indicies[i];
-
-            float check = (index < coefficeints.size() ? coefficients[index] : 0) - cblas_sdot(value.size(), &table[column - 1], column, &table[index], column);
-
-            if(check > in.first)
-            {
-                in.first = check;
-                in.second = index;
-            }
-        }
-
-        if(!(in.first > 0))
-        {
-            break;
-        }
-
-        std::pair<float, size_t> out{+INFINITY, 0};
-
-        for(size_t r = 0; r < value.size(); ++r)
-        {
-            float check = table[(r + 1) *  column - 2] / table[in.second + r * column];
-
-            if((check > 0) && (check < out.first))
-            {
-                out.first = check;
-                out.second = r;
-            }
-        }
-
-        size_t index = indicies[out.second + coefficients.size()];
-        table[out.second * column - 1] =  index > coefficients.size() ? 0 : coefficients[index];
-
-        std::swap(indices[in.second], indices[out.second]);
-
-        cblas_sscal(column - 1, 1 / table[in.second + out.second * column], &table[out.second * column], 1);
-        for(size_t r = 0; r < value.size(); ++r)
-        {
-            if(r == out.second)
-            {
-                continue;
-            }
-
-            cblas_saxpy(column - 1, -table[r * column + in.second], &table[out.second * column], 1, table[r * column], 1)
-        }
-    }
-
-    vector solution(column - 2);
-
-    for(size_t r = 0; r < value.size(); ++r)
-    {
-        solution[indicies[r + coefficients.size()]] = table[(r + 1)* column - 1];
-    }
-
-    return solution;
-}
\ No newline at end of file
+	void Simplex::column(size_t variable, double* values) const
+	{
+		if (variable >= columns_)
+		{
+			values[variable - columns_] -= 1;
+			return;
+		}
+
+		for (size_t e = coffsets_[variable]; e < coffsets_[variable + 1]; ++e) { values[cindices_[e]] += cvalues_[e]; }
+	}
+
+	void Simplex::refactor()
+	{
+		auto column = [this](size_t position, std::vector<std::pair<size_t, double>>& entries)
+			{
+				size_t variable = heads_[position];
+				entries.clear();
+
+				if (variable >= columns_) { entries.emplace_back(variable - columns_, -1.0); }
+				else
+				{
+					for (size_t e = coffsets_[variable]; e < coffsets_[variable + 1]; ++e) { entries.emplace_back(cindices_[e], cvalues_[e]); }
+				}
+			};
+
+	//	a singular column leaves for the nearest of its bounds, the logical of a row without pivot takes its position
+		for (auto replacements = factor_.factorize(rows_, column); !replacements.empty(); replacements = factor_.factorize(rows_, column))
+		{
+			for (auto [position, row] : replacements)
+			{
+				size_t leaving = heads_[position], entering = columns_ + row;
+				double value = values_[leaving], lower = lower_[leaving], upper = upper_[leaving];
+
+				bool down = std::isfinite(lower) && (!std::isfinite(upper) || value - lower <= upper - value);
+				states_[leaving] = down ? State::lower : std::isfinite(upper) ? State::upper : State::free;
+				values_[leaving] = down ? lower : std::isfinite(upper) ? upper : 0.0;
+				positions_[leaving] = Factor::none;
+
+				heads_[position] = entering;
+				positions_[entering] = position;
+				states_[entering] = State::basic;
+			}
+		}
+	}
+
+	void Simplex::basics()
+	{
+		std::fill(column_.begin(), column_.end(), 0.0);
+
+		for (size_t j = 0; j < total_; ++j)
+		{
+			if (states_[j] == State::basic || values_[j] == 0) { continue; }
+
+			if (j >= columns_) { column_[j - columns_] += values_[j]; }
+			else
+			{
+				for (size_t e = coffsets_[j]; e < coffsets_[j + 1]; ++e) { column_[cindices_[e]] -= cvalues_[e] * values_[j]; }
+			}
+		}
+
+		factor_.ftran(column_.data());
+		for (size_t p = 0; p < rows_; ++p) { values_[heads_[p]] = column_[p]; }
+	}
+
+	void Simplex::prices(const double* costs)
+	{
+		for (size_t p = 0; p < rows_; ++p) { duals_[p] = costs[heads_[p]]; }
+		factor_.btran(duals_.data());
+
+		for (size_t j = 0; j < columns_; ++j)
+		{
+			double reduced = costs[j];
+			for (size_t e = coffsets_[j]; e < coffsets_[j + 1]; ++e) { reduced -= cvalues_[e] * duals_[cindices_[e]]; }
+			reduced_[j] = states_[j] == State::basic ? 0.0 : reduced;
+		}
+
+		for (size_t i = 0; i < rows_; ++i) { reduced_[columns_ + i] = states_[columns_ + i] == State::basic ? 0.0 : costs[columns_ + i] + duals_[i]; }
+	}
+
+	void Simplex::pivot(size_t position)
+	{
+		for (auto j : touched_)
+		{
+			row_[j] = 0;
+			marks_[j] = 0;
+		}
+		touched_.clear();
+
+		std::fill(duals_.begin(), duals_.end(), 0.0);
+		duals_[position] = 1;
+		factor_.btran(duals_.data());
+
+		auto touch = [this](size_t j) { marks_[j] ? void() : (marks_[j] = 1, touched_.push_back(j)); };
+
+		for (size_t i = 0; i < rows_; ++i)
+		{
+			double rho = duals_[i];
+			if (rho == 0) { continue; }
+
+			for (size_t e = roffsets_[i]; e < roffsets_[i + 1]; ++e)
+			{
+				touch(rindices_[e]);
+				row_[rindices_[e]] += rho * rvalues_[e];
+			}
+
+			touch(columns_ + i);
+			row_[columns_ + i] = -rho;
+		}
+	}
+
+	void Simplex::exchange(size_t position, size_t entering)
+	{
+		size_t leaving = heads_[position];
+
+		factor_.update(position, column_.data());
+
+		heads_[position] = entering;
+		positions_[entering] = position;
+		positions_[leaving] = Factor::none;
+		states_[entering] = State::basic;
+		reduced_[entering] = 0;
+	}
+
+	double Simplex::infeasibility(size_t variable) const
+	{
+		double value = values_[variable];
+
+		if (value < lower_[variable] - options_.feasibility) { return value - lower_[variable]; }
+		if (value > upper_[variable] + options_.feasibility) { return value - upper_[variable]; }
+		return 0;
+	}
+
+	bool Simplex::feasible() const
+	{
+		for (auto variable : heads_)
+		{
+			if (infeasibility(variable) != 0) { return false; }
+		}
+
+		return true;
+	}
+
+	size_t Simplex::price()
+	{
+	//	the partial pricing scans blocks from where the last one stopped until one holds a candidate
+		bool partial = options_.pricing == Pricing::partial, devex = options_.pricing == Pricing::devex;
+		size_t block = partial ? std::max(total_ / 8, std::min<size_t>(total_, 1000)) : total_;
+
+		size_t best = Factor::none;
+		double score = 0, tolerance = options_.optimality;
+
+		for (size_t k = 0; k < total_; ++k)
+		{
+			size_t j = partial ? (offset_ + k) % total_ : k;
+			double reduced = reduced_[j];
+			State state = states_[j];
+
+			bool candidate = (state == State::lower && reduced < -tolerance) || (state == State::upper && reduced > tolerance) || (state == State::free && std::abs(reduced) > tolerance);
+
+		//	the comparison is multiplied through by the weight, the fixed columns never enter
+			if (candidate && reduced * reduced > score * (devex ? weights_[j] : 1.0) && lower_[j] != upper_[j])
+			{
+				best = j;
+				score = reduced * reduced / (devex ? weights_[j] : 1.0);
+			}
+
+			if (partial && best != Factor::none && (k + 1) % block == 0)
+			{
+				offset_ = (offset_ + k + 1) % total_;
+				break;
+			}
+		}
+
+		return best;
+	}
+
+	bool Simplex::phase(size_t leaving)
+	{
+		bool feasible = this->feasible(), changed = false;
+
+	//	the nonbasic costs change with the phase, or once a basic variable of the first phase leaves
+		auto shift = [this, feasible](size_t j)
+			{
+				double cost = feasible ? costs_[j] : 0.0;
+				reduced_[j] += cost - costing_[j];
+				costing_[j] = cost;
+			};
+
+		if (feasible != second_)
+		{
+			for (size_t j = 0; j < total_; ++j) { states_[j] == State::basic ? void() : shift(j); }
+		}
+		else if (leaving != Factor::none) { shift(leaving); }
+
+		second_ = feasible;
+
+		for (size_t p = 0; p < rows_; ++p)
+		{
+			size_t variable = heads_[p];
+			double infeasibility = this->infeasibility(variable), cost = feasible ? costs_[variable] : infeasibility < 0 ? -1.0 : infeasibility > 0 ? 1.0 : 0.0;
+
+			duals_[p] = cost - costing_[variable];
+			costing_[variable] = cost;
+			changed = changed || duals_[p] != 0;
+		}
+
+		if (!changed) { return feasible; }
+
+	//	the changes of the basic costs move the duals, which move the reduced costs of the columns on their rows
+		factor_.btran(duals_.data());
+
+		for (size_t i = 0; i < rows_; ++i)
+		{
+			double dual = duals_[i];
+			if (dual == 0) { continue; }
+
+			for (size_t e = roffsets_[i]; e < roffsets_[i + 1]; ++e)
+			{
+				states_[rindices_[e]] == State::basic ? void() : void(reduced_[rindices_[e]] -= rvalues_[e] * dual);
+			}
+
+			states_[columns_ + i] == State::basic ? void() : void(reduced_[columns_ + i] += dual);
+		}
+
+		return feasible;
+	}
+
+	Simplex::Status Simplex::primal()
+	{
+		costing_ = costs_;
+		second_ = true;
+		prices(costing_.data());
+
+		bool feasible = phase(), verified = false;
+
+		while (iterations_ < options_.maximum)
+		{
+			size_t entering = price();
+
+		//	the optimum is checked again against fresh factors before it is trusted
+			if (entering == Factor::none)
+			{
+				if (factor_.updates() && !verified)
+				{
+					refactor();
+					basics();
+					prices(costing_.data());
+					feasible = phase();
+					verified = true;
+					continue;
+				}
+
+				return feasible ? Status::optimal : Status::infeasible;
+			}
+
+			verified = false;
+			double direction = reduced_[entering] < 0 ? 1.0 : -1.0;
+
+			std::fill(column_.begin(), column_.end(), 0.0);
+			column(entering, column_.data());
+			factor_.ftran(column_.data());
+
+		//	the first pass bounds the step by the ratios relaxed by the tolerance, the second takes the largest pivot within the bound,
+		//	a basic variable out of its bounds in the first phase may move freely away from the bound it violates
+			auto target = [this](size_t variable, double rate)
+				{
+					double value = values_[variable], lower = lower_[variable], upper = upper_[variable];
+					if (rate < 0) { return value > upper + options_.feasibility ? upper : value < lower - options_.feasibility ? -infinity : lower; }
+					return value < lower - options_.feasibility ? lower : value > upper + options_.feasibility ? infinity : upper;
+				};
+
+			double bound = infinity;
+
+			for (size_t p = 0; p < rows_; ++p)
+			{
+				double rate = -direction * column_[p];
+				if (std::abs(rate) < options_.pivot) { continue; }
+
+				size_t variable = heads_[p];
+				double limit = target(variable, rate);
+				if (!std::isfinite(limit)) { continue; }
+
+				bound = std::min(bound, std::max((limit - values_[variable]) / rate, 0.0) + options_.feasibility / std::abs(rate));
+			}
+
+			size_t leaving = Factor::none;
+			double step = infinity, largest = 0;
+
+			for (size_t p = 0; p < rows_ && std::isfinite(bound); ++p)
+			{
+				double rate = -direction * column_[p];
+				if (std::abs(rate) < options_.pivot) { continue; }
+
+				size_t variable = heads_[p];
+				double limit = target(variable, rate);
+				if (!std::isfinite(limit)) { continue; }
+
+				double ratio = (limit - values_[variable]) / rate;
+				if (ratio > bound || std::abs(rate) <= largest) { continue; }
+
+				leaving = p;
+				largest = std::abs(rate);
+				step = std::max(ratio, 0.0);
+			}
+
+			double span = upper_[entering] - lower_[entering];
+
+			if (leaving == Factor::none && !std::isfinite(span)) { return Status::unbounded; }
+
+			iterations_++;
+
+		//	the entering variable reaches its other bound first, the basis stays
+			if (span <= step)
+			{
+				for (size_t p = 0; p < rows_; ++p) { values_[heads_[p]] -= direction * span * column_[p]; }
+
+				states_[entering] = direction > 0 ? State::upper : State::lower;
+				values_[entering] = direction > 0 ? upper_[entering] : lower_[entering];
+				feasible = phase();
+				continue;
+			}
+
+			pivot(leaving);
+
+			double alpha = row_[entering];
+
+			if (std::abs(alpha - column_[leaving]) > 1e-6 * (1 + std::abs(column_[leaving])))
+			{
+				refactor();
+				basics();
+				prices(costing_.data());
+				feasible = phase();
+				continue;
+			}
+
+			size_t variable = heads_[leaving];
+			double limit = target(variable, -direction * column_[leaving]);
+
+			for (size_t p = 0; p < rows_; ++p) { values_[heads_[p]] -= direction * step * column_[p]; }
+			values_[entering] += direction * step;
+			values_[variable] = limit;
+			states_[variable] = limit == lower_[variable] ? State::lower : State::upper;
+
+			double ratio = reduced_[entering] / alpha, weight = weights_[entering];
+
+			for (auto j : touched_)
+			{
+				if (states_[j] == State::basic || j == entering) { continue; }
+
+				reduced_[j] -= ratio * row_[j];
+				weights_[j] = std::max(weights_[j], row_[j] * row_[j] / (alpha * alpha) * weight);
+			}
+
+			reduced_[variable] = -ratio;
+			weights_[variable] = std::max(weight / (alpha * alpha), 1.0);
+
+		//	the reference framework of the devex weights starts again once they grow too large
+			weights_[variable] > 1e6 ? std::fill(weights_.begin(), weights_.end(), 1.0) : void();
+
+			exchange(leaving, entering);
+
+			if (factor_.updates() >= options_.refactor)
+			{
+				refactor();
+				basics();
+				prices(costing_.data());
+			}
+
+			feasible = phase(variable);
+		}
+
+		return Status::limit;
+	}
+
+	Simplex::Status Simplex::dual()
+	{
+		bool verified = false;
+
+	//	the squared infeasibilities by positions, measured again only where the values move
+		auto measure = [this](size_t p)
+			{
+				double infeasibility = this->infeasibility(heads_[p]);
+				infeasibilities_[p] = infeasibility * infeasibility;
+			};
+
+		auto restart = [this, &measure]()
+			{
+				refactor();
+				basics();
+				prices(costs_.data());
+				for (size_t p = 0; p < rows_; ++p) { measure(p); }
+			};
+
+		for (size_t p = 0; p < rows_; ++p) { measure(p); }
+
+		while (iterations_ < options_.maximum)
+		{
+		//	the basic variable leaving is the most infeasible relative to its devex weight
+			size_t leaving = Factor::none;
+			double score = 0;
+
+			for (size_t p = 0; p < rows_; ++p)
+			{
+				if (infeasibilities_[p] > score * dweights_[p])
+				{
+					leaving = p;
+					score = infeasibilities_[p] / dweights_[p];
+				}
+			}
+
+			if (leaving == Factor::none)
+			{
+				if (factor_.updates() && !verified)
+				{
+					restart();
+					verified = true;
+					continue;
+				}
+
+				return Status::optimal;
+			}
+
+			size_t variable = heads_[leaving];
+			double infeasibility = this->infeasibility(variable), sign = infeasibility < 0 ? -1.0 : 1.0;
+			double limit = infeasibility < 0 ? lower_[variable] : upper_[variable];
+
+			pivot(leaving);
+
+		//	the entering candidates move the leaving variable towards its bound, the dual slacks bound the dual step
+			auto slack = [this](size_t j) { return states_[j] == State::lower ? reduced_[j] : states_[j] == State::upper ? -reduced_[j] : std::abs(reduced_[j]); };
+			auto eligible = [this, sign](size_t j)
+				{
+					double alpha = row_[j] * sign;
+					if (states_[j] == State::basic || lower_[j] == upper_[j] || std::abs(alpha) < options_.pivot) { return false; }
+					return states_[j] == State::free || (states_[j] == State::lower ? alpha > 0 : alpha < 0);
+				};
+
+			double bound = infinity;
+
+			for (auto j : touched_)
+			{
+				eligible(j) ? void(bound = std::min(bound, (std::max(slack(j), 0.0) + options_.optimality) / std::abs(row_[j]))) : void();
+			}
+
+			size_t entering = Factor::none;
+			double largest = 0;
+
+			for (auto j : touched_)
+			{
+				if (!eligible(j) || slack(j) / std::abs(row_[j]) > bound || std::abs(row_[j]) <= largest) { continue; }
+
+				entering = j;
+				largest = std::abs(row_[j]);
+			}
+
+		//	no dual step is bounded, so the rows cannot be satisfied
+			if (entering == Factor::none)
+			{
+				if (factor_.updates() && !verified)
+				{
+					restart();
+					verified = true;
+					continue;
+				}
+
+				return Status::infeasible;
+			}
+
+			verified = false;
+			iterations_++;
+
+			std::fill(column_.begin(), column_.end(), 0.0);
+			column(entering, column_.data());
+			factor_.ftran(column_.data());
+
+			double alpha = row_[entering];
+
+			if (std::abs(alpha - column_[leaving]) > 1e-6 * (1 + std::abs(column_[leaving])))
+			{
+				restart();
+				continue;
+			}
+
+			double step = (values_[variable] - limit) / alpha;
+
+			double ratio = reduced_[entering] / alpha, weight = dweights_[leaving] / (alpha * alpha);
+
+			for (size_t p = 0; p < rows_; ++p)
+			{
+				double value = column_[p];
+				if (value == 0) { continue; }
+
+				values_[heads_[p]] -= step * value;
+				dweights_[p] = std::max(dweights_[p], value * value * weight);
+				measure(p);
+			}
+
+			values_[entering] += step;
+			values_[variable] = limit;
+			states_[variable] = infeasibility < 0 ? State::lower : State::upper;
+
+			for (auto j : touched_)
+			{
+				(states_[j] == State::basic || j == entering) ? void() : void(reduced_[j] -= ratio * row_[j]);
+			}
+			reduced_[variable] = -ratio;
+
+			dweights_[leaving] = std::max(weight, 1.0);
+
+			exchange(leaving, entering);
+			measure(leaving);
+
+			if (factor_.updates() >= options_.refactor)
+			{
+				restart();
+			}
+		}
+
+		return Status::limit;
+	}
+
+	void Simplex::costs(const double* costs)
+	{
+		std::copy(costs, costs + columns_, costs_.begin());
+		status_ = Status::unsolved;
+	}
+
+	void Simplex::bounds(const double* lower, const double* upper)
+	{
+		for (size_t j = 0; j < columns_; ++j)
+		{
+			if (lower[j] > upper[j]) { throw std::invalid_argument("the lower bound of a column exceeds its upper bound"); }
+		}
+
+		std::copy(lower, lower + columns_, lower_.begin());
+		std::copy(upper, upper + columns_, upper_.begin());
+		status_ = Status::unsolved;
+	}
+
+	void Simplex::ranges(const double* lower, const double* upper)
+	{
+		for (size_t i = 0; i < rows_; ++i)
+		{
+			if (lower[i] > upper[i]) { throw std::invalid_argument("the lower bound of a row exceeds its upper bound"); }
+		}
+
+		std::copy(lower, lower + rows_, lower_.begin() + columns_);
+		std::copy(upper, upper + rows_, upper_.begin() + columns_);
+		status_ = Status::unsolved;
+	}
+
+	void Simplex::configure(const Options& options)
+	{
+		options_ = options;
+	}
+
+	void Simplex::settle()
+	{
+		for (size_t j = 0; j < total_; ++j)
+		{
+			State state = states_[j];
+			if (state == State::basic) { continue; }
+
+			bool down = std::isfinite(lower_[j]), up = std::isfinite(upper_[j]);
+			bool lost = (state == State::lower && !down) || (state == State::upper && !up) || (state == State::free && (down || up));
+
+			state = !lost ? state : costs_[j] < 0 && up ? State::upper : down ? State::lower : up ? State::upper : State::free;
+			states_[j] = state;
+			values_[j] = state == State::lower ? lower_[j] : state == State::upper ? upper_[j] : 0.0;
+		}
+	}
+
+	Simplex::Status Simplex::solve()
+	{
+		iterations_ = 0;
+		offset_ = 0;
+
+	//	the logicals make the first basis, the columns start at the bound their cost points to, so the start is often dual feasible
+		if (!warm_)
+		{
+			for (size_t j = 0; j < columns_; ++j)
+			{
+				states_[j] = State::free;
+				positions_[j] = Factor::none;
+			}
+
+			for (size_t i = 0; i < rows_; ++i)
+			{
+				heads_[i] = columns_ + i;
+				positions_[columns_ + i] = i;
+				states_[columns_ + i] = State::basic;
+			}
+
+			weights_.assign(total_, 1.0);
+			dweights_.assign(rows_, 1.0);
+			refactor();
+		}
+
+	//	a warm start keeps the basis, its factors and the weights of the pricing, only the bounds may have moved under the nonbasic variables,
+	//	so the basis stays dual feasible after changes of the bounds and primal feasible after changes of the costs
+		settle();
+		basics();
+		prices(costs_.data());
+
+		bool feasible = true;
+
+		for (size_t j = 0; j < total_ && feasible; ++j)
+		{
+			if (states_[j] == State::basic || lower_[j] == upper_[j]) { continue; }
+
+			double reduced = reduced_[j];
+			feasible = states_[j] == State::lower ? reduced >= -options_.optimality : states_[j] == State::upper ? reduced <= options_.optimality : std::abs(reduced) <= options_.optimality;
+		}
+
+		status_ = feasible ? dual() : primal();
+		warm_ = true;
+
+	//	the solution and the duals are solved again from fresh factors, which the next solve starts from
+		refactor();
+		basics();
+		prices(costs_.data());
+
+		return status_;
+	}
+
+	void Simplex::reset()
+	{
+		warm_ = false;
+		status_ = Status::unsolved;
+	}
+
+	Simplex::Status Simplex::status() const
+	{
+		return status_;
+	}
+
+	double Simplex::objective() const
+	{
+		double objective = 0;
+		for (size_t j = 0; j < columns_; ++j) { objective += costs_[j] * values_[j]; }
+		return objective;
+	}
+
+	size_t Simplex::iterations() const
+	{
+		return iterations_;
+	}
+
+	const double* Simplex::solution() const
+	{
+		return values_.data();
+	}
+
+	const double* Simplex::duals() const
+	{
+		return reduced_.data() + columns_;
+	}
+
+	const double* Simplex::reduced() const
+	{
+		return reduced_.data();
+	}
+
+	Simplex::Simplex(size_t rows, size_t columns, const size_t* offsets, const size_t* indices, const double* values)
+		: rows_(rows), columns_(columns), total_(rows + columns), status_(Status::unsolved), iterations_(0), offset_(0), second_(true), warm_(false)
+	{
+		if (offsets[0] != 0) { throw std::invalid_argument("the offsets of the rows must start at zero"); }
+
+		for (size_t i = 0; i < rows; ++i)
+		{
+			if (offsets[i + 1] < offsets[i]) { throw std::invalid_argument("the offsets of the rows must not decrease"); }
+		}
+
+		size_t count = offsets[rows];
+
+		for (size_t e = 0; e < count; ++e)
+		{
+			if (indices[e] >= columns) { throw std::invalid_argument("a column index exceeds the columns"); }
+		}
+
+		roffsets_.assign(offsets, offsets + rows + 1);
+		rindices_.assign(indices, indices + count);
+		rvalues_.assign(values, values + count);
+
+	//	the transpose by counting the entries of every column
+		coffsets_.assign(columns + 1, 0);
+		cindices_.resize(count);
+		cvalues_.resize(count);
+
+		for (size_t e = 0; e < count; ++e) { coffsets_[indices[e] + 1]++; }
+		for (size_t j = 0; j < columns; ++j) { coffsets_[j + 1] += coffsets_[j]; }
+
+		std::vector<size_t> next(coffsets_.begin(), coffsets_.end() - 1);
+
+		for (size_t i = 0; i < rows; ++i)
+		{
+			for (size_t e = offsets[i]; e < offsets[i + 1]; ++e)
+			{
+				size_t slot = next[indices[e]]++;
+				cindices_[slot] = i;
+				cvalues_[slot] = values[e];
+			}
+		}
+
+	//	the columns are nonnegative and the rows free unless told otherwise
+		costs_.assign(total_, 0.0);
+		lower_.assign(total_, 0.0);
+		upper_.assign(total_, infinity);
+		std::fill(lower_.begin() + columns, lower_.end(), -infinity);
+
+		values_.assign(total_, 0.0);
+		reduced_.assign(total_, 0.0);
+		states_.assign(total_, State::basic);
+		heads_.assign(rows, 0);
+		positions_.assign(total_, Factor::none);
+
+		column_.assign(rows, 0.0);
+		row_.assign(total_, 0.0);
+		duals_.assign(rows, 0.0);
+		costing_.assign(total_, 0.0);
+		marks_.assign(total_, 0);
+		infeasibilities_.assign(rows, 0.0);
+	}
+}
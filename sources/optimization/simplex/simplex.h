@@ -0,0 +1,128 @@
+#include <limits>
+#include <vector>
+#include <cstddef>
+#include <stdexcept>
+
+#include "factor.h"
+
+#ifndef _MATH_OPTIMIZATION_SIMPLEX_
+#define _MATH_OPTIMIZATION_SIMPLEX_
+namespace math
+{
+//	the revised simplex method for min c'x subject to lower <= A x <= upper on the rows and bounds on the columns,
+//	the rows come as a sparse matrix by rows and get a logical column each, A x - s = 0, so the basis starts as the logicals,
+//	the basis is kept as sparse LU factors updated in product form, the reduced costs are updated from the pivot row,
+//	a dual feasible start is solved by the bounded dual simplex, any other by the bounded primal simplex, whose first phase
+//	minimizes the sum of the infeasibilities, the ratio tests are the two passes of Harris,
+//	a solve starts from the basis and the factors the last one ended with, so a change of the bounds or of the ranges is solved
+//	again by the dual simplex and a change of the costs by the primal simplex, in a few pivots if the change is small
+	class Simplex
+	{
+	public:
+		enum class Status { unsolved, optimal, infeasible, unbounded, limit };
+
+	//	the pricing of the primal simplex, the largest reduced cost over all the columns or over a few of them at a time,
+	//	or the largest relative to the devex weights, which approximate the steepest edges
+		enum class Pricing { dantzig, partial, devex };
+
+		struct Options
+		{
+			Pricing pricing = Pricing::devex;
+			size_t maximum = 1000000, refactor = 100;
+			double feasibility = 1e-7, optimality = 1e-7, pivot = 1e-9;
+		};
+
+		static constexpr double infinity = std::numeric_limits<double>::infinity();
+
+	private:
+		enum class State : unsigned char { basic, lower, upper, free };
+
+		size_t rows_, columns_, total_;
+		Options options_;
+
+	//	the matrix by rows as given and by columns
+		std::vector<size_t> roffsets_, rindices_, coffsets_, cindices_;
+		std::vector<double> rvalues_, cvalues_;
+
+	//	the costs and the bounds of the columns followed by the logicals
+		std::vector<double> costs_, lower_, upper_;
+
+	//	the values, the reduced costs and the states of all the variables, the variables of the basis by position
+	//	and the position of every variable in the basis, none if it is out
+		std::vector<double> values_, reduced_;
+		std::vector<State> states_;
+		std::vector<size_t> heads_, positions_;
+
+		Factor factor_;
+
+	//	the weights of the pricing, by variables for the primal and by positions for the dual
+		std::vector<double> weights_, dweights_, infeasibilities_;
+
+	//	the scratch of the iterations, by rows or positions, and the pivot row by variables
+		std::vector<double> column_, row_, duals_, costing_;
+		std::vector<size_t> touched_;
+		std::vector<unsigned char> marks_;
+
+		Status status_;
+		size_t iterations_, offset_;
+	//	whether costing_ holds the costs of the second phase, and whether the basis comes from a previous solve
+		bool second_, warm_;
+
+	private:
+		void column(size_t variable, double* values) const;
+
+	//	factorizes the basis, the singular columns are swapped for logicals, then the values of the basic variables
+	//	and the reduced costs of the others under the costs are solved again from scratch
+		void refactor();
+		void basics();
+		void prices(const double* costs);
+
+	//	the pivot row of the position against the variables, into row_, its nonzeros in touched_
+		void pivot(size_t position);
+	//	the entering variable takes the position, whose solution against the basis is in column_
+		void exchange(size_t position, size_t entering);
+
+	//	the distance of the variable below its lower bound, negative, or above its upper bound, zero within the tolerance
+		double infeasibility(size_t variable) const;
+		bool feasible() const;
+
+	//	the costs of the primal phase into costing_, the first phase prices the basic variables below their bounds at -1,
+	//	above them at 1 and all the others at 0, the reduced costs follow the changes through the duals, true in the second phase,
+	//	the variable which just left the basis is the only nonbasic one whose cost may change within a phase
+		bool phase(size_t leaving = Factor::none);
+
+	//	the entering variable of the primal simplex, none if every reduced cost is optimal
+		size_t price();
+
+		Status primal();
+		Status dual();
+
+	//	the nonbasic variables onto their bounds, those whose bound is gone move to the one their cost points to
+		void settle();
+
+	public:
+		void costs(const double* costs);
+		void bounds(const double* lower, const double* upper);
+		void ranges(const double* lower, const double* upper);
+		void configure(const Options& options);
+
+		Status solve();
+	//	the next solve starts again from the logicals
+		void reset();
+
+	public:
+		Status status() const;
+		double objective() const;
+		size_t iterations() const;
+
+	//	the values of the columns, the duals of the rows and the reduced costs of the columns
+		const double* solution() const;
+		const double* duals() const;
+		const double* reduced() const;
+
+	public:
+	//	the rows by compressed sparse rows, offsets holds rows + 1 entries, the columns within a row in any order
+		Simplex(size_t rows, size_t columns, const size_t* offsets, const size_t* indices, const double* values);
+	};
+}
+#endif //!_MATH_OPTIMIZATION_SIMPLEX_
@@ -1,2 +1,84 @@
+#include <cmath>
+#include <limits>
+#include <vector>
+#include <random>
+#include <numeric>
+#include <algorithm>
+
+#ifndef _STATISTICS_SAMPLER_LATIN_HYPERCUBE_
+#define _STATISTICS_SAMPLER_LATIN_HYPERCUBE_
+//  latin hypercube design in the unit cube, every one of the count strata of a dimension holds exactly one point,
+//  the maximin design draws a few candidates and keeps the one whose closest two points are the farthest apart
 class LHD
-{};
\ No newline at end of file
+{
+private:
+//  the pairs compared at most to rank the candidates, beyond it the first candidate is kept as is
+    static constexpr size_t budget_ = size_t(1) << 26;
+
+    size_t dimension_, candidates_;
+
+private:
+    static double separation(size_t count, size_t dimension, const double* samples)
+    {
+        double minimum = std::numeric_limits<double>::infinity();
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            for (size_t j = i + 1; j < count; ++j)
+            {
+                double distance = 0;
+                for (size_t k = 0; k < dimension; ++k) { distance += std::pow(samples[i * dimension + k] - samples[j * dimension + k], 2); }
+
+                minimum = std::min(minimum, distance);
+            }
+        }
+
+        return minimum;
+    }
+
+    template<typename Generator>
+    void draw(size_t count, double* samples, Generator& generator) const
+    {
+        std::vector<size_t> strata(count);
+        std::uniform_real_distribution<double> uniform(0, 1);
+
+        for (size_t k = 0; k < dimension_; ++k)
+        {
+            std::iota(strata.begin(), strata.end(), 0);
+            std::shuffle(strata.begin(), strata.end(), generator);
+
+            for (size_t i = 0; i < count; ++i) { samples[i * dimension_ + k] = (strata[i] + uniform(generator)) / count; }
+        }
+    }
+
+public:
+//  count points of the dimensions, one per row
+    template<typename Generator>
+    void sample(size_t count, double* samples, Generator& generator) const
+    {
+        draw(count, samples, generator);
+
+        size_t pairs = count * (count - std::min<size_t>(count, 1)) / 2 * dimension_;
+        if (candidates_ < 2 || count < 2 || pairs * candidates_ > budget_) { return; }
+
+        std::vector<double> candidate(count * dimension_);
+        double best = separation(count, dimension_, samples);
+
+        for (size_t c = 1; c < candidates_; ++c)
+        {
+            draw(count, candidate.data(), generator);
+
+            double distance = separation(count, dimension_, candidate.data());
+            if (distance <= best) { continue; }
+
+            best = distance;
+            std::copy(candidate.begin(), candidate.end(), samples);
+        }
+    }
+
+public:
+    LHD(size_t dimension, size_t candidates = 1) : dimension_(dimension), candidates_(candidates)
+    {
+    }
+};
+#endif //! _STATISTICS_SAMPLER_LATIN_HYPERCUBE_
@@ -0,0 +1,86 @@
+#include <array>
+#include <vector>
+#include <cstdint>
+#include <string>
+#include <iterator>
+#include <stdexcept>
+
+#ifndef _STATISTICS_SAMPLER_SOBOL_
+#define _STATISTICS_SAMPLER_SOBOL_
+//  sobol low discrepancy sequence in the unit cube, by the direction numbers of joe and kuo, the points are made in gray code order,
+//  a random digital shift per dimension keeps the strata of the sequence while the runs differ
+class Sobol
+{
+private:
+    static constexpr size_t bits_ = 32;
+
+//  degree, coefficients and initial direction numbers of the primitive polynomials from the second dimension on
+    struct Polynomial
+    {
+        unsigned degree, coefficients;
+        std::array<unsigned, 7> directions;
+    };
+
+    static constexpr Polynomial polynomials_[] =
+    {
+        { 1, 0, { 1 } }, { 2, 1, { 1, 3 } }, { 3, 1, { 1, 3, 1 } }, { 3, 2, { 1, 1, 1 } },
+        { 4, 1, { 1, 1, 3, 3 } }, { 4, 4, { 1, 3, 5, 13 } }, { 5, 2, { 1, 1, 5, 5, 17 } }, { 5, 4, { 1, 1, 5, 5, 5 } },
+        { 5, 7, { 1, 1, 7, 11, 19 } }, { 5, 11, { 1, 1, 5, 1, 1 } }, { 5, 13, { 1, 1, 1, 3, 11 } }, { 5, 14, { 1, 3, 5, 5, 31 } },
+        { 6, 1, { 1, 3, 3, 9, 7, 49 } }, { 6, 13, { 1, 1, 1, 15, 21, 21 } }, { 6, 16, { 1, 3, 1, 13, 27, 49 } },
+        { 6, 19, { 1, 1, 1, 15, 7, 5 } }, { 6, 22, { 1, 3, 1, 15, 13, 25 } }, { 6, 25, { 1, 1, 5, 5, 19, 61 } },
+        { 7, 1, { 1, 3, 7, 11, 23, 15, 103 } }, { 7, 4, { 1, 3, 7, 13, 13, 15, 69 } },
+    };
+
+    size_t dimension_;
+    std::vector<uint32_t> directions_;
+
+public:
+//  the dimensions the direction numbers cover
+    static constexpr size_t maximum = std::size(polynomials_) + 1;
+
+//  count points of the dimensions, one per row, the first point of the sequence, the origin, is skipped
+    template<typename Generator>
+    void sample(size_t count, double* samples, Generator& generator) const
+    {
+        std::vector<uint32_t> point(dimension_), shifts(dimension_);
+        for (auto& shift : shifts) { shift = uint32_t(generator()); }
+
+        for (size_t n = 0; n < count; ++n)
+        {
+        //  the position of the lowest zero bit of the index picks the direction to flip
+            size_t c = 0;
+            for (size_t value = n; value & 1; value >>= 1) { c++; }
+
+            for (size_t k = 0; k < dimension_; ++k)
+            {
+                point[k] ^= directions_[k * bits_ + c];
+                samples[n * dimension_ + k] = double(point[k] ^ shifts[k]) / 4294967296.0;
+            }
+        }
+    }
+
+public:
+    Sobol(size_t dimension) : dimension_(dimension), directions_(dimension * bits_)
+    {
+        if (dimension > maximum) { throw std::invalid_argument("the sobol sequence covers at most " + std::to_string(maximum) + " dimensions"); }
+
+    //  the first dimension is the van der corput sequence
+        for (size_t i = 0; i < bits_ && dimension; ++i) { directions_[i] = uint32_t(1) << (bits_ - 1 - i); }
+
+        for (size_t k = 1; k < dimension; ++k)
+        {
+            const auto& polynomial = polynomials_[k - 1];
+            uint32_t* v = &directions_[k * bits_];
+            size_t s = polynomial.degree;
+
+            for (size_t i = 0; i < std::min(s, bits_); ++i) { v[i] = polynomial.directions[i] << (bits_ - 1 - i); }
+
+            for (size_t i = s; i < bits_; ++i)
+            {
+                v[i] = v[i - s] ^ (v[i - s] >> s);
+                for (size_t j = 1; j < s; ++j) { v[i] ^= ((polynomial.coefficients >> (s - 1 - j)) & 1) * v[i - j]; }
+            }
+        }
+    }
+};
+#endif //! _STATISTICS_SAMPLER_SOBOL_